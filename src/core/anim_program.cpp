@@ -0,0 +1,382 @@
+#include "anim_program.h"
+#include "pixel_ops.h"
+
+// Labels-as-values dispatch: every handler jumps straight to the next one
+// instead of returning to a central switch
+#if defined(__GNUC__)
+#define ANIM_THREADED 1
+#else
+#define ANIM_THREADED 0
+#endif
+
+static inline int32_t clampLevel(int32_t value, int32_t high) {
+    return (value < 0) ? 0 : ((value > high) ? high : value);
+}
+
+static int32_t easeQ16(int32_t x, uint8_t kind) {
+    int64_t one = 65536;
+    int64_t v = clampLevel(x, 65536);
+    
+    if (kind == EASE_OUT_QUART) {
+        // 1 - (1-x)^4
+        int64_t inv = one - v;
+        int64_t inv2 = (inv * inv) >> 16;
+        return (int32_t)(one - ((inv2 * inv2) >> 16));
+    }
+    
+    // In-out cubic: 4x^3, then 1 - (2 - 2x)^3 / 2
+    if (v < 32768) {
+        return (int32_t)((4 * ((((v * v) >> 16) * v) >> 16)));
+    }
+    int64_t t = 2 * (one - v);
+    return (int32_t)(one - ((((t * t) >> 16) * t) >> 17));
+}
+
+bool validateAnimationProgram(const uint8_t* program, uint16_t length) {
+    if (program == nullptr || length == 0 || (length % 4) != 0 || length > ANIM_PROGRAM_MAX_LENGTH * 4 ||
+        program[length - 4] != OP_END) {
+        return false;
+    }
+    
+    int count = length / 4;
+    for (int i = 0; i < count; i++) {
+        const uint8_t* instruction = program + i * 4;
+        if (instruction[0] >= OP_COUNT) {
+            return false;
+        }
+        if (instruction[0] == OP_JLT || instruction[0] == OP_JMP) {
+            int target = i + 1 + (int8_t)instruction[3];
+            if (target < 0 || target >= count) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void runAnimationProgram(const uint8_t* program, uint16_t length, CRGB* leds, int numLeds,
+                         const AnimationParams& params) {
+    int count = length / 4;
+    if (program == nullptr || count == 0 || numLeds <= 0) {
+        return;
+    }
+    
+    int32_t r[8] = { (int32_t)(params.progress * 65536.0f), numLeds, 0, 0, 0, 0, 0, 0 };
+    CRGB c[8] = { params.primaryColor, params.secondaryColor, CRGB::Black, CRGB::White,
+                  CRGB::Black, CRGB::Black, CRGB::Black, CRGB::Black };
+    const uint8_t* pc = program;
+    const uint8_t* programEnd = program + count * 4;
+    int steps = ANIM_PROGRAM_MAX_STEPS;
+    
+    #define RA r[pc[1] & 7]
+    #define RB r[pc[2] & 7]
+    #define RC r[pc[3] & 7]
+    #define CA c[pc[1] & 7]
+    #define CB c[pc[2] & 7]
+    #define IMM16 ((int32_t)(pc[2] | (pc[3] << 8)))
+    #define OPCODE (pc[0] < OP_COUNT ? pc[0] : (uint8_t)OP_END)
+
+#if ANIM_THREADED
+    static const void* const handlers[] = {
+        &&L_END, &&L_LDI, &&L_LDIH, &&L_MOV, &&L_ADD, &&L_SUB, &&L_MUL, &&L_MULQ,
+        &&L_INT, &&L_FRAC, &&L_MIN, &&L_MAX, &&L_PHASE, &&L_PINGPONG, &&L_EASE, &&L_WAVE,
+        &&L_LEVEL, &&L_GAMMA, &&L_SCALE, &&L_NSCALE, &&L_BLEND, &&L_FILL, &&L_GRADIENT, &&L_PIXEL,
+        &&L_ADDPIXEL, &&L_DIM, &&L_FADE, &&L_JLT, &&L_JMP
+    };
+    static_assert(sizeof(handlers) / sizeof(handlers[0]) == OP_COUNT, "handler table out of sync with AnimOp");
+    #define OP(name) L_##name:
+    #define DISPATCH() do { if (--steps < 0) return; goto *handlers[OPCODE]; } while (0)
+#else
+    #define OP(name) case OP_##name:
+    #define DISPATCH() do { if (--steps < 0) return; goto dispatch; } while (0)
+#endif
+    // Falling off the end or jumping out of the program stops it
+    #define NEXT() do { pc += 4; if (pc >= programEnd) return; DISPATCH(); } while (0)
+    #define JUMP() do { \
+        int target = (int)((pc - program) / 4) + 1 + (int8_t)pc[3]; \
+        if (target < 0 || target >= count) return; \
+        pc = program + target * 4; \
+        DISPATCH(); \
+    } while (0)
+
+    DISPATCH();
+#if !ANIM_THREADED
+dispatch:
+    switch (OPCODE) {
+#endif
+
+    OP(END)
+        return;
+    OP(LDI)
+        RA = IMM16; NEXT();
+    OP(LDIH)
+        RA = IMM16 << 16; NEXT();
+    OP(MOV)
+        RA = RB; NEXT();
+    OP(ADD)
+        RA = RB + RC; NEXT();
+    OP(SUB)
+        RA = RB - RC; NEXT();
+    OP(MUL)
+        RA = RB * RC; NEXT();
+    OP(MULQ)
+        RA = (int32_t)(((int64_t)RB * RC) >> 16); NEXT();
+    OP(INT)
+        RA = RB >> 16; NEXT();
+    OP(FRAC)
+        RA = RB & 0xFFFF; NEXT();
+    OP(MIN)
+        RA = (RB < RC) ? RB : RC; NEXT();
+    OP(MAX)
+        RA = (RB > RC) ? RB : RC; NEXT();
+    OP(PHASE) {
+        uint32_t periodUs = (uint32_t)IMM16 * 1000UL;
+        RA = (periodUs == 0) ? 0 : (int32_t)(((params.timestamp % periodUs) << 16) / periodUs);
+        NEXT();
+    }
+    OP(PINGPONG) {
+        int32_t x = RB & 0xFFFF;
+        RA = (x < 32768) ? (x * 2) : ((65536 - x) * 2);
+        NEXT();
+    }
+    OP(EASE)
+        RA = easeQ16(RB, pc[3]); NEXT();
+    OP(WAVE)
+        RA = (int32_t)sin16((uint16_t)RB) + 32768; NEXT();
+    OP(LEVEL)
+        RA = clampLevel((int32_t)(((int64_t)RB * 255) >> 16), 255); NEXT();
+    OP(GAMMA)
+        RA = AnimationManager::applyGamma((uint8_t)clampLevel(RB, 255)); NEXT();
+    OP(SCALE)
+        CA = CB; CA.nscale8_video((uint8_t)clampLevel(RC, 255)); NEXT();
+    OP(NSCALE)
+        CA = CB; CA.nscale8((uint8_t)clampLevel(RC, 255)); NEXT();
+    OP(BLEND)
+        lerpPixels(&CA, &CA, &CB, 1, (uint16_t)clampLevel(RC, 256)); NEXT();
+    OP(FILL) {
+        int32_t start = clampLevel(RB, numLeds);
+        int32_t end = clampLevel(RB + RC, numLeds);
+        if (end > start) {
+            fillPixels(leds + start, end - start, CA);
+        }
+        NEXT();
+    }
+    OP(GRADIENT)
+        for (int i = 0; i < numLeds; i++) {
+            uint16_t weight = (numLeds > 1) ? (uint16_t)((i * 256) / (numLeds - 1)) : 0;
+            lerpPixels(&leds[i], &CA, &CB, 1, weight);
+        }
+        NEXT();
+    OP(PIXEL)
+        if (RB >= 0 && RB < numLeds) {
+            leds[RB] = CA;
+        }
+        NEXT();
+    OP(ADDPIXEL)
+        leds[((RB % numLeds) + numLeds) % numLeds] += CA; NEXT();
+    OP(DIM)
+        scalePixelsVideo(leds, numLeds, (uint8_t)clampLevel(RA, 255)); NEXT();
+    OP(FADE)
+        scalePixels(leds, numLeds, (uint8_t)clampLevel(RA, 255)); NEXT();
+    OP(JLT)
+        if (RA < RB) {
+            JUMP();
+        }
+        NEXT();
+    OP(JMP)
+        JUMP();
+
+#if !ANIM_THREADED
+    }
+#endif
+
+    #undef OP
+    #undef DISPATCH
+    #undef NEXT
+    #undef JUMP
+    #undef RA
+    #undef RB
+    #undef RC
+    #undef CA
+    #undef CB
+    #undef IMM16
+    #undef OPCODE
+}
+
+// ==========================================
+// Built-in Animations as Bytecode
+// ==========================================
+// r5 is never written by these programs and stays 0
+
+#define C_PRIMARY 0
+#define C_BLACK 2
+#define C_WHITE 3
+
+// Countdown ring: full LEDs plus a gamma-corrected partial LED
+#define RING_FILL \
+    ANIM_OP(OP_MUL, 2, 0, 1),               /* r2 = progress * numLeds */ \
+    ANIM_OP(OP_INT, 3, 2, 0),               /* r3 = full LEDs */ \
+    ANIM_OP(OP_FRAC, 4, 2, 0),              /* r4 = partial */ \
+    ANIM_OP(OP_FILL, C_BLACK, 5, 1), \
+    ANIM_OP(OP_FILL, C_PRIMARY, 5, 3), \
+    ANIM_OP(OP_LEVEL, 4, 4, 0), \
+    ANIM_OP(OP_GAMMA, 4, 4, 0), \
+    ANIM_OP(OP_SCALE, 4, C_PRIMARY, 4), \
+    ANIM_OP(OP_PIXEL, 4, 3, 0)
+
+// Solid colour breathing between floor and floor + span (Q16)
+#define BREATHE_FILL(periodMs, floor, span) \
+    ANIM_IMM(OP_PHASE, 2, periodMs), \
+    ANIM_OP(OP_PINGPONG, 2, 2, 0), \
+    ANIM_OP(OP_EASE, 2, 2, EASE_IN_OUT_CUBIC), \
+    ANIM_IMM(OP_LDI, 3, span), \
+    ANIM_OP(OP_MULQ, 2, 2, 3), \
+    ANIM_IMM(OP_LDI, 3, floor), \
+    ANIM_OP(OP_ADD, 2, 2, 3), \
+    ANIM_OP(OP_LEVEL, 2, 2, 0), \
+    ANIM_OP(OP_GAMMA, 2, 2, 0), \
+    ANIM_OP(OP_SCALE, 4, C_PRIMARY, 2), \
+    ANIM_OP(OP_FILL, 4, 5, 1)
+
+static const uint8_t PROGRAM_COUNTDOWN[] = {
+    RING_FILL,
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_PAUSED[] = {
+    RING_FILL,
+    // Breathe the whole ring between 25% and 60% on a 4 s period
+    ANIM_IMM(OP_PHASE, 6, 4000),
+    ANIM_OP(OP_PINGPONG, 6, 6, 0),
+    ANIM_OP(OP_EASE, 6, 6, EASE_IN_OUT_CUBIC),
+    ANIM_IMM(OP_LDI, 7, 22938),
+    ANIM_OP(OP_MULQ, 6, 6, 7),
+    ANIM_IMM(OP_LDI, 7, 16384),
+    ANIM_OP(OP_ADD, 6, 6, 7),
+    ANIM_OP(OP_LEVEL, 6, 6, 0),
+    ANIM_OP(OP_GAMMA, 6, 6, 0),
+    ANIM_OP(OP_DIM, 6, 0, 0),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_PULSE[] = {
+    BREATHE_FILL(3000, 13107, 52429),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_FLASH_COMPLETE[] = {
+    BREATHE_FILL(1000, 0, 65535),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_FLASH_CANCELLED[] = {
+    BREATHE_FILL(800, 0, 65535),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_SOLID_COLOR[] = {
+    ANIM_OP(OP_FILL, C_PRIMARY, 5, 1),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_OFF[] = {
+    ANIM_OP(OP_FILL, C_BLACK, 5, 1),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_COMET[] = {
+    ANIM_IMM(OP_LDI, 2, 235),
+    ANIM_OP(OP_FADE, 2, 0, 0),              // Trail
+    ANIM_IMM(OP_PHASE, 2, 1000),            // One rotation per second
+    ANIM_OP(OP_MUL, 2, 2, 1),
+    ANIM_OP(OP_INT, 3, 2, 0),               // r3 = head
+    ANIM_OP(OP_FRAC, 4, 2, 0),
+    ANIM_OP(OP_LEVEL, 4, 4, 0),             // r4 = share of the next pixel
+    ANIM_IMM(OP_LDI, 6, 255),
+    ANIM_OP(OP_SUB, 6, 6, 4),
+    ANIM_OP(OP_NSCALE, 4, C_PRIMARY, 6),
+    ANIM_OP(OP_NSCALE, 5, C_PRIMARY, 4),
+    ANIM_OP(OP_ADDPIXEL, 4, 3, 0),
+    ANIM_IMM(OP_LDI, 7, 1),
+    ANIM_OP(OP_ADD, 3, 3, 7),
+    ANIM_OP(OP_ADDPIXEL, 5, 3, 0),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_GAUGE_SWEEP[] = {
+    // Eased sweep from the first LED up to the full ring
+    ANIM_OP(OP_EASE, 2, 0, EASE_OUT_QUART),
+    ANIM_IMM(OP_LDI, 7, 1),
+    ANIM_OP(OP_SUB, 6, 1, 7),
+    ANIM_OP(OP_MUL, 2, 2, 6),
+    ANIM_IMM(OP_LDIH, 7, 1),
+    ANIM_OP(OP_ADD, 2, 2, 7),
+    ANIM_OP(OP_INT, 3, 2, 0),
+    ANIM_OP(OP_FRAC, 4, 2, 0),
+    ANIM_OP(OP_FILL, C_BLACK, 5, 1),
+    ANIM_OP(OP_FILL, C_PRIMARY, 5, 3),
+    ANIM_OP(OP_LEVEL, 4, 4, 0),
+    ANIM_OP(OP_GAMMA, 4, 4, 0),
+    ANIM_OP(OP_SCALE, 4, C_PRIMARY, 4),
+    ANIM_OP(OP_PIXEL, 4, 3, 0),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+static const uint8_t PROGRAM_TIME_SELECTION[] = {
+    ANIM_OP(OP_MUL, 2, 0, 1),
+    ANIM_OP(OP_INT, 3, 2, 0),
+    ANIM_OP(OP_FRAC, 4, 2, 0),
+    ANIM_OP(OP_FILL, C_BLACK, 5, 1),
+    ANIM_OP(OP_FILL, C_WHITE, 5, 3),
+    ANIM_IMM(OP_PHASE, 6, 1571),            // ~1.57 s breathing cycle
+    ANIM_OP(OP_WAVE, 6, 6, 0),              // r6 = breathe
+    ANIM_IMM(OP_LDI, 7, 655),
+    ANIM_OP(OP_JLT, 4, 7, 11),              // No partial: pulse the last full LED
+    // Partial cursor LED: partial x (0.5 + 0.5 breathe), at least level 10
+    ANIM_IMM(OP_LDI, 7, 32768),
+    ANIM_OP(OP_MULQ, 2, 6, 7),
+    ANIM_OP(OP_ADD, 2, 2, 7),
+    ANIM_OP(OP_MULQ, 2, 2, 4),
+    ANIM_OP(OP_LEVEL, 2, 2, 0),
+    ANIM_IMM(OP_LDI, 7, 10),
+    ANIM_OP(OP_MAX, 2, 2, 7),
+    ANIM_OP(OP_GAMMA, 2, 2, 0),
+    ANIM_OP(OP_SCALE, 4, C_WHITE, 2),
+    ANIM_OP(OP_PIXEL, 4, 3, 0),
+    ANIM_OP(OP_END, 0, 0, 0),
+    // Last full LED dips to 200 + 55 x breathe
+    ANIM_IMM(OP_LDI, 7, 1),
+    ANIM_OP(OP_JLT, 3, 7, 9),
+    ANIM_IMM(OP_LDI, 7, 55),
+    ANIM_OP(OP_MUL, 2, 6, 7),
+    ANIM_OP(OP_INT, 2, 2, 0),
+    ANIM_IMM(OP_LDI, 7, 200),
+    ANIM_OP(OP_ADD, 2, 2, 7),
+    ANIM_OP(OP_NSCALE, 4, C_WHITE, 2),
+    ANIM_IMM(OP_LDI, 7, 1),
+    ANIM_OP(OP_SUB, 3, 3, 7),
+    ANIM_OP(OP_PIXEL, 4, 3, 0),
+    ANIM_OP(OP_END, 0, 0, 0)
+};
+
+#define BUILTIN(program) do { *length = sizeof(program); return program; } while (0)
+
+const uint8_t* getBuiltinProgram(AnimationType type, uint16_t* length) {
+    switch (type) {
+        case AnimationType::COUNTDOWN:       BUILTIN(PROGRAM_COUNTDOWN);
+        case AnimationType::PULSE:           BUILTIN(PROGRAM_PULSE);
+        case AnimationType::COMET:           BUILTIN(PROGRAM_COMET);
+        case AnimationType::SOLID_COLOR:     BUILTIN(PROGRAM_SOLID_COLOR);
+        case AnimationType::TIME_SELECTION:  BUILTIN(PROGRAM_TIME_SELECTION);
+        case AnimationType::GAUGE_SWEEP:     BUILTIN(PROGRAM_GAUGE_SWEEP);
+        case AnimationType::FLASH_COMPLETE:  BUILTIN(PROGRAM_FLASH_COMPLETE);
+        case AnimationType::FLASH_CANCELLED: BUILTIN(PROGRAM_FLASH_CANCELLED);
+        case AnimationType::PAUSED:          BUILTIN(PROGRAM_PAUSED);
+        case AnimationType::OFF:             BUILTIN(PROGRAM_OFF);
+        default:
+            *length = 0;
+            return nullptr;
+    }
+}
+
+#undef BUILTIN
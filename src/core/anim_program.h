@@ -0,0 +1,75 @@
+#ifndef ANIM_PROGRAM_H
+#define ANIM_PROGRAM_H
+
+#include <FastLED.h>
+#include <stdint.h>
+#include "types.h"
+#include "animations.h"
+
+// Animation bytecode.
+//
+// A program is a flat array of 4-byte instructions [op, a, b, c], ending
+// with OP_END. It works on eight int32 registers and eight colours:
+//   r0 = progress (Q16, 1.0 = 65536)   r1 = numLeds   r2..r7 = 0
+//   c0 = primary   c1 = secondary   c2 = black   c3 = white   c4..c7 scratch
+// Fractions are Q16; "level" operands are 0..255. imm16 is b | (c << 8).
+// Register and colour fields are masked to 0..7 and pixel writes are
+// bounds-checked, so a corrupt blob can produce a wrong frame but never
+// write outside the strip. The interpreter also stops at the end of the
+// program, on a jump out of it and after ANIM_PROGRAM_MAX_STEPS
+// instructions, so it never reads past the blob or stalls the frame.
+enum AnimOp : uint8_t {
+    OP_END,
+    OP_LDI,         // ra = imm16
+    OP_LDIH,        // ra = imm16 << 16
+    OP_MOV,         // ra = rb
+    OP_ADD,         // ra = rb + rc
+    OP_SUB,         // ra = rb - rc
+    OP_MUL,         // ra = rb * rc
+    OP_MULQ,        // ra = (rb * rc) >> 16
+    OP_INT,         // ra = rb >> 16
+    OP_FRAC,        // ra = rb & 0xFFFF
+    OP_MIN,         // ra = min(rb, rc)
+    OP_MAX,         // ra = max(rb, rc)
+    OP_PHASE,       // ra = Q16 position of the timestamp in a period of imm16 ms
+    OP_PINGPONG,    // ra = 0 -> 1 -> 0 triangle of phase rb
+    OP_EASE,        // ra = ease(rb): c = EASE_IN_OUT_CUBIC | EASE_OUT_QUART
+    OP_WAVE,        // ra = (sin(2 pi rb) + 1) / 2
+    OP_LEVEL,       // ra = rb * 255 >> 16, clamped to 0..255
+    OP_GAMMA,       // ra = applyGamma(rb)
+    OP_SCALE,       // ca = cb.nscale8_video(rc)
+    OP_NSCALE,      // ca = cb.nscale8(rc)
+    OP_BLEND,       // ca = lerp(ca, cb, rc / 256)
+    OP_FILL,        // leds[rb .. rb + rc) = ca
+    OP_GRADIENT,    // leds[i] = lerp(ca, cb, i / (numLeds - 1))
+    OP_PIXEL,       // leds[rb] = ca (if in range)
+    OP_ADDPIXEL,    // leds[rb mod numLeds] += ca
+    OP_DIM,         // all leds nscale8_video(ra)
+    OP_FADE,        // all leds nscale8(ra)
+    OP_JLT,         // if (ra < rb) pc += (int8_t)c instructions
+    OP_JMP,         // pc += (int8_t)c instructions
+    OP_COUNT
+};
+
+#define EASE_IN_OUT_CUBIC 0
+#define EASE_OUT_QUART 1
+
+#define ANIM_PROGRAM_MAX_LENGTH 1024    // Instructions per program
+#define ANIM_PROGRAM_MAX_STEPS 4096     // Instructions executed per run (loops included)
+
+// Instruction encoders for writing programs as const arrays
+#define ANIM_OP(op, a, b, c) (uint8_t)(op), (uint8_t)(a), (uint8_t)(b), (uint8_t)(c)
+#define ANIM_IMM(op, a, imm) ANIM_OP(op, a, (imm) & 0xFF, ((imm) >> 8) & 0xFF)
+
+// Load-time check for programs from outside the firmware: whole
+// instructions, known opcodes, jump targets inside the program, OP_END last
+bool validateAnimationProgram(const uint8_t* program, uint16_t length);
+
+// Run a program of 'length' bytes over leds (threaded dispatch on GCC, switch elsewhere)
+void runAnimationProgram(const uint8_t* program, uint16_t length, CRGB* leds, int numLeds,
+                         const AnimationParams& params);
+
+// Bytecode equivalents of the built-in animations (nullptr for none)
+const uint8_t* getBuiltinProgram(AnimationType type, uint16_t* length);
+
+#endif // ANIM_PROGRAM_H
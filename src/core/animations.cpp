@@ -1,83 +1,472 @@
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include "animations.h"
+#include "clock.h"
+#include "pixel_ops.h"
+#include "anim_program.h"
+#include "asset_pack.h"
+#include <algorithm>
 #include <math.h>
+#include <string.h>
+
+using std::max;
+using std::min;
 
 // Helper Macros
 #define CLAMP(x, low, high)  (((x) > (high)) ? (high) : (((x) < (low)) ? (low) : (x)))
 
+static inline void countdownKernel(CRGB* leds, int numLeds, float progress, CRGB primaryColor);
+static inline int32_t countdownLevel(float progress, int numLeds);
+static inline void gaugeSweepKernel(CRGB* leds, int numLeds, float progress, CRGB primaryColor,
+                                    int selectedLeds);
+static inline void timeSelectionKernel(CRGB* leds, int numLeds, float progress, uint64_t timestamp);
+
+// Brightness-only animations whose frame is a pure function of
+// (timestamp mod period): solid colour scaled by an eased ping-pong
+struct PeriodicProfile {
+    uint32_t periodUs;
+    float floor;        // Minimum brightness factor
+    float span;         // floor + span = maximum
+};
+
+static bool getPeriodicProfile(AnimationType type, PeriodicProfile& profile) {
+    switch (type) {
+        case AnimationType::PULSE:
+            profile.periodUs = 3000000UL;
+            profile.floor = 0.2f;
+            profile.span = 0.8f;
+            return true;
+        case AnimationType::FLASH_COMPLETE:
+            profile.periodUs = 1000000UL;
+            profile.floor = 0.0f;
+            profile.span = 1.0f;
+            return true;
+        case AnimationType::FLASH_CANCELLED:
+            profile.periodUs = 800000UL;
+            profile.floor = 0.0f;
+            profile.span = 1.0f;
+            return true;
+        default:
+            return false;
+    }
+}
+
+static uint8_t periodicLevel(const PeriodicProfile& profile, float phase) {
+    // Ping-pong the cycle (0->1->0), ease, then gamma
+    float pingPong = (phase < 0.5f) ? (phase * 2.0f) : ((1.0f - phase) * 2.0f);
+    float breathe = AnimationManager::easeInOutCubic(pingPong);
+    float factor = profile.floor + (profile.span * breathe);
+    return AnimationManager::applyGamma((uint8_t)(factor * 255));
+}
+
 // AnimationManager Implementation
 AnimationManager::AnimationManager(CRGB* ledArray, int numLeds) 
-    : leds(ledArray), numLeds(numLeds), currentAnimation(AnimationType::OFF),
-      customAnimationFunc(nullptr), brightness(LED_BRIGHTNESS),
-      primaryColor(CRGB::Red), secondaryColor(CRGB::Black) {
+    : outputLeds(ledArray), numLeds(CLAMP(numLeds, 0, NUM_LEDS)), frontIndex(0), frameReady(false),
+      outputCount(0), lastShowMicros(0), capture(nullptr), latency(nullptr), renderKey(0), renderKeyChanged(false), crossfadeStart(0), crossfadeDuration(0),
+      currentAnimation(AnimationType::OFF),
+      customAnimationFunc(nullptr), customProgram(nullptr), customProgramLength(0), assets(nullptr), brightness(LED_BRIGHTNESS),
+      primaryColor(CRGB::Red), secondaryColor(CRGB::Black), layerCount(0), segmentCount(1),
+      frameCacheEnabled(ANIM_FRAME_CACHE != 0), cacheType(AnimationType::OFF), cacheStepUs(0), cacheFrames(0),
+      preparedCount(-1), preparedLevel(0), preparedColor(CRGB::Black) {
+    LedSegment& main = segments[0];
+    main.name = "main";
+    main.start = 0;
+    main.length = (uint16_t)this->numLeds;
+    main.offset = 0;
+    main.reversed = false;
+    main.type = AnimationType::OFF;
+    main.params = AnimationParams();
+    main.staleBuffers = 0;
 }
 
-void AnimationManager::setAnimation(AnimationType type) {
+void AnimationManager::setAnimation(AnimationType type, uint16_t crossfadeMs) {
     if (currentAnimation != type) {
-        clear(); // Clear LEDs to prevent artifacts from previous animation
+        if (crossfadeMs > 0) {
+            startCrossfade(crossfadeMs);
+        } else {
+            clear(); // Clear LEDs to prevent artifacts from previous animation
+        }
         currentAnimation = type;
         customAnimationFunc = nullptr;
+        customProgram = nullptr;
+    }
+}
+
+void AnimationManager::setOutput(LedOutput* ledOutput) {
+    // One output driving the whole strip
+    outputCount = 0;
+    if (ledOutput != nullptr) {
+        addOutput(ledOutput, 0, (uint16_t)numLeds);
+    }
+}
+
+bool AnimationManager::addOutput(LedOutput* ledOutput, uint16_t first, uint16_t count) {
+    if (ledOutput == nullptr || outputCount >= MAX_LED_OUTPUTS || first + count > numLeds) {
+        return false;
     }
+    
+    outputs[outputCount].output = ledOutput;
+    outputs[outputCount].first = first;
+    outputs[outputCount].count = count;
+    outputCount++;
+    return true;
 }
 
-void AnimationManager::setCustomAnimation(AnimationFunction customFunc) {
+void AnimationManager::setCustomAnimation(const AnimationFunction& customFunc) {
     customAnimationFunc = customFunc;
+    customProgram = nullptr;
     currentAnimation = AnimationType::OFF; // Use custom function instead
 }
 
+bool AnimationManager::setProgram(const uint8_t* program, uint16_t length) {
+    // Checked once here; the interpreter then only guards the frame budget
+    if (!validateAnimationProgram(program, length)) {
+        return false;
+    }
+    
+    customProgram = program;
+    customProgramLength = length;
+    customAnimationFunc = nullptr;
+    currentAnimation = AnimationType::OFF; // Use the program instead
+    return true;
+}
+
+void AnimationManager::setAssets(const AssetPack* pack) {
+    assets = pack;
+}
+
+// FNV-1a step over one 32-bit word of render inputs
+static uint32_t mixKey(uint32_t key, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        key = (key ^ ((value >> (i * 8)) & 0xFF)) * 16777619UL;
+    }
+    return key;
+}
+
+static uint32_t colorKey(const CRGB& color) {
+    return ((uint32_t)color.r << 16) | ((uint32_t)color.g << 8) | color.b;
+}
+
+static uint32_t progressKey(float progress) {
+    uint32_t bits;
+    memcpy(&bits, &progress, sizeof(bits));
+    return bits;
+}
+
 void AnimationManager::update(const AnimationParams& params) {
+    uint32_t key = mixKey(2166136261UL, progressKey(params.progress));
+    key = mixKey(key, colorKey(params.primaryColor));
+    key = mixKey(key, colorKey(params.secondaryColor));
+    noteRenderKey(mixKey(key, params.brightness));
+    
+    CRGB* leds = beginMain();
+    int count = segments[0].length;
+    
+    // Runtime dispatch on the current AnimationType / custom function
+    if (findCoveringLayer() < 0) {
+        // Comet trails and custom effects build on the previous frame
+        if (customAnimationFunc != nullptr || customProgram != nullptr ||
+            currentAnimation == AnimationType::COMET) {
+            loadPrevious(segments[0], leds);
+        }
+        if (customProgram != nullptr) {
+            runAnimationProgram(customProgram, customProgramLength, leds, count, params);
+        } else {
+            render(currentAnimation, customAnimationFunc, leds, count, params);
+        }
+    }
+    compositeLayers(leds, count, params.timestamp);
+    finishFrame(params.timestamp);
+}
+
+void AnimationManager::draw(const CountdownParams& params) {
+    noteRenderKey(mixKey(mixKey(2166136261UL, progressKey(params.progress)), colorKey(params.color)));
+    
+    CRGB* leds = beginMain();
+    int count = segments[0].length;
+    
+    if (findCoveringLayer() < 0) {
+        // Swap in a frame prepared ahead of time, otherwise render it now
+        if (count == preparedCount && countdownLevel(params.progress, count) == preparedLevel &&
+            params.color == preparedColor) {
+            memcpy(leds, preparedLeds, count * sizeof(CRGB));
+        } else {
+            countdownKernel(leds, count, params.progress, params.color);
+        }
+        preparedCount = -1;
+    }
+    compositeLayers(leds, count, params.timestamp);
+    finishFrame(params.timestamp);
+}
+
+void AnimationManager::prepare(const CountdownParams& params) {
+    // Kept aside: the back buffer is still in use until the state changes
+    int count = segments[0].length;
+    countdownKernel(preparedLeds, count, params.progress, params.color);
+    preparedCount = count;
+    preparedLevel = countdownLevel(params.progress, count);
+    preparedColor = params.color;
+}
+
+void AnimationManager::draw(const GaugeSweepParams& params) {
+    uint32_t key = mixKey(2166136261UL, progressKey(params.progress));
+    noteRenderKey(mixKey(mixKey(key, colorKey(params.color)), params.startLeds));
+    
+    CRGB* leds = beginMain();
+    int count = segments[0].length;
+    
+    if (findCoveringLayer() < 0) {
+        gaugeSweepKernel(leds, count, params.progress, params.color, params.startLeds);
+    }
+    compositeLayers(leds, count, params.timestamp);
+    finishFrame(params.timestamp);
+}
+
+void AnimationManager::draw(const TimeSelectionParams& params) {
+    noteRenderKey(mixKey(2166136261UL, progressKey(params.progress)));
+    
+    CRGB* leds = beginMain();
+    int count = segments[0].length;
+    
+    if (findCoveringLayer() < 0) {
+        timeSelectionKernel(leds, count, params.progress, params.timestamp);
+    }
+    compositeLayers(leds, count, params.timestamp);
+    finishFrame(params.timestamp);
+}
+
+void AnimationManager::compositeLayers(CRGB* leds, int count, uint64_t timestamp) {
+    // The topmost opaque REPLACE layer hides everything below it
+    int coveringLayer = findCoveringLayer();
+    int firstLayer = (coveringLayer < 0) ? 0 : coveringLayer;
+    
+    // Composite overlays in one pass each (layers share the base timestamp)
+    for (int i = firstLayer; i < layerCount; i++) {
+        if (!isLayerVisible(i)) {
+            continue;
+        }
+        
+        AnimationLayer& layer = layers[i];
+        AnimationParams layerParams = layer.params;
+        layerParams.timestamp = timestamp;
+        render(layer.type, layer.func, layer.frame, count, layerParams);
+        
+        if (i == coveringLayer) {
+            memcpy(leds, layer.frame, count * sizeof(CRGB));
+        } else {
+            blendLayer(leds, layer.frame, count, layer.blend, layer.opacity);
+        }
+    }
+}
+
+int AnimationManager::findCoveringLayer() const {
+    for (int i = layerCount - 1; i >= 0; i--) {
+        if (isLayerVisible(i) && layers[i].blend == BlendMode::REPLACE && layers[i].opacity == 255) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void AnimationManager::render(AnimationType type, const AnimationFunction& func, CRGB* target,
+                              int count, const AnimationParams& params) {
     // Use custom animation if set
-    if (customAnimationFunc != nullptr) {
-        customAnimationFunc(leds, numLeds, params);
+    if (func != nullptr) {
+        func(target, count, params);
         return;
     }
     
+    // Asset pack programs override the built-in (one index lookup)
+    uint16_t length = 0;
+    const uint8_t* program = (assets != nullptr) ? assets->getProgram(type, &length) : nullptr;
+    if (program != nullptr) {
+        runAnimationProgram(program, length, target, count, params);
+        return;
+    }
+    
+    // Periodic animations play back from the baked brightness table
+    if (renderCached(type, target, count, params)) {
+        return;
+    }
+    
+#if ANIMATION_BYTECODE
+    // Built-ins as flash-resident bytecode
+    uint16_t builtinLength = 0;
+    const uint8_t* builtin = getBuiltinProgram(type, &builtinLength);
+    runAnimationProgram(builtin, builtinLength, target, count, params);
+#else
     // Use built-in animations
-    switch (currentAnimation) {
+    switch (type) {
         case AnimationType::COUNTDOWN:
-            anim_countdown(leds, numLeds, params);
+            anim_countdown(target, count, params);
             break;
         case AnimationType::COMET:
-            anim_comet(leds, numLeds, params);
+            anim_comet(target, count, params);
             break;
         case AnimationType::PULSE:
-            anim_pulse(leds, numLeds, params);
+            anim_pulse(target, count, params);
             break;
         case AnimationType::SOLID_COLOR:
-            anim_solidColor(leds, numLeds, params);
+            anim_solidColor(target, count, params);
             break;
         case AnimationType::TIME_SELECTION:
-            anim_timeSelection(leds, numLeds, params);
+            anim_timeSelection(target, count, params);
             break;
         case AnimationType::GAUGE_SWEEP:
-            anim_gaugeSweep(leds, numLeds, params);
+            anim_gaugeSweep(target, count, params);
             break;
         case AnimationType::FLASH_COMPLETE:
-            anim_flashComplete(leds, numLeds, params);
+            anim_flashComplete(target, count, params);
             break;
         case AnimationType::FLASH_CANCELLED:
-            anim_flashCancelled(leds, numLeds, params);
+            anim_flashCancelled(target, count, params);
+            break;
+        case AnimationType::PAUSED:
+            anim_paused(target, count, params);
             break;
         case AnimationType::OFF:
         default:
-            anim_off(leds, numLeds, params);
+            anim_off(target, count, params);
             break;
     }
+#endif
 }
 
 void AnimationManager::clear() {
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = CRGB::Black;
+    fillPixels(backBuffer(), numLeds, CRGB::Black);
+    for (int s = 1; s < segmentCount; s++) {
+        segments[s].staleBuffers = 0x3;
     }
+    frameReady = true;
 }
 
 void AnimationManager::show() {
-    FastLED.show();
+    uint64_t start = Clock::nowMicros();
+    
+    // Zero-copy swap: the finished back buffer goes on the wire and the
+    // old front becomes the next render target. If the previous frame is
+    // still transmitting, keep this one pending instead of blocking.
+    bool outputsReady = true;
+    for (int i = 0; i < outputCount; i++) {
+        outputsReady = outputsReady && outputs[i].output->isReady();
+    }
+    
+    if (frameReady && outputsReady) {
+        frontIndex ^= 1;
+        frameReady = false;
+        CRGB* frame = frontBuffer();
+        for (int i = 0; i < outputCount; i++) {
+            outputs[i].output->submit(frame + outputs[i].first, outputs[i].count);
+        }
+        if (capture != nullptr) {
+            capture->capture(frame, numLeds, start);
+        }
+        if (latency != nullptr && renderKeyChanged) {
+            // The first visible frame rendered from new inputs answers the
+            // input; a crossfade starts on the old frame, so wait for it to move
+            if (memcmp(frame, backBuffer(), numLeds * sizeof(CRGB)) != 0) {
+                latency->markOutput(LatencyChannel::LED);
+                renderKeyChanged = false;
+            } else if (crossfadeDuration == 0) {
+                renderKeyChanged = false;
+            }
+        }
+    }
+    
+    lastShowMicros = (uint32_t)Clock::elapsedSince(start);
+}
+
+const CRGB* AnimationManager::getFrame() {
+    return frontBuffer();
+}
+
+void AnimationManager::setCapture(FrameCapture* frameCapture) {
+    capture = frameCapture;
+}
+
+void AnimationManager::setLatencyProbe(LatencyProbe* probe) {
+    latency = probe;
+}
+
+void AnimationManager::noteRenderKey(uint32_t key) {
+    // Everything a frame is rendered from except time: a frame that moved
+    // only with the timestamp (breathing cursor, pulse) answers no input
+    key = mixKey(key, (uint32_t)currentAnimation);
+    key = mixKey(key, (uint32_t)(uintptr_t)customProgram);
+    key = mixKey(key, colorKey(primaryColor));
+    key = mixKey(key, colorKey(secondaryColor));
+    key = mixKey(key, brightness);
+    if (key != renderKey) {
+        renderKey = key;
+        renderKeyChanged = true;
+    }
+}
+
+uint32_t AnimationManager::getLastShowMicros() const {
+    return lastShowMicros;
+}
+
+CRGB* AnimationManager::frontBuffer() {
+    // Derived from 'this' each call so copies of the manager stay valid
+    return (frontIndex == 0) ? outputLeds : internalLeds;
+}
+
+CRGB* AnimationManager::backBuffer() {
+    return (frontIndex == 0) ? internalLeds : outputLeds;
+}
+
+// ==========================================
+// Crossfade
+// ==========================================
+
+void AnimationManager::startCrossfade(uint16_t durationMs) {
+    // Fade from whatever is currently on the wire
+    memcpy(crossfadeFrom, frontBuffer(), numLeds * sizeof(CRGB));
+    crossfadeStart = Clock::nowMicros();
+    crossfadeDuration = MS_TO_US(durationMs);
+}
+
+bool AnimationManager::isCrossfading() const {
+    return crossfadeDuration != 0;
+}
+
+void AnimationManager::finishFrame(uint64_t timestamp) {
+    if (!isIdentity(segments[0])) {
+        mapSegment(segments[0], segmentBuffer, backBuffer());
+    }
+    renderSegments(timestamp);
+    
+    if (crossfadeDuration != 0) {
+        uint64_t elapsed = Clock::elapsedSince(crossfadeStart);
+        
+        if (elapsed >= crossfadeDuration) {
+            crossfadeDuration = 0;
+        } else {
+            uint16_t weight = (uint16_t)((elapsed * 256) / crossfadeDuration);
+            CRGB* leds = backBuffer();
+            lerpFrames(leds, crossfadeFrom, leds, numLeds, weight);
+            
+            // The blend overwrote static segments in this buffer
+            for (int s = 1; s < segmentCount; s++) {
+                segments[s].staleBuffers |= (uint8_t)(1 << (frontIndex ^ 1));
+            }
+        }
+    }
+    frameReady = true;
+}
+
+void AnimationManager::lerpFrames(CRGB* out, const CRGB* from, const CRGB* to, int numLeds,
+                                  uint16_t weight) {
+    // out = from + (to - from) * weight / 256, weight in 0..256
+    lerpPixels(out, from, to, numLeds, weight);
 }
 
 void AnimationManager::setBrightness(uint8_t newBrightness) {
     brightness = newBrightness;
-    FastLED.setBrightness(brightness);
+    for (int i = 0; i < outputCount; i++) {
+        outputs[i].output->setBrightness(brightness);
+    }
 }
 
 void AnimationManager::setColors(CRGB primary, CRGB secondary) {
@@ -85,6 +474,317 @@ void AnimationManager::setColors(CRGB primary, CRGB secondary) {
     secondaryColor = secondary;
 }
 
+// ==========================================
+// Segments
+// ==========================================
+
+void AnimationManager::setMainSegment(uint16_t start, uint16_t length) {
+    if (start >= numLeds || length == 0) {
+        return;
+    }
+    
+    segments[0].start = start;
+    segments[0].length = (uint16_t)min((int)length, numLeds - start);
+    segments[0].offset = segments[0].offset % segments[0].length;
+}
+
+int AnimationManager::addSegment(const char* name, uint16_t start, uint16_t length, AnimationType type) {
+    if (segmentCount >= MAX_LED_SEGMENTS || length == 0 || start + length > numLeds) {
+        return -1;
+    }
+    
+    LedSegment& segment = segments[segmentCount];
+    segment.name = name;
+    segment.start = start;
+    segment.length = length;
+    segment.offset = 0;
+    segment.reversed = false;
+    segment.type = type;
+    segment.params.progress = 0.0f;
+    segment.params.primaryColor = primaryColor;
+    segment.params.secondaryColor = secondaryColor;
+    segment.params.brightness = brightness;
+    segment.params.timestamp = 0;
+    segment.staleBuffers = 0x3;
+    
+    return segmentCount++;
+}
+
+int AnimationManager::findSegment(const char* name) const {
+    for (int s = 0; s < segmentCount; s++) {
+        if (strcmp(segments[s].name, name) == 0) {
+            return s;
+        }
+    }
+    return -1;
+}
+
+void AnimationManager::setSegmentMapping(int segment, uint16_t offset, bool reversed) {
+    if (segment >= 0 && segment < segmentCount) {
+        segments[segment].offset = offset % segments[segment].length;
+        segments[segment].reversed = reversed;
+        segments[segment].staleBuffers = 0x3;
+    }
+}
+
+void AnimationManager::setSegmentAnimation(int segment, AnimationType type) {
+    // Segment 0 follows setAnimation()
+    if (segment > 0 && segment < segmentCount && segments[segment].type != type) {
+        segments[segment].type = type;
+        segments[segment].staleBuffers = 0x3;
+    }
+}
+
+void AnimationManager::setSegmentParams(int segment, const AnimationParams& params) {
+    if (segment <= 0 || segment >= segmentCount) {
+        return;
+    }
+    
+    // Timestamps alone never dirty a segment; time-based types redraw anyway
+    AnimationParams& current = segments[segment].params;
+    if (current.progress != params.progress || current.primaryColor != params.primaryColor ||
+        current.secondaryColor != params.secondaryColor || current.brightness != params.brightness) {
+        segments[segment].staleBuffers = 0x3;
+    }
+    current = params;
+}
+
+CRGB* AnimationManager::beginMain() {
+    // Identity-mapped main segment renders straight into the frame
+    if (isIdentity(segments[0])) {
+        return backBuffer() + segments[0].start;
+    }
+    return segmentBuffer;
+}
+
+void AnimationManager::renderSegments(uint64_t timestamp) {
+    uint8_t backBit = (uint8_t)(1 << (frontIndex ^ 1));
+    
+    for (int s = 1; s < segmentCount; s++) {
+        LedSegment& segment = segments[s];
+        
+        // Static segments are skipped once both buffers hold their render
+        if (!(segment.staleBuffers & backBit) && !isTimeBased(segment.type)) {
+            continue;
+        }
+        
+        bool identity = isIdentity(segment);
+        CRGB* leds = identity ? backBuffer() + segment.start : segmentBuffer;
+        
+        if (segment.type == AnimationType::COMET) {
+            loadPrevious(segment, leds);
+        }
+        
+        AnimationParams params = segment.params;
+        params.timestamp = timestamp;
+        render(segment.type, nullptr, leds, segment.length, params);
+        
+        if (!identity) {
+            mapSegment(segment, segmentBuffer, backBuffer());
+        }
+        segment.staleBuffers &= (uint8_t)~backBit;
+    }
+}
+
+void AnimationManager::loadPrevious(const LedSegment& segment, CRGB* logical) {
+    CRGB* front = frontBuffer();
+    
+    if (isIdentity(segment)) {
+        memcpy(logical, front + segment.start, segment.length * sizeof(CRGB));
+        return;
+    }
+    
+    for (int i = 0; i < segment.length; i++) {
+        int pos = segment.reversed ? (segment.length - 1 - i) : i;
+        pos = (pos + segment.offset) % segment.length;
+        logical[i] = front[segment.start + pos];
+    }
+}
+
+void AnimationManager::mapSegment(const LedSegment& segment, const CRGB* logical, CRGB* physical) {
+    for (int i = 0; i < segment.length; i++) {
+        int pos = segment.reversed ? (segment.length - 1 - i) : i;
+        pos = (pos + segment.offset) % segment.length;
+        physical[segment.start + pos] = logical[i];
+    }
+}
+
+bool AnimationManager::isIdentity(const LedSegment& segment) {
+    return segment.offset == 0 && !segment.reversed;
+}
+
+bool AnimationManager::isTimeBased(AnimationType type) {
+    switch (type) {
+        case AnimationType::COMET:
+        case AnimationType::PULSE:
+        case AnimationType::TIME_SELECTION:
+        case AnimationType::FLASH_COMPLETE:
+        case AnimationType::FLASH_CANCELLED:
+        case AnimationType::PAUSED:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// ==========================================
+// Periodic Frame Cache
+// ==========================================
+
+static_assert(ANIM_FRAME_CACHE_BYTES > 0 && ANIM_FRAME_CACHE_BYTES <= 65535,
+              "ANIM_FRAME_CACHE_BYTES must be 1..65535 (table step divides by it, cacheFrames is 16 bits)");
+
+void AnimationManager::setFrameCacheEnabled(bool enabled) {
+    frameCacheEnabled = enabled;
+    invalidateFrameCache();
+}
+
+void AnimationManager::invalidateFrameCache() {
+    cacheFrames = 0;
+}
+
+uint16_t AnimationManager::getFrameCacheFrames() const {
+    return cacheFrames;
+}
+
+uint32_t AnimationManager::frameCacheStep(uint32_t periodUs) {
+    // The frame interval, or coarser if the period would not fit in the cap
+    uint64_t stepUs = ANIMATION_INTERVAL * 1000UL;
+    if (((uint64_t)periodUs + stepUs - 1) / stepUs > ANIM_FRAME_CACHE_BYTES) {
+        stepUs = ((uint64_t)periodUs + ANIM_FRAME_CACHE_BYTES - 1) / ANIM_FRAME_CACHE_BYTES;
+    }
+    return (uint32_t)stepUs;
+}
+
+bool AnimationManager::renderCached(AnimationType type, CRGB* target, int count,
+                                    const AnimationParams& params) {
+    // Only the base animation is baked; a layer or segment of another
+    // periodic type would otherwise rebake the single table every frame
+    PeriodicProfile profile;
+    if (!frameCacheEnabled || type != currentAnimation || !getPeriodicProfile(type, profile)) {
+        return false;
+    }
+    
+    // Bake lazily: one period sampled at the table step
+    if (cacheFrames == 0 || cacheType != type) {
+        uint32_t stepUs = frameCacheStep(profile.periodUs);
+        uint32_t frames = (uint32_t)(((uint64_t)profile.periodUs + stepUs - 1) / stepUs);
+        
+        for (uint32_t f = 0; f < frames; f++) {
+            cacheTable[f] = periodicLevel(profile, (float)(f * stepUs) / (float)profile.periodUs);
+        }
+        
+        cacheType = type;
+        cacheStepUs = stepUs;
+        cacheFrames = (uint16_t)frames;
+    }
+    
+    // Playback: table index plus one colour scale
+    uint32_t frame = (uint32_t)(params.timestamp % profile.periodUs) / cacheStepUs;
+    CRGB color = params.primaryColor;
+    color.nscale8_video(cacheTable[frame]);
+    
+    fillPixels(target, count, color);
+    return true;
+}
+
+// ==========================================
+// Layer Stack
+// ==========================================
+
+int AnimationManager::addLayer(AnimationType type, BlendMode blend, uint8_t opacity) {
+    if (layerCount >= MAX_ANIMATION_LAYERS) {
+        return -1;
+    }
+    
+    AnimationLayer& layer = layers[layerCount];
+    layer.type = type;
+    layer.func = nullptr;
+    layer.params.progress = 0.0f;
+    layer.params.primaryColor = primaryColor;
+    layer.params.secondaryColor = secondaryColor;
+    layer.params.brightness = brightness;
+    layer.params.timestamp = 0;
+    layer.opacity = opacity;
+    layer.blend = blend;
+    layer.enabled = true;
+    fillPixels(layer.frame, NUM_LEDS, CRGB::Black);
+    
+    return layerCount++;
+}
+
+int AnimationManager::addCustomLayer(const AnimationFunction& func, BlendMode blend, uint8_t opacity) {
+    int layer = addLayer(AnimationType::OFF, blend, opacity);
+    if (layer >= 0) {
+        layers[layer].func = func;
+    }
+    return layer;
+}
+
+void AnimationManager::setLayerParams(int layer, const AnimationParams& params) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].params = params;
+    }
+}
+
+void AnimationManager::setLayerOpacity(int layer, uint8_t opacity) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].opacity = opacity;
+    }
+}
+
+void AnimationManager::setLayerEnabled(int layer, bool enabled) {
+    if (layer >= 0 && layer < layerCount) {
+        layers[layer].enabled = enabled;
+    }
+}
+
+void AnimationManager::clearLayers() {
+    layerCount = 0;
+}
+
+bool AnimationManager::isLayerVisible(int layer) const {
+    return layers[layer].enabled && layers[layer].opacity > 0;
+}
+
+void AnimationManager::blendLayer(CRGB* dst, const CRGB* src, int numLeds,
+                                  BlendMode blend, uint8_t opacity) {
+    // Integer kernels; weights are 0..256 so full opacity is an exact copy
+    uint16_t weight = opacity + (opacity >> 7);
+    
+    switch (blend) {
+        case BlendMode::REPLACE:
+            lerpFrames(dst, dst, src, numLeds, weight);
+            break;
+            
+        case BlendMode::ADD:
+            addPixelsScaled(dst, src, numLeds, weight);
+            break;
+            
+        case BlendMode::MAX:
+            for (int i = 0; i < numLeds; i++) {
+                for (int c = 0; c < 3; c++) {
+                    uint8_t value = (uint8_t)((src[i].raw[c] * weight) >> 8);
+                    if (value > dst[i].raw[c]) {
+                        dst[i].raw[c] = value;
+                    }
+                }
+            }
+            break;
+            
+        case BlendMode::ALPHA:
+            for (int i = 0; i < numLeds; i++) {
+                uint8_t coverage = max(src[i].r, max(src[i].g, src[i].b));
+                uint16_t alpha = (coverage * weight) >> 8;
+                alpha += alpha >> 7;
+                for (int c = 0; c < 3; c++) {
+                    dst[i].raw[c] = (uint8_t)((dst[i].raw[c] * (256 - alpha) + src[i].raw[c] * alpha) >> 8);
+                }
+            }
+            break;
+    }
+}
+
 // ==========================================
 // Helper Functions
 // ==========================================
@@ -118,29 +818,38 @@ float AnimationManager::easeOutBounce(float x) {
     }
 }
 
+float AnimationManager::periodPhase(uint64_t timestampUs, uint32_t periodUs) {
+    // Integer modulo keeps full precision however large the timestamp gets
+    return (float)(uint32_t)(timestampUs % periodUs) / (float)periodUs;
+}
+
 // ==========================================
 // Built-in Animation Functions
 // ==========================================
 
-void anim_countdown(CRGB* leds, int numLeds, const AnimationParams& params) {
+// Everything countdownKernel reads from progress, in its arithmetic: lit
+// LEDs in the high bits, the partial LED's level in the low byte
+static inline int32_t countdownLevel(float progress, int numLeds) {
+    float ledsExact = progress * numLeds;
+    int fullLeds = (int)ledsExact;
+    return fullLeds * 256 + (uint8_t)((ledsExact - fullLeds) * 255);
+}
+
+// Kernels shared by the typed draw() path and the AnimationParams wrappers
+static inline void countdownKernel(CRGB* leds, int numLeds, float progress, CRGB primaryColor) {
     // Smooth countdown
-    float ledsExact = params.progress * numLeds;
+    float ledsExact = progress * numLeds;
     int fullLeds = (int)ledsExact;
     float partialLed = ledsExact - fullLeds;
     
-    // Clear
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = CRGB::Black;
-    }
-    
-    // Fill full LEDs
-    for (int i = 0; i < fullLeds; i++) {
-        leds[i] = params.primaryColor;
-    }
+    // Fill full LEDs, clear the rest
+    int lit = CLAMP(fullLeds, 0, numLeds);
+    fillPixels(leds, lit, primaryColor);
+    fillPixels(leds + lit, numLeds - lit, CRGB::Black);
     
     // Partial LED with gamma correction for smoothness
     if (fullLeds < numLeds && fullLeds >= 0) {
-        CRGB color = params.primaryColor;
+        CRGB color = primaryColor;
         // Apply gamma to the partial brightness so it doesn't look too dim too fast
         uint8_t scaledBrightness = AnimationManager::applyGamma((uint8_t)(partialLed * 255));
         color.nscale8_video(scaledBrightness);
@@ -148,15 +857,17 @@ void anim_countdown(CRGB* leds, int numLeds, const AnimationParams& params) {
     }
 }
 
+void anim_countdown(CRGB* leds, int numLeds, const AnimationParams& params) {
+    countdownKernel(leds, numLeds, params.progress, params.primaryColor);
+}
+
 void anim_comet(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // Speed: 1 rotation per second (approx)
-    float speed = 0.001f; // cycles per ms
-    float rawPos = params.timestamp * speed * numLeds;
+    // Speed: 1 rotation per second
+    float posInRing = AnimationManager::periodPhase(params.timestamp, 1000000UL) * numLeds;
     
-    fadeToBlackBy(leds, numLeds, 20); // Trail fading (adjusted for 60fps)
+    scalePixels(leds, numLeds, 255 - 20); // Trail fading (adjusted for 60fps)
     
     // Draw comet head and fractional neighbor
-    float posInRing = fmod(rawPos, numLeds);
     int headIdx = (int)posInRing;
     float frac = posInRing - headIdx;
     
@@ -164,95 +875,90 @@ void anim_comet(CRGB* leds, int numLeds, const AnimationParams& params) {
     CRGB colorHead = params.primaryColor;
     CRGB colorNext = params.primaryColor;
     
-    // Distribute brightness between head and next pixel
-    colorHead.nscale8(255 - (frac * 255));
-    colorNext.nscale8(frac * 255);
+    // Distribute brightness between head and next pixel (shares add up to 255)
+    uint8_t nextShare = (uint8_t)(frac * 255);
+    colorHead.nscale8(255 - nextShare);
+    colorNext.nscale8(nextShare);
     
     leds[headIdx] += colorHead;
     leds[(headIdx + 1) % numLeds] += colorNext;
 }
 
 void anim_pulse(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // Breathing effect using easeInOutCubic
-    // 3 second cycle
-    float cycle = fmod(params.timestamp, 3000.0f) / 3000.0f; 
-    
-    // Ping-pong the cycle (0->1->0)
-    float pingPong = (cycle < 0.5f) ? (cycle * 2.0f) : ((1.0f - cycle) * 2.0f);
-    
-    // Apply easing
-    float breathe = AnimationManager::easeInOutCubic(pingPong);
-    
-    // Map 0.0-1.0 to min-max brightness (e.g., 20% to 100%)
-    float brightnessFactor = 0.2f + (0.8f * breathe);
+    // Breathing effect using easeInOutCubic, 3 second cycle, 20% to 100%
+    PeriodicProfile profile;
+    getPeriodicProfile(AnimationType::PULSE, profile);
     
     CRGB color = params.primaryColor;
-    color.nscale8_video(AnimationManager::applyGamma((uint8_t)(brightnessFactor * 255)));
+    color.nscale8_video(periodicLevel(profile, AnimationManager::periodPhase(params.timestamp, profile.periodUs)));
     
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = color;
-    }
+    fillPixels(leds, numLeds, color);
 }
 
 void anim_solidColor(CRGB* leds, int numLeds, const AnimationParams& params) {
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = params.primaryColor;
-    }
+    fillPixels(leds, numLeds, params.primaryColor);
 }
 
-void anim_timeSelection(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // params.progress is 0.0 to 1.0 based on selected time
+static inline void timeSelectionKernel(CRGB* leds, int numLeds, float progress, uint64_t timestamp) {
+    // progress is 0.0 to 1.0 based on selected time
     
-    float ledsExact = params.progress * numLeds;
+    float ledsExact = progress * numLeds;
     int fullLeds = (int)ledsExact;
     float partialLed = ledsExact - fullLeds;
     
     // Breathing effect for the "cursor" (the last active LED)
-    // 1.5s breathing cycle
-    float breathe = (sin(params.timestamp * 0.004f) + 1.0f) * 0.5f; // 0.0 to 1.0
+    // ~1.57s breathing cycle (0.004 rad/ms)
+    float angle = AnimationManager::periodPhase(timestamp, 1570796UL) * 2.0f * (float)M_PI;
+    float breathe = (sin(angle) + 1.0f) * 0.5f; // 0.0 to 1.0
     
-    for (int i = 0; i < numLeds; i++) {
-        if (i < fullLeds) {
-            // Full on
-            leds[i] = CRGB::White;
-            
-            // If this is the very last fully lit LED and there's no partial, pulse it
-            if (i == fullLeds - 1 && partialLed < 0.01f) {
-                 // Slight dip in brightness to indicate it's the "active" end
-                 uint8_t pulse = 200 + (uint8_t)(55 * breathe); 
-                 leds[i].nscale8(pulse);
-            }
-        } else if (i == fullLeds) {
-            // Partial LED (Cursor)
-            // Combine partial coverage with breathing
-            CRGB color = CRGB::White;
-            
-            // Base brightness from how "full" this minute step is
-            // + Breathing effect superimposed
-            float smoothPartial = partialLed; // Could ease this too
-            
-            // Make the partial LED breathe noticeably to invite interaction
-            float pulseFactor = 0.5f + (0.5f * breathe); 
-            
-            uint8_t finalBrightness = (uint8_t)(smoothPartial * 255 * pulseFactor);
-            // Ensure visibility if it's non-zero
-            if (finalBrightness < 10 && smoothPartial > 0.01f) finalBrightness = 10;
-            
-            color.nscale8_video(AnimationManager::applyGamma(finalBrightness));
-            leds[i] = color;
-        } else {
-            leds[i] = CRGB::Black;
-        }
+    // Full on
+    int lit = CLAMP(fullLeds, 0, numLeds);
+    fillPixels(leds, lit, CRGB::White);
+    
+    // If the last fully lit LED has no partial after it, pulse it
+    if (fullLeds >= 1 && fullLeds <= numLeds && partialLed < 0.01f) {
+         // Slight dip in brightness to indicate it's the "active" end
+         uint8_t pulse = 200 + (uint8_t)(55 * breathe); 
+         leds[fullLeds - 1].nscale8(pulse);
+    }
+    
+    if (fullLeds >= 0 && fullLeds < numLeds) {
+        // Partial LED (Cursor)
+        // Combine partial coverage with breathing
+        CRGB color = CRGB::White;
+        
+        // Base brightness from how "full" this minute step is
+        // + Breathing effect superimposed
+        float smoothPartial = partialLed; // Could ease this too
+        
+        // Make the partial LED breathe noticeably to invite interaction
+        float pulseFactor = 0.5f + (0.5f * breathe); 
+        
+        uint8_t finalBrightness = (uint8_t)(smoothPartial * 255 * pulseFactor);
+        // Ensure visibility if it's non-zero
+        if (finalBrightness < 10 && smoothPartial > 0.01f) finalBrightness = 10;
+        
+        color.nscale8_video(AnimationManager::applyGamma(finalBrightness));
+        leds[fullLeds] = color;
     }
+    
+    // Everything past the cursor is off
+    int unlit = CLAMP(fullLeds + 1, 0, numLeds);
+    fillPixels(leds + unlit, numLeds - unlit, CRGB::Black);
 }
 
-void anim_gaugeSweep(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // Sweep from 'selectedLeds' (params.secondaryColor.r) to 'numLeds'
-    int selectedLeds = params.secondaryColor.r;
-    if (selectedLeds == 0) selectedLeds = 1;
+void anim_timeSelection(CRGB* leds, int numLeds, const AnimationParams& params) {
+    timeSelectionKernel(leds, numLeds, params.progress, params.timestamp);
+}
+
+static inline void gaugeSweepKernel(CRGB* leds, int numLeds, float progress, CRGB primaryColor,
+                                    int selectedLeds) {
+    // Sweep from 'selectedLeds' to 'numLeds'
+    if (selectedLeds <= 0) selectedLeds = 1;
+    if (selectedLeds > numLeds) selectedLeds = numLeds;
     
     // Eased progress for mechanical feel
-    float easedProgress = AnimationManager::easeOutQuart(params.progress);
+    float easedProgress = AnimationManager::easeOutQuart(progress);
     
     // Calculate how many LEDs to add on top of selectedLeds
     int ledsToFill = numLeds - selectedLeds;
@@ -262,22 +968,14 @@ void anim_gaugeSweep(CRGB* leds, int numLeds, const AnimationParams& params) {
     int fullLit = (int)totalLitExact;
     float partialLit = totalLitExact - fullLit;
     
-    // Clear
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = CRGB::Black;
-    }
-    
-    // Render
-    for (int i = 0; i < fullLit; i++) {
-        leds[i] = params.primaryColor;
-        
-        // Boost brightness of the leading edge slightly for a "scanner" look?
-        // Or just keep it solid red. Solid red is cleaner.
-    }
+    // Render solid (a brighter "scanner" leading edge looked busier), clear the rest
+    int lit = CLAMP(fullLit, 0, numLeds);
+    fillPixels(leds, lit, primaryColor);
+    fillPixels(leds + lit, numLeds - lit, CRGB::Black);
     
     // Partial leading edge
     if (fullLit < numLeds) {
-        CRGB color = params.primaryColor;
+        CRGB color = primaryColor;
         // Make the leading edge bright/sharp, with gamma for smoothness
         uint8_t scaledBrightness = AnimationManager::applyGamma((uint8_t)(partialLit * 255));
         color.nscale8_video(scaledBrightness);
@@ -285,51 +983,44 @@ void anim_gaugeSweep(CRGB* leds, int numLeds, const AnimationParams& params) {
     }
 }
 
+void anim_gaugeSweep(CRGB* leds, int numLeds, const AnimationParams& params) {
+    // Generic path has no start position: sweep up from the first LED
+    gaugeSweepKernel(leds, numLeds, params.progress, params.primaryColor, 1);
+}
+
 void anim_flashComplete(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // Heartbeat/Pulse animation for completion
-    // Cycle duration: 1000ms
-    uint32_t cycleDuration = 1000;
-    
-    // Calculate cycle phase (0.0 to 1.0)
-    float phase = fmod(params.timestamp, cycleDuration) / (float)cycleDuration;
-    
-    // Ping-pong for pulse (in-out)
-    float pingPong = (phase < 0.5f) ? (phase * 2.0f) : ((1.0f - phase) * 2.0f);
-    
-    // Use easeInOutCubic for natural heartbeat
-    float brightness = AnimationManager::easeInOutCubic(pingPong);
+    // Heartbeat/Pulse animation for completion, 1000ms cycle
+    PeriodicProfile profile;
+    getPeriodicProfile(AnimationType::FLASH_COMPLETE, profile);
     
     CRGB color = params.primaryColor; // Green
-    color.nscale8_video(AnimationManager::applyGamma((uint8_t)(brightness * 255)));
+    color.nscale8_video(periodicLevel(profile, AnimationManager::periodPhase(params.timestamp, profile.periodUs)));
     
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = color;
-    }
+    fillPixels(leds, numLeds, color);
 }
 
 void anim_flashCancelled(CRGB* leds, int numLeds, const AnimationParams& params) {
-    // Similar to Complete but maybe faster/sharper?
-    // Let's use the same easeOutBounce for a "error" feel? 
-    // Or just a smooth pulse like complete but Red.
-    
-    // Let's stick to smooth pulse but faster
-    uint32_t cycleDuration = 800; // Faster pulse for error/cancel
-    
-    float phase = fmod(params.timestamp, cycleDuration) / (float)cycleDuration;
-    float pingPong = (phase < 0.5f) ? (phase * 2.0f) : ((1.0f - phase) * 2.0f);
-    
-    float brightness = AnimationManager::easeInOutCubic(pingPong);
+    // Same smooth pulse as complete but faster (800ms) for error/cancel
+    PeriodicProfile profile;
+    getPeriodicProfile(AnimationType::FLASH_CANCELLED, profile);
     
     CRGB color = params.primaryColor; // Red
-    color.nscale8_video(AnimationManager::applyGamma((uint8_t)(brightness * 255)));
+    color.nscale8_video(periodicLevel(profile, AnimationManager::periodPhase(params.timestamp, profile.periodUs)));
     
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = color;
-    }
+    fillPixels(leds, numLeds, color);
+}
+
+void anim_paused(CRGB* leds, int numLeds, const AnimationParams& params) {
+    // Frozen countdown ring, slowly breathing between 25% and 60%
+    float cycle = AnimationManager::periodPhase(params.timestamp, 4000000UL);
+    float pingPong = (cycle < 0.5f) ? (cycle * 2.0f) : ((1.0f - cycle) * 2.0f);
+    float breathe = AnimationManager::easeInOutCubic(pingPong);
+    uint8_t level = AnimationManager::applyGamma((uint8_t)((0.25f + 0.35f * breathe) * 255));
+    
+    countdownKernel(leds, numLeds, params.progress, params.primaryColor);
+    scalePixelsVideo(leds, numLeds, level);
 }
 
 void anim_off(CRGB* leds, int numLeds, const AnimationParams& params) {
-    for (int i = 0; i < numLeds; i++) {
-        leds[i] = CRGB::Black;
-    }
+    fillPixels(leds, numLeds, CRGB::Black);
 }
\ No newline at end of file
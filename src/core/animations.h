@@ -4,6 +4,12 @@
 #include <FastLED.h>
 #include "types.h"
 #include "config.h"
+#include "led_output.h"
+#include "frame_capture.h"
+#include "latency.h"
+#include "delegate.h"
+
+class AssetPack;
 
 // Animation parameters structure
 struct AnimationParams {
@@ -11,42 +17,212 @@ struct AnimationParams {
     CRGB primaryColor;
     CRGB secondaryColor;
     uint8_t brightness;
-    uint32_t timestamp;    // For time-based animations
+    uint64_t timestamp;    // Microseconds (Clock::nowMicros) for time-based animations
+};
+
+// Typed parameters for animations with their own inputs (used by draw()).
+// Overload resolution picks the renderer at compile time.
+struct CountdownParams {
+    float progress;        // 0.0 to 1.0 remaining
+    CRGB color;
+    uint64_t timestamp;
+};
+
+struct GaugeSweepParams {
+    float progress;        // 0.0 to 1.0 through the sweep
+    CRGB color;
+    uint16_t startLeds;    // LEDs lit before the sweep starts
+    uint64_t timestamp;
+};
+
+struct TimeSelectionParams {
+    float progress;        // Selected fraction of the maximum time
+    uint64_t timestamp;
 };
 
-// Animation function pointer type
-typedef void (*AnimationFunction)(CRGB* leds, int numLeds, const AnimationParams& params);
+// Custom animation (built-ins are dispatched statically)
+typedef Delegate<void(CRGB* leds, int numLeds, const AnimationParams& params)> AnimationFunction;
+
+// How a layer combines with what is below it
+enum class BlendMode {
+    REPLACE,    // Crossfade towards the layer by opacity
+    ADD,        // Saturating add
+    MAX,        // Per-channel maximum
+    ALPHA       // Coverage = brightest channel x opacity (black is transparent)
+};
+
+// Overlay layer composited over the base animation. Each layer renders
+// into its own frame, so effects that build on their previous output
+// (COMET trails, custom functions, programs) keep their state per layer.
+struct AnimationLayer {
+    AnimationType type;
+    AnimationFunction func;     // Overrides type when set
+    AnimationParams params;
+    uint8_t opacity;
+    BlendMode blend;
+    bool enabled;
+    CRGB frame[NUM_LEDS];       // Last render of this layer
+};
+
+// Named range of physical pixels with its own animation and mapping.
+// Segment 0 ("main") carries the base animation and layers; the others
+// run their own AnimationType and are only re-rendered when they change.
+struct LedSegment {
+    const char* name;
+    uint16_t start;             // First physical pixel
+    uint16_t length;
+    uint16_t offset;            // Logical pixel 0 lands at start + offset (wraps)
+    bool reversed;              // Logical order runs backwards
+    AnimationType type;         // Secondary segments only
+    AnimationParams params;
+    uint8_t staleBuffers;       // Bit per frame buffer still holding an old render
+};
+
+// Slice of the frame fed to one physical output
+struct LedOutputBinding {
+    LedOutput* output;
+    uint16_t first;
+    uint16_t count;
+};
 
 // Animation Manager Class
 class AnimationManager {
 public:
     AnimationManager(CRGB* ledArray, int numLeds);
     
-    // Animation control
-    void setAnimation(AnimationType type);
-    void setCustomAnimation(AnimationFunction customFunc);
+    // Output binding (double-buffered: ledArray is one of the two frames)
+    void setOutput(LedOutput* ledOutput);
+    bool addOutput(LedOutput* ledOutput, uint16_t first, uint16_t count);
+    
+    // Animation control (crossfadeMs > 0 fades from the frame on the wire)
+    void setAnimation(AnimationType type, uint16_t crossfadeMs = 0);
+    void setCustomAnimation(const AnimationFunction& customFunc);
+    bool setProgram(const uint8_t* program, uint16_t length);  // Bytecode effect (see anim_program.h), kept in flash
+    void setAssets(const AssetPack* pack);      // Pack programs replace built-ins of the same type
     void update(const AnimationParams& params);
+    
+    // Statically dispatched renderers (no per-frame type switch)
+    void draw(const CountdownParams& params);
+    void draw(const GaugeSweepParams& params);
+    void draw(const TimeSelectionParams& params);
+    void prepare(const CountdownParams& params);    // Rendered ahead; draw() copies it if the frame matches
     void clear();
     void show();
+    const CRGB* getFrame();     // Frame currently on the wire
+    void setCapture(FrameCapture* frameCapture);
+    void setLatencyProbe(LatencyProbe* probe);  // Marks LED output on the first frame answering an input
+    uint32_t getLastShowMicros() const;
+    
+    // Crossfade between frames
+    void startCrossfade(uint16_t durationMs);
+    bool isCrossfading() const;
     
     // Color management
     void setBrightness(uint8_t brightness);
     void setColors(CRGB primary, CRGB secondary = CRGB::Black);
     
+    // Periodic frame cache (PULSE, FLASH_COMPLETE, FLASH_CANCELLED); off
+    // unless ANIM_FRAME_CACHE. Playback snaps time to the table step, so a
+    // frame can differ from the live one by the level change over one step.
+    void setFrameCacheEnabled(bool enabled);
+    void invalidateFrameCache();
+    uint16_t getFrameCacheFrames() const;       // Baked frames, 0 = none
+    static uint32_t frameCacheStep(uint32_t periodUs);  // Table step for a period under the RAM cap
+    
+    // Layer stack (composited in order over the base animation)
+    int addLayer(AnimationType type, BlendMode blend = BlendMode::ALPHA, uint8_t opacity = 255);
+    int addCustomLayer(const AnimationFunction& func, BlendMode blend = BlendMode::ALPHA, uint8_t opacity = 255);
+    void setLayerParams(int layer, const AnimationParams& params);
+    void setLayerOpacity(int layer, uint8_t opacity);
+    void setLayerEnabled(int layer, bool enabled);
+    void clearLayers();
+    
+    // Segments
+    void setMainSegment(uint16_t start, uint16_t length);
+    int addSegment(const char* name, uint16_t start, uint16_t length, AnimationType type);
+    int findSegment(const char* name) const;
+    void setSegmentMapping(int segment, uint16_t offset, bool reversed);
+    void setSegmentAnimation(int segment, AnimationType type);
+    void setSegmentParams(int segment, const AnimationParams& params);
+    
     // Helpers
     static uint8_t applyGamma(uint8_t brightness);
     static float easeOutQuart(float x);
     static float easeInOutCubic(float x);
     static float easeOutBounce(float x);
+    static float periodPhase(uint64_t timestampUs, uint32_t periodUs);
+    static void blendLayer(CRGB* dst, const CRGB* src, int numLeds, BlendMode blend, uint8_t opacity);
+    static void lerpFrames(CRGB* out, const CRGB* from, const CRGB* to, int numLeds, uint16_t weight);
 
 private:
-    CRGB* leds;
-    int numLeds;
+    // Front buffer is on the wire; rendering only ever touches the back buffer
+    CRGB* outputLeds;
+    CRGB internalLeds[NUM_LEDS];
+    int numLeds;                // Clamped to NUM_LEDS (size of every scratch frame)
+    uint8_t frontIndex;         // 0: outputLeds is front, 1: internalLeds is front
+    bool frameReady;
+    LedOutputBinding outputs[MAX_LED_OUTPUTS];
+    int outputCount;
+    uint32_t lastShowMicros;    // Main-loop time spent in show()
+    FrameCapture* capture;
+    LatencyProbe* latency;
+    uint32_t renderKey;         // Hash of the non-time inputs of the last frame
+    bool renderKeyChanged;      // Set until a frame from new inputs goes out
+    
+    // Crossfade state
+    CRGB crossfadeFrom[NUM_LEDS];
+    uint64_t crossfadeStart;
+    uint64_t crossfadeDuration;   // Microseconds, 0 = idle
+    
     AnimationType currentAnimation;
     AnimationFunction customAnimationFunc;
+    const uint8_t* customProgram;
+    uint16_t customProgramLength;
+    const AssetPack* assets;
     uint8_t brightness;
     CRGB primaryColor;
     CRGB secondaryColor;
+    
+    AnimationLayer layers[MAX_ANIMATION_LAYERS];
+    int layerCount;
+    
+    LedSegment segments[MAX_LED_SEGMENTS];
+    int segmentCount;
+    CRGB segmentBuffer[NUM_LEDS];   // Logical-order scratch for mapped segments
+    
+    // One period of a periodic animation baked to per-frame levels. Colour
+    // is applied at playback and brightness by the outputs, so the table
+    // depends on the animation type alone.
+    bool frameCacheEnabled;
+    AnimationType cacheType;
+    uint32_t cacheStepUs;
+    uint16_t cacheFrames;       // 0 = not baked
+    uint8_t cacheTable[ANIM_FRAME_CACHE_BYTES];
+    
+    // Countdown frame rendered ahead of a state change. Matched on what the
+    // kernel reads (lit LEDs, partial level, colour), not on the float.
+    CRGB preparedLeds[NUM_LEDS];
+    int preparedCount;          // Pixels rendered, -1 = none
+    int32_t preparedLevel;
+    CRGB preparedColor;
+    
+    bool renderCached(AnimationType type, CRGB* target, int count, const AnimationParams& params);
+    
+    void render(AnimationType type, const AnimationFunction& func, CRGB* target, int count,
+                const AnimationParams& params);
+    CRGB* frontBuffer();
+    CRGB* backBuffer();
+    CRGB* beginMain();
+    void noteRenderKey(uint32_t key);
+    void finishFrame(uint64_t timestamp);
+    void renderSegments(uint64_t timestamp);
+    void loadPrevious(const LedSegment& segment, CRGB* logical);
+    void mapSegment(const LedSegment& segment, const CRGB* logical, CRGB* physical);
+    static bool isIdentity(const LedSegment& segment);
+    static bool isTimeBased(AnimationType type);
+    void compositeLayers(CRGB* leds, int count, uint64_t timestamp);
+    int findCoveringLayer() const;
+    bool isLayerVisible(int layer) const;
 };
 
 // Built-in animation functions
@@ -58,6 +234,7 @@ void anim_timeSelection(CRGB* leds, int numLeds, const AnimationParams& params);
 void anim_gaugeSweep(CRGB* leds, int numLeds, const AnimationParams& params);
 void anim_flashComplete(CRGB* leds, int numLeds, const AnimationParams& params);
 void anim_flashCancelled(CRGB* leds, int numLeds, const AnimationParams& params);
+void anim_paused(CRGB* leds, int numLeds, const AnimationParams& params);
 void anim_off(CRGB* leds, int numLeds, const AnimationParams& params);
 
 #endif
\ No newline at end of file
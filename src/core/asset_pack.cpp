@@ -0,0 +1,210 @@
+#include "asset_pack.h"
+#include "crc.h"
+#include "anim_program.h"
+#include "logger.h"
+#include <string.h>
+
+#ifndef ARDUINO
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+AssetPack::AssetPack()
+    : partition(ASSET_PACK_PARTITION_LABEL), base(nullptr), index(nullptr), size(0), count(0), validPrograms(0)
+#ifndef ARDUINO
+      , file(ASSET_PACK_FILE), mappedSize(0)
+#endif
+{
+}
+
+AssetPack::~AssetPack() {
+    if (base != nullptr) {
+        unmapPack(base);
+    }
+}
+
+bool AssetPack::init() {
+    // A second init() maps the pack afresh; lookups miss until it is valid
+    if (base != nullptr) {
+        unmapPack(base);
+        base = nullptr;
+        count = 0;
+        validPrograms = 0;
+    }
+    
+    uint32_t available = 0;
+    const uint8_t* pack = mapPack(available);
+    if (pack != nullptr && !validate(pack, available)) {
+        unmapPack(pack);
+        pack = nullptr;
+    }
+    if (pack == nullptr) {
+        LOG_WARNING("Asset pack unavailable, using built-in assets");
+        return false;
+    }
+    
+    const AssetPackHeader* header = (const AssetPackHeader*)pack;
+    base = pack;
+    index = (const AssetEntry*)(pack + sizeof(AssetPackHeader));
+    size = header->size;
+    count = header->count;
+    
+    // Programs are checked once here, so a bad one falls back to the built-in
+    validPrograms = 0;
+    for (uint16_t i = 0; i <= (uint16_t)AnimationType::OFF; i++) {
+        uint32_t length = 0;
+        const uint8_t* program = get((AssetId)((uint16_t)AssetId::PROGRAM_COUNTDOWN + i), &length);
+        if (program == nullptr) {
+            continue;
+        }
+        if (length <= ANIM_PROGRAM_MAX_LENGTH * 4 && validateAnimationProgram(program, (uint16_t)length)) {
+            validPrograms |= (uint16_t)(1 << i);
+        } else {
+            LOG_WARNINGF("Asset pack: program %u rejected", (unsigned)i);
+        }
+    }
+    
+    LOG_INFOF("Asset pack r%lu: %u assets, %lu bytes", (unsigned long)header->revision,
+              (unsigned)count, (unsigned long)size);
+    return true;
+}
+
+bool AssetPack::isReady() const {
+    return base != nullptr;
+}
+
+const uint8_t* AssetPack::get(AssetId id, uint32_t* length) const {
+    // Dense index: one bounds check, one entry (validated at mount)
+    uint16_t slot = (uint16_t)id;
+    if (slot >= count || index[slot].length == 0) {
+        return nullptr;
+    }
+    
+    if (length != nullptr) {
+        *length = index[slot].length;
+    }
+    return base + index[slot].offset;
+}
+
+const char* AssetPack::getText(AssetId id, const char* fallback) const {
+    uint32_t length = 0;
+    const uint8_t* data = get(id, &length);
+    // Screens are sized for ASSET_TEXT_MAX; tools/asset_pack.py checks it too
+    if (data == nullptr || length > ASSET_TEXT_MAX || data[length - 1] != '\0') {
+        return fallback;
+    }
+    return (const char*)data;
+}
+
+const uint8_t* AssetPack::getProgram(AnimationType type, uint16_t* length) const {
+    if (!(validPrograms & (1 << (uint16_t)type))) {
+        return nullptr;
+    }
+    
+    uint32_t bytes = 0;
+    const uint8_t* program = get((AssetId)((uint16_t)AssetId::PROGRAM_COUNTDOWN + (uint16_t)type), &bytes);
+    *length = (uint16_t)bytes;
+    return program;
+}
+
+uint32_t AssetPack::getRevision() const {
+    return isReady() ? ((const AssetPackHeader*)base)->revision : 0;
+}
+
+uint32_t AssetPack::getSize() const {
+    return size;
+}
+
+#ifdef ARDUINO
+const uint8_t* AssetPack::mapPack(uint32_t& available) {
+    // The whole partition is mapped once; assets are read through the cache
+    if (!partition.init()) {
+        return nullptr;
+    }
+    available = partition.getSize();
+    return partition.map();
+}
+
+void AssetPack::unmapPack(const uint8_t* pack) {
+    // FlashPartition keeps the one mapping for a later init()
+    (void)pack;
+}
+#else
+void AssetPack::setFile(const char* path) {
+    file = path;
+}
+
+const uint8_t* AssetPack::mapPack(uint32_t& available) {
+    // Same layout from a file, mapped read-only until unmapPack()
+    int fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    
+    struct stat info;
+    void* ptr = MAP_FAILED;
+    if (fstat(fd, &info) == 0 && info.st_size > 0) {
+        ptr = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+    
+    if (ptr == MAP_FAILED) {
+        LOG_ERRORF("Asset pack '%s' mmap failed", file);
+        return nullptr;
+    }
+    
+    available = (uint32_t)info.st_size;
+    mappedSize = available;
+    return (const uint8_t*)ptr;
+}
+
+void AssetPack::unmapPack(const uint8_t* pack) {
+    // The whole file was mapped, whatever the header claims
+    munmap((void*)pack, mappedSize);
+    mappedSize = 0;
+}
+#endif
+
+bool AssetPack::validate(const uint8_t* pack, uint32_t available) {
+    if (available < sizeof(AssetPackHeader)) {
+        return false;
+    }
+    
+    const AssetPackHeader* header = (const AssetPackHeader*)pack;
+    if (header->magic != ASSET_PACK_MAGIC) {
+        LOG_WARNING("Asset pack: no pack in partition");
+        return false;
+    }
+    if (header->version != ASSET_PACK_VERSION) {
+        LOG_WARNINGF("Asset pack: version %u, expected %u", (unsigned)header->version,
+                     (unsigned)ASSET_PACK_VERSION);
+        return false;
+    }
+    
+    uint32_t dataStart = sizeof(AssetPackHeader) + (uint32_t)header->count * sizeof(AssetEntry);
+    if (header->size < dataStart || header->size > available) {
+        LOG_WARNING("Asset pack: bad size");
+        return false;
+    }
+    
+    // Checked once here so lookups can trust the index
+    const AssetEntry* entries = (const AssetEntry*)(pack + sizeof(AssetPackHeader));
+    if (crc16(entries, dataStart - sizeof(AssetPackHeader)) != header->indexCrc ||
+        crc16(pack + dataStart, header->size - dataStart) != header->dataCrc) {
+        LOG_WARNING("Asset pack: CRC mismatch");
+        return false;
+    }
+    
+    for (uint16_t i = 0; i < header->count; i++) {
+        if (entries[i].length != 0 &&
+            (entries[i].offset < dataStart || entries[i].offset > header->size ||
+             entries[i].length > header->size - entries[i].offset)) {
+            LOG_WARNINGF("Asset pack: entry %u out of range", (unsigned)i);
+            return false;
+        }
+    }
+    
+    return true;
+}
@@ -0,0 +1,120 @@
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "config.h"
+#include "types.h"
+#include "flash.h"
+
+// Asset IDs. The pack index is dense and ordered by ID, so a lookup is a
+// bounds check and one array access. tools/asset_pack.py reads this enum
+// to lay out the index: append new IDs, never reorder.
+enum class AssetId : uint16_t {
+    // U8g2 fonts (DisplayFont order)
+    FONT_SMALL,
+    FONT_BODY,
+    FONT_HEADING,
+    FONT_LARGE,
+    
+    // OLED strings (NUL-terminated)
+    TEXT_SET_TIMER,
+    TEXT_ROTATE_TO_ADJUST,
+    TEXT_PRESS_TO_START,
+    TEXT_HOLD_TO_CANCEL,
+    TEXT_PAUSED,
+    TEXT_PRESS_TO_RESUME,
+    TEXT_COMPLETE,
+    TEXT_TIMER_FINISHED,
+    TEXT_CANCELLED,
+    TEXT_TIMER_STOPPED,
+    TEXT_PRESS_ANY_KEY,
+    TEXT_TO_CONTINUE,
+    
+    // Animation bytecode replacing a built-in (AnimationType order)
+    PROGRAM_COUNTDOWN,
+    PROGRAM_PULSE,
+    PROGRAM_COMET,
+    PROGRAM_SOLID_COLOR,
+    PROGRAM_TIME_SELECTION,
+    PROGRAM_GAUGE_SWEEP,
+    PROGRAM_FLASH_COMPLETE,
+    PROGRAM_FLASH_CANCELLED,
+    PROGRAM_PAUSED,
+    PROGRAM_OFF,
+    
+    COUNT
+};
+
+#define ASSET_PACK_MAGIC 0x4B504150UL   // "PAPK"
+#define ASSET_PACK_VERSION 1            // Layout of header and index
+
+// Pack layout (little endian, at the start of the partition):
+//   AssetPackHeader, AssetEntry index[count], asset data
+struct AssetPackHeader {
+    uint32_t magic;
+    uint16_t version;       // Packs of another version are rejected
+    uint16_t count;         // Index entries; IDs past the end are missing
+    uint32_t size;          // Header + index + data
+    uint32_t revision;      // Content revision (logged at mount)
+    uint16_t indexCrc;      // CRC-16 of the index
+    uint16_t dataCrc;       // CRC-16 of everything after the index
+};
+
+struct AssetEntry {
+    uint32_t offset;        // From the start of the pack
+    uint32_t length;        // 0 = asset not in this pack
+};
+
+static_assert(sizeof(AssetPackHeader) == 20, "AssetPackHeader layout is part of the format");
+static_assert(sizeof(AssetEntry) == 8, "AssetEntry layout is part of the format");
+
+// Read-only assets (fonts, strings, animation tables) kept in their own
+// partition so they can be reflashed without the application. The pack is
+// validated once and then read in place through the memory mapping, with
+// no copies. Host builds map ASSET_PACK_FILE instead of the partition.
+// Until init() succeeds every lookup misses and callers use built-ins.
+class AssetPack {
+public:
+    AssetPack();
+    ~AssetPack();
+    
+    // Map and validate the pack
+    bool init();
+    bool isReady() const;
+    
+    // Asset bytes, or nullptr if the pack does not have it
+    const uint8_t* get(AssetId id, uint32_t* length = nullptr) const;
+    
+    // NUL-terminated string asset of at most ASSET_TEXT_MAX bytes, or fallback
+    const char* getText(AssetId id, const char* fallback) const;
+    
+    // Bytecode replacing a built-in animation (validated at mount), or nullptr
+    const uint8_t* getProgram(AnimationType type, uint16_t* length) const;
+    
+    uint32_t getRevision() const;
+    uint32_t getSize() const;
+    
+#ifndef ARDUINO
+    // Host builds: file to map at init() (ASSET_PACK_FILE by default)
+    void setFile(const char* path);
+#endif
+
+private:
+    FlashPartition partition;
+    const uint8_t* base;
+    const AssetEntry* index;
+    uint32_t size;
+    uint16_t count;
+    uint16_t validPrograms;     // Bit per AnimationType whose pack program passed validation
+#ifndef ARDUINO
+    const char* file;
+    uint32_t mappedSize;
+#endif
+    
+    const uint8_t* mapPack(uint32_t& available);
+    void unmapPack(const uint8_t* pack);
+    bool validate(const uint8_t* pack, uint32_t available);
+};
+
+#endif // ASSET_PACK_H
@@ -0,0 +1,59 @@
+#include "boot_profile.h"
+#include "clock.h"
+#include "logger.h"
+
+static const char* const phaseNames[(int)BootPhase::COUNT] = {
+    "setup", "led", "input", "session", "interactive", "assets", "display", "history", "complete"
+};
+
+BootProfile::BootProfile() {
+    for (int i = 0; i < (int)BootPhase::COUNT; i++) {
+        marks[i] = 0;
+    }
+}
+
+void BootProfile::mark(BootPhase phase) {
+    // Never 0, so a phase reached in the first microsecond still counts
+    uint64_t now = Clock::nowMicros();
+    marks[(int)phase] = (now != 0) ? now : 1;
+}
+
+bool BootProfile::isReached(BootPhase phase) const {
+    return marks[(int)phase] != 0;
+}
+
+uint64_t BootProfile::getMicros(BootPhase phase) const {
+    return marks[(int)phase];
+}
+
+uint32_t BootProfile::getTimeToInteractiveMicros() const {
+    if (!isReached(BootPhase::SETUP) || !isReached(BootPhase::INTERACTIVE)) {
+        return 0;
+    }
+    return (uint32_t)(marks[(int)BootPhase::INTERACTIVE] - marks[(int)BootPhase::SETUP]);
+}
+
+bool BootProfile::isOverBudget() const {
+    return getTimeToInteractiveMicros() > MS_TO_US(BOOT_INTERACTIVE_BUDGET_MS);
+}
+
+void BootProfile::log() const {
+    // One line per phase: time since reset and since the previous phase
+    uint64_t previous = 0;
+    for (int i = 0; i < (int)BootPhase::COUNT; i++) {
+        if (marks[i] == 0) {
+            continue;
+        }
+        LOG_INFOF("Boot %-11s %7lu us (+%lu us)", phaseNames[i],
+                  (unsigned long)marks[i], (unsigned long)(marks[i] - previous));
+        previous = marks[i];
+    }
+    
+    uint32_t interactive = getTimeToInteractiveMicros();
+    if (isOverBudget()) {
+        LOG_WARNINGF("Boot: interactive after %lu us, budget %lu ms",
+                     (unsigned long)interactive, (unsigned long)BOOT_INTERACTIVE_BUDGET_MS);
+    } else {
+        LOG_INFOF("Boot: interactive after %lu us", (unsigned long)interactive);
+    }
+}
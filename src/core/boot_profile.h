@@ -0,0 +1,42 @@
+#ifndef BOOT_PROFILE_H
+#define BOOT_PROFILE_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Boot milestones in the order they are reached. Everything up to
+// INTERACTIVE runs in setup() or the first loop pass; the rest is
+// deferred to later loop passes.
+enum class BootPhase : uint8_t {
+    SETUP,          // setup() entered
+    LED_OUTPUT,     // LED driver up, blank frame out
+    INPUT,          // Encoder and button armed
+    SESSION,        // Session log mounted and the first state entered
+    INTERACTIVE,    // First loop pass done: first frame shown, inputs polled
+    ASSETS,         // Asset pack mapped and validated (or built-ins in use)
+    DISPLAY,        // OLED up, current screen on the panel
+    HISTORY,        // Session history index rebuilt
+    COMPLETE,
+    COUNT
+};
+
+// Timestamps (Clock::nowMicros(), i.e. since reset) of each boot phase
+class BootProfile {
+public:
+    BootProfile();
+    
+    void mark(BootPhase phase);
+    bool isReached(BootPhase phase) const;
+    uint64_t getMicros(BootPhase phase) const;   // 0 until reached
+    
+    // setup() -> INTERACTIVE (0 until reached)
+    uint32_t getTimeToInteractiveMicros() const;
+    bool isOverBudget() const;
+    
+    void log() const;
+
+private:
+    uint64_t marks[(int)BootPhase::COUNT];
+};
+
+#endif // BOOT_PROFILE_H
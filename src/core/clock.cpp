@@ -0,0 +1,31 @@
+#include "clock.h"
+
+#ifdef ARDUINO
+#include <esp_timer.h>
+#else
+#include <chrono>
+#endif
+
+ClockSource Clock::source = nullptr;
+
+static uint64_t defaultSource() {
+#ifdef ARDUINO
+    return (uint64_t)esp_timer_get_time();
+#else
+    using namespace std::chrono;
+    return (uint64_t)duration_cast<microseconds>(
+        steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint64_t Clock::nowMicros() {
+    return (source != nullptr) ? source() : defaultSource();
+}
+
+uint32_t Clock::nowMillis() {
+    return (uint32_t)US_TO_MS(nowMicros());
+}
+
+void Clock::setSource(const ClockSource& newSource) {
+    source = newSource;
+}
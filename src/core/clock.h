@@ -0,0 +1,37 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+#include "delegate.h"
+
+// Monotonic time source returning microseconds
+typedef Delegate<uint64_t()> ClockSource;
+
+// 64-bit microsecond monotonic clock.
+// Backed by esp_timer on target and std::chrono::steady_clock on host, so
+// it never wraps in practice (2^64 us is ~584,000 years). All durations are
+// computed with unsigned subtraction, which stays correct even if an
+// injected source is started just below the wrap point.
+class Clock {
+public:
+    static uint64_t nowMicros();
+    static uint32_t nowMillis();
+    
+    // Replace the time source (e.g. a virtual clock); nullptr restores default
+    static void setSource(const ClockSource& source);
+    
+    static uint64_t elapsedSince(uint64_t startUs) {
+        return nowMicros() - startUs;
+    }
+
+private:
+    static ClockSource source;
+};
+
+// Unit conversion helpers
+#define US_PER_MS 1000ULL
+#define US_PER_SEC 1000000ULL
+#define MS_TO_US(ms) ((uint64_t)(ms) * US_PER_MS)
+#define US_TO_MS(us) ((uint64_t)(us) / US_PER_MS)
+
+#endif
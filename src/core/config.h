@@ -2,9 +2,12 @@
 #define CONFIG_H
 
 // Hardware Configuration
-#define NUM_LEDS 12
+#ifndef NUM_LEDS
+#define NUM_LEDS 12                       // Pixels per strip; sizes every LED frame (build_flags may override)
+#endif
 #define LED_PIN D7
 #define LED_BRIGHTNESS 50
+#define LED_OUTPUT_RMT 0                  // 1: async RMT driver, 0: blocking FastLED.show()
 
 // Rotary Encoder Configuration
 #define ENCODER_SW_PIN D2
@@ -12,28 +15,80 @@
 #define ENCODER_CLK_PIN D0
 #define ENCODER_DEBOUNCE_MS 50
 #define ENCODER_LONG_PRESS_MS 3000    // 3 seconds for long press
+#define MAX_INPUT_ENCODERS 2              // Encoders the input scanner can decode
+#define MAX_INPUT_BUTTONS 6               // Buttons the input scanner can debounce
+#define INPUT_EVENT_QUEUE 16              // Input events buffered between loop passes
+#define INPUT_SAMPLE_RING 64              // Pin samples latched by the ISR between loop passes (power of two, <= 128)
 
 // OLED Display Configuration
 #define OLED_SDA_PIN D4
 #define OLED_SCL_PIN D5
 #define OLED_WIDTH 128
 #define OLED_HEIGHT 64
+#ifndef OLED_PAGE_BUFFER
+#define OLED_PAGE_BUFFER 2                // 0: 1 KB framebuffer, 1/2: U8g2 page mode with 1/2 pages (128/256 bytes)
+#endif
+#define DRAW_LIST_OPS 12                  // Draw calls per OLED screen
+#define DRAW_LIST_TEXT 104                // Text bytes per OLED screen (four pack texts and a time)
 
 // Timing Configuration (in milliseconds)
 #define POMODORO_WORK_DURATION 1500000    // 25 minutes
 #define POMODORO_SHORT_BREAK 300000       // 5 minutes
 #define POMODORO_LONG_BREAK 900000        // 15 minutes
+#define POMODORO_LONG_BREAK_INTERVAL 4    // Long break after every 4th work session
 #define ANIMATION_INTERVAL 16
+#define MAX_ANIMATION_LAYERS 4            // Overlay layers composited over the base animation
+#ifndef ANIM_FRAME_CACHE
+#define ANIM_FRAME_CACHE 0                // 1: periodic animations play from a baked table (time snapped to its step)
+#endif
+#define ANIM_FRAME_CACHE_BYTES 256        // RAM cap for the periodic animation frame cache
+#define LED_CROSSFADE_MS 250              // LED crossfade between application states
+#define MAX_LED_SEGMENTS 4                // Named pixel ranges (segment 0 is the main ring)
+#define MAX_LED_OUTPUTS 2                 // Physical outputs fed from one frame
+#define ANIMATION_BYTECODE 0              // 1: built-ins run as bytecode (native anim_* dropped by the linker)
 
 // Debug Configuration
 #define SERIAL_BAUD_RATE 115200
+#define SERIAL_WAIT_MS 0                  // Boot waits this long for a serial monitor (0: never)
 #define DEBUG_ENABLED true
+#define LOG_LINE_MAX 128                  // Formatted log line buffer (on the caller's stack)
+#define FRAME_CAPTURE_ENABLED false       // Stream LED frames (binary, between log lines)
+#define CAPTURE_KEYFRAME_INTERVAL 60      // Frames between capture keyframes
+#define CONTROL_ENABLED true              // Binary remote control requests on the log UART
+#define CONTROL_MAX_BODY 32               // Largest control request/reply body
+#define CONTROL_RX_BUDGET 64              // Serial bytes parsed per loop pass
+#define INPUT_TRACE_ENABLED false         // Record encoder edges and log input->LED/OLED latency
+#define INPUT_TRACE_CAPACITY 256          // Edges recorded before the trace is dumped
+#define LATENCY_SAMPLES 64                // Latency samples per output kept for percentiles
+#define LATENCY_REPORT_INTERVAL_MS 10000  // Period of the latency log line
+#define BOOT_INTERACTIVE_BUDGET_MS 50     // setup() -> first frame with inputs armed; warns when exceeded
 
 // Timer Selection Configuration
 #define MAX_TIMER_MINUTES 60              // Maximum timer setting (60 minutes = 1 hour)
 #define TIMER_STEP_MINUTES 5              // Step size for timer adjustment (5 minutes per step)
-#define ENCODER_STEPS_PER_INCREMENT 3     // Number of encoder steps needed for one timer increment
+#define ENCODER_STEPS_PER_INCREMENT 3     // Detents per timer increment when turning slowly
+#define ENCODER_STEPS_PER_DETENT 4        // Quadrature steps per mechanical detent
+#define ENCODER_ACCEL_SLOW_MS 120         // Detents this far apart or more are not accelerated
+#define ENCODER_ACCEL_FAST_MS 20          // Detents this close reach the full acceleration
+#define ENCODER_ACCEL_MAX 3               // Timer increments per detent at full acceleration
 #define FLASH_ANIMATION_CYCLES 3          // Number of flash cycles at completion
+#define PAUSED_LED_INTERVAL_MS 100        // LED refresh period while paused (slow breathing only)
+
+// Session Persistence Configuration
+#define SESSION_PARTITION_LABEL "session"
+#define SESSION_PERSIST_INTERVAL_MS 30000 // Checkpoint period while running (bounds flash wear)
+#define SESSION_MIN_SAVE_INTERVAL_MS 5000 // Pause/resume saves closer than this are coalesced into one record
+
+// Session History Configuration
+#define HISTORY_PARTITION_LABEL "history"
+#define HISTORY_DAYS 7                    // Daily totals kept in the summary index
+#define HISTORY_PENDING 4                 // Sessions recorded before the log is mounted
+
+// Asset Pack Configuration
+#define ASSET_PACK_PARTITION_LABEL "assets"
+#define ASSET_PACK_FILE "assets.bin"      // Host builds map this file instead of the partition
+#define ASSET_PACK_FONTS 0                // 1: ncenB fonts come from the pack only (6x10 stays built in)
+#define ASSET_TEXT_MAX 22                 // Pack text bytes with NUL (21 columns of the 6x10 font)
 
 // Default test duration (for development)
 #define TEST_COUNTDOWN_DURATION 30000     // 30 seconds
@@ -0,0 +1,154 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "control_link.h"
+#include "crc.h"
+#include <string.h>
+
+static void serialWriter(const uint8_t* data, size_t length) {
+#ifdef ARDUINO
+    Serial.write(data, length);
+#else
+    (void)data;
+    (void)length;
+#endif
+}
+
+ControlLink::ControlLink()
+    : handler(nullptr), writer(ControlWriter::bind<serialWriter>()), state(WAIT_SYNC), received(0), bodyLength(0),
+      requestCount(0), errorCount(0) {
+}
+
+void ControlLink::setHandler(const ControlHandler& newHandler) {
+    handler = newHandler;
+}
+
+void ControlLink::setWriter(const ControlWriter& newWriter) {
+    writer = (newWriter != nullptr) ? newWriter : ControlWriter::bind<serialWriter>();
+}
+
+void ControlLink::update() {
+#ifdef ARDUINO
+    // Bounded per pass so a flood of input cannot stall the frame
+    uint8_t chunk[CONTROL_RX_BUDGET];
+    size_t count = 0;
+    while (count < sizeof(chunk) && Serial.available() > 0) {
+        chunk[count++] = (uint8_t)Serial.read();
+    }
+    feed(chunk, count);
+#endif
+}
+
+void ControlLink::feed(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        parse(data[i]);
+    }
+}
+
+void ControlLink::parse(uint8_t byte) {
+    switch (state) {
+        case WAIT_SYNC:
+            // Anything between packets (typed text, line noise) is ignored
+            if (byte == CAPTURE_SYNC) {
+                packet[0] = byte;
+                received = 1;
+                state = READ_HEADER;
+            }
+            return;
+            
+        case READ_HEADER:
+            packet[received++] = byte;
+            if (received < CAPTURE_HEADER_BYTES) {
+                return;
+            }
+            bodyLength = packet[2] | (packet[3] << 8);
+            if (packet[1] != CONTROL_REQUEST || bodyLength < 2 || bodyLength > CONTROL_MAX_BODY) {
+                errorCount++;
+                resync();
+                return;
+            }
+            state = READ_BODY;
+            return;
+            
+        case READ_BODY:
+            packet[received++] = byte;
+            if (received == CAPTURE_HEADER_BYTES + bodyLength) {
+                state = READ_CRC;
+            }
+            return;
+            
+        case READ_CRC:
+            packet[received++] = byte;
+            if (crc8(packet + 1, 3 + bodyLength) != byte) {
+                errorCount++; // Dropped; the host retries on timeout
+                resync();
+                return;
+            }
+            state = WAIT_SYNC;
+            dispatch();
+            return;
+    }
+}
+
+void ControlLink::resync() {
+    // A request may start inside the rejected bytes (a truncated packet
+    // swallows the next one as its body): parse them again from the byte
+    // after the failed sync. Writes into packet never pass the read position.
+    uint16_t length = received;
+    state = WAIT_SYNC;
+    received = 0;
+    for (uint16_t i = 1; i < length; i++) {
+        parse(packet[i]);
+    }
+}
+
+void ControlLink::dispatch() {
+    const uint8_t* body = packet + CAPTURE_HEADER_BYTES;
+    
+    ControlRequest request;
+    request.sequence = body[0];
+    request.command = body[1];
+    request.args = body + 2;
+    request.length = (uint8_t)(bodyLength - 2);
+    
+    ControlReply reply;
+    reply.status = ControlStatus::UNKNOWN_COMMAND;
+    reply.length = 0;
+    if (handler != nullptr) {
+        reply.status = ControlStatus::OK;
+        handler(request, reply);
+    }
+    requestCount++;
+    
+    uint8_t replyBody[CONTROL_MAX_BODY];
+    replyBody[0] = request.sequence;
+    replyBody[1] = request.command;
+    replyBody[2] = (uint8_t)reply.status;
+    memcpy(replyBody + 3, reply.payload, reply.length);
+    
+    uint8_t out[CONTROL_PACKET_MAX];
+    size_t length = encode(CONTROL_REPLY, replyBody, 3 + reply.length, out);
+    writer(out, length);
+}
+
+size_t ControlLink::encode(uint8_t kind, const uint8_t* body, size_t length, uint8_t* out) {
+    if (length > CONTROL_MAX_BODY) {
+        return 0;
+    }
+    
+    out[0] = CAPTURE_SYNC;
+    out[1] = kind;
+    out[2] = (uint8_t)length;
+    out[3] = (uint8_t)(length >> 8);
+    memcpy(out + CAPTURE_HEADER_BYTES, body, length);
+    out[CAPTURE_HEADER_BYTES + length] = crc8(out + 1, 3 + length);
+    return CAPTURE_HEADER_BYTES + length + 1;
+}
+
+uint32_t ControlLink::getRequestCount() const {
+    return requestCount;
+}
+
+uint32_t ControlLink::getErrorCount() const {
+    return errorCount;
+}
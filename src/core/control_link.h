@@ -0,0 +1,111 @@
+#ifndef CONTROL_LINK_H
+#define CONTROL_LINK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+#include "frame_capture.h"
+#include "delegate.h"
+
+// Remote control over the log UART. Packets use the capture layout
+// (frame_capture.h), so one host decoder splits log text, frames and
+// replies:
+//   0x00 sync | kind | u16 body length | body | crc8(kind .. body)
+// REQUEST body: u8 sequence | u8 command | arguments
+// REPLY body:   u8 sequence | u8 command | u8 status | payload
+#define CONTROL_REQUEST 0x10
+#define CONTROL_REPLY 0x11
+#define CONTROL_PACKET_MAX (CAPTURE_HEADER_BYTES + CONTROL_MAX_BODY + 1)
+
+enum ControlCommand : uint8_t {
+    CONTROL_PING,           // No arguments
+    CONTROL_STATUS,         // No arguments
+    CONTROL_START,          // u16 minutes
+    CONTROL_START_CYCLE,    // No arguments
+    CONTROL_PAUSE,
+    CONTROL_RESUME,
+    CONTROL_STOP,
+    CONTROL_SET_TIME        // u32 Unix seconds (the board has no RTC)
+};
+
+enum class ControlStatus : uint8_t {
+    OK,
+    REJECTED,           // Not possible in the current state
+    BAD_REQUEST,        // Wrong argument length or value
+    UNKNOWN_COMMAND,
+    FAILED              // The timer returned an error
+};
+
+struct ControlRequest {
+    uint8_t sequence;
+    uint8_t command;
+    const uint8_t* args;
+    uint8_t length;
+};
+
+// Filled in by the handler; payload is little endian
+struct ControlReply {
+    ControlStatus status;
+    uint8_t payload[CONTROL_MAX_BODY - 3];
+    uint8_t length;
+    
+    void put8(uint8_t value) {
+        if (length < sizeof(payload)) payload[length++] = value;
+    }
+    void put16(uint16_t value) {
+        put8((uint8_t)value);
+        put8((uint8_t)(value >> 8));
+    }
+    void put32(uint32_t value) {
+        put16((uint16_t)value);
+        put16((uint16_t)(value >> 16));
+    }
+};
+
+typedef Delegate<void(const ControlRequest& request, ControlReply& reply)> ControlHandler;
+typedef Delegate<void(const uint8_t* data, size_t length)> ControlWriter;
+
+// Incremental request parser and reply sender. update() drains at most
+// CONTROL_RX_BUDGET bytes per call, never blocks and uses no heap.
+class ControlLink {
+public:
+    ControlLink();
+    
+    void setHandler(const ControlHandler& handler);
+    void setWriter(const ControlWriter& writer);     // Serial by default
+    
+    // Read pending bytes from Serial (call in main loop)
+    void update();
+    
+    // Parse bytes from any source; complete requests are handled at once
+    void feed(const uint8_t* data, size_t length);
+    
+    // Build one packet; returns its length (0 if the body is too long)
+    static size_t encode(uint8_t kind, const uint8_t* body, size_t length, uint8_t* out);
+    
+    uint32_t getRequestCount() const;
+    uint32_t getErrorCount() const;
+
+private:
+    enum ParseState : uint8_t {
+        WAIT_SYNC,
+        READ_HEADER,
+        READ_BODY,
+        READ_CRC
+    };
+    
+    ControlHandler handler;
+    ControlWriter writer;
+    ParseState state;
+    uint16_t received;          // Bytes of the current packet, sync included
+    uint16_t bodyLength;
+    uint8_t packet[CONTROL_PACKET_MAX];
+    uint32_t requestCount;
+    uint32_t errorCount;
+    
+    void parse(uint8_t byte);
+    void resync();
+    void dispatch();
+};
+
+#endif // CONTROL_LINK_H
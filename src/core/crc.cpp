@@ -0,0 +1,31 @@
+#include "crc.h"
+
+uint16_t crc16(const void* data, size_t length) {
+    // CRC-16/CCITT-FALSE, bitwise (records are small)
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint16_t crc = 0xFFFF;
+    
+    for (size_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)bytes[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    
+    return crc;
+}
+
+uint8_t crc8(const void* data, size_t length) {
+    // CRC-8 (poly 0x07), bitwise
+    const uint8_t* bytes = (const uint8_t*)data;
+    uint8_t crc = 0;
+    
+    for (size_t i = 0; i < length; i++) {
+        crc ^= bytes[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    
+    return crc;
+}
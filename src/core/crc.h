@@ -0,0 +1,12 @@
+#ifndef CRC_H
+#define CRC_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Checksums shared by flash records, the asset pack and the serial packets
+// (tools/*.py carry matching implementations)
+uint16_t crc16(const void* data, size_t length);    // CRC-16/CCITT-FALSE
+uint8_t crc8(const void* data, size_t length);      // Polynomial 0x07, init 0
+
+#endif // CRC_H
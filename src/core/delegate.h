@@ -0,0 +1,130 @@
+#ifndef DELEGATE_H
+#define DELEGATE_H
+
+#include <stddef.h>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+// Fixed-size callable for callback APIs: a function pointer, a bound
+// member function or a small lambda, stored inline (never on the heap).
+//
+//     Delegate<void()> done = onDone;                          // free function
+//     Delegate<void()> done = Delegate<void()>::bind<onDone>();  // same, one hop
+//     Delegate<void()> done = Delegate<void()>::bind<Player, &Player::stop>(&player);
+//     Delegate<void(int)> log = [this](int value) { total += value; };
+//
+// A delegate is an invoker pointer plus Capacity bytes of captured state
+// (two pointers by default), so it copies like a struct and calling it is
+// one indirect call into a thunk with the target inlined. Only a function
+// pointer held at run time takes a second hop; bind<function>() avoids it.
+// Callables must be trivially copyable (captures of pointers and plain
+// values) and fit the capacity; both are checked at compile time.
+template <typename Signature, size_t Capacity = 2 * sizeof(void*)>
+class Delegate;
+
+template <typename R, typename... Args, size_t Capacity>
+class Delegate<R(Args...), Capacity> {
+public:
+    typedef R (*Function)(Args...);
+    
+    constexpr Delegate() : invoker(nullptr), storage() {}
+    constexpr Delegate(std::nullptr_t) : invoker(nullptr), storage() {}
+    
+    // Function pointer chosen at run time (nullptr gives an empty delegate)
+    Delegate(Function function) : invoker(nullptr) {
+        if (function != nullptr) {
+            store(function);
+            invoker = &callPointer;
+        }
+    }
+    
+    // Lambda or function object, copied into the inline storage
+    template <typename F, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<F>::type, Delegate>::value &&
+        !std::is_convertible<F, Function>::value>::type>
+    Delegate(const F& callable) : invoker(&callObject<F>) {
+        store(callable);
+    }
+    
+    // Lambdas without captures convert to a plain function pointer; keep
+    // them as objects so the call is inlined into the thunk
+    template <typename F, typename = typename std::enable_if<
+        std::is_convertible<F, Function>::value && std::is_class<F>::value>::type, typename = void>
+    Delegate(const F& callable) : invoker(&callObject<F>) {
+        store(callable);
+    }
+    
+    // Function fixed at compile time: no state, a single hop
+    template <R (*Target)(Args...)>
+    static Delegate bind() {
+        Delegate delegate;
+        delegate.invoker = &callStatic<Target>;
+        return delegate;
+    }
+    
+    // Member function on an object that outlives the delegate
+    template <typename T, R (T::*Method)(Args...)>
+    static Delegate bind(T* object) {
+        Delegate delegate;
+        delegate.store(object);
+        delegate.invoker = &callMember<T, Method>;
+        return delegate;
+    }
+    
+    template <typename T, R (T::*Method)(Args...) const>
+    static Delegate bind(const T* object) {
+        Delegate delegate;
+        delegate.store(object);
+        delegate.invoker = &callConstMember<T, Method>;
+        return delegate;
+    }
+    
+    R operator()(Args... args) const {
+        return invoker(&storage, std::forward<Args>(args)...);
+    }
+    
+    explicit operator bool() const { return invoker != nullptr; }
+    bool operator==(std::nullptr_t) const { return invoker == nullptr; }
+    bool operator!=(std::nullptr_t) const { return invoker != nullptr; }
+
+private:
+    typedef R (*Invoker)(const void* storage, Args... args);
+    
+    Invoker invoker;
+    typename std::aligned_storage<Capacity, alignof(void*)>::type storage;
+    
+    template <typename T>
+    void store(const T& value) {
+        static_assert(sizeof(T) <= Capacity, "callable does not fit the delegate's inline storage");
+        static_assert(alignof(T) <= alignof(void*), "callable is over-aligned for the delegate");
+        static_assert(std::is_trivially_copyable<T>::value, "delegate callables must be trivially copyable");
+        new (&storage) T(value);
+    }
+    
+    static R callPointer(const void* state, Args... args) {
+        return (*static_cast<const Function*>(state))(std::forward<Args>(args)...);
+    }
+    
+    template <typename F>
+    static R callObject(const void* state, Args... args) {
+        return (*static_cast<const F*>(state))(std::forward<Args>(args)...);
+    }
+    
+    template <R (*Target)(Args...)>
+    static R callStatic(const void*, Args... args) {
+        return Target(std::forward<Args>(args)...);
+    }
+    
+    template <typename T, R (T::*Method)(Args...)>
+    static R callMember(const void* state, Args... args) {
+        return ((*static_cast<T* const*>(state))->*Method)(std::forward<Args>(args)...);
+    }
+    
+    template <typename T, R (T::*Method)(Args...) const>
+    static R callConstMember(const void* state, Args... args) {
+        return ((*static_cast<const T* const*>(state))->*Method)(std::forward<Args>(args)...);
+    }
+};
+
+#endif // DELEGATE_H
@@ -1,144 +1,342 @@
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include "display.h"
 #include "logger.h"
+#include "clock.h"
+#include <stdio.h>
+#include <string.h>
 
-OLEDDisplay::OLEDDisplay() : display(U8G2_R0, /* reset=*/ U8X8_PIN_NONE) {
+// Every screen draws at most four pack texts and a time
+static_assert(4 * ASSET_TEXT_MAX + TIME_TEXT_MAX <= DRAW_LIST_TEXT, "DRAW_LIST_TEXT too small for a screen");
+
+static const char* const screenNames[] = { "blank", "time selection", "countdown", "paused", "complete", "cancelled" };
+static_assert(sizeof(screenNames) / sizeof(screenNames[0]) == (int)OLEDScreen::COUNT, "screenNames out of step");
+
+// What a screen shows that an input can change: the selected time, the
+// length of a started countdown, the time frozen by a pause. The running
+// countdown's per-second redraw keeps the same key.
+static uint32_t contentKey(OLEDScreen id, int inputValue) {
+    return ((uint32_t)id << 24) ^ (uint32_t)inputValue;
+}
+
+OLEDDisplay::OLEDDisplay()
+    : display(U8G2_R0, /* reset=*/ U8X8_PIN_NONE), screenId(OLEDScreen::BLANK), screenKey(0), flushedKey(UINT32_MAX),
+      ready(false), screenRendered(false),
+      renderMicros(0), countdownTitle("COUNTDOWN"), countdownRemaining(-1), countdownTotal(-1), preparedRemaining(-1),
+      preparedTotal(-1), preparedRendered(false), preparedRenderMicros(0), latency(nullptr), lastFlushMicros(0),
+      assets(nullptr) {
+    memset(timings, 0, sizeof(timings));
 }
 
 void OLEDDisplay::init() {
     // Initialize I2C with custom pins
     Wire.begin(OLED_SDA_PIN, OLED_SCL_PIN);
     
-    // Initialize display
+    // Initialize display (begin() clears the framebuffer)
     display.begin();
-    display.clearBuffer();
-    display.setFont(u8g2_font_ncenB08_tr);
+    ready = true;
     
-    // Show startup message
-    display.drawStr(0, 15, "Pomodoro Timer");
-    display.drawStr(0, 30, "Ready...");
-    display.sendBuffer();
+    // Screens drawn before init() only built their draw list: put the
+    // current one straight on the panel instead of a splash
+    screenRendered = false;
+    if (!screen.isEmpty()) {
+        flush();
+    }
     
     LOG_INFO("OLED display initialized");
 }
 
+bool OLEDDisplay::isReady() const {
+    return ready;
+}
+
 void OLEDDisplay::showTimeSelection(int seconds) {
-    display.clearBuffer();
+    invalidateCountdown();
+    beginScreen(OLEDScreen::TIME_SELECTION, seconds);
     
     // Title
-    display.setFont(u8g2_font_ncenB08_tr);
-    drawCenteredText("SET TIMER", 15);
+    screen.setFont(DisplayFont::BODY);
+    screen.drawCenteredStr(text(AssetId::TEXT_SET_TIMER, "SET TIMER"), 15);
     
     // Time display
-    display.setFont(u8g2_font_ncenB18_tr);
-    String timeStr = formatTime(seconds);
-    drawCenteredText(timeStr.c_str(), 40);
+    screen.setFont(DisplayFont::LARGE);
+    char timeStr[TIME_TEXT_MAX];
+    formatTime(seconds, timeStr, sizeof(timeStr));
+    screen.drawCenteredStr(timeStr, 40);
     
     // Instructions
-    display.setFont(u8g2_font_6x10_tr);
-    drawCenteredText("Rotate to adjust", 55);
-    drawCenteredText("Press to start", 64);
+    screen.setFont(DisplayFont::SMALL);
+    screen.drawCenteredStr(text(AssetId::TEXT_ROTATE_TO_ADJUST, "Rotate to adjust"), 55);
+    screen.drawCenteredStr(text(AssetId::TEXT_PRESS_TO_START, "Press to start"), 64);
     
-    display.sendBuffer();
+    flush();
 }
 
 void OLEDDisplay::showCountdown(int remainingSeconds, int totalSeconds) {
-    display.clearBuffer();
+    if (remainingSeconds == countdownRemaining && totalSeconds == countdownTotal) {
+        return; // Same frame is already on the panel
+    }
+    
+    // Swap in a frame prepared ahead of time, otherwise draw it now
+    if (remainingSeconds == preparedRemaining && totalSeconds == preparedTotal) {
+        screen = prepared;
+        screenId = OLEDScreen::COUNTDOWN;
+        screenKey = contentKey(OLEDScreen::COUNTDOWN, totalSeconds);
+        screenRendered = preparedRendered;
+        renderMicros = preparedRenderMicros;
+        dropPrepared();
+    } else {
+        beginScreen(OLEDScreen::COUNTDOWN, totalSeconds);
+        drawCountdown(screen, remainingSeconds, totalSeconds);
+    }
     
+    flush();
+    countdownRemaining = remainingSeconds;
+    countdownTotal = totalSeconds;
+}
+
+void OLEDDisplay::prepareCountdown(int remainingSeconds, int totalSeconds) {
+    // Built in its own list: the current screen stays as it is for any
+    // flush (every page replays it) until showCountdown() swaps this in
+    prepared.clear();
+    drawCountdown(prepared, remainingSeconds, totalSeconds);
+    preparedRemaining = remainingSeconds;
+    preparedTotal = totalSeconds;
+    preparedRendered = false;
+    
+#if !OLED_PAGE_BUFFER
+    // Rasterise it ahead as well; the current screen is re-rendered if it
+    // is flushed again first
+    if (ready) {
+        uint64_t start = Clock::nowMicros();
+        display.clearBuffer();
+        prepared.replay(display, assets);
+        preparedRenderMicros = (uint32_t)Clock::elapsedSince(start);
+        preparedRendered = true;
+        screenRendered = false;
+    }
+#endif
+}
+
+void OLEDDisplay::setCountdownTitle(const char* title) {
+    if (title != countdownTitle) {
+        countdownTitle = title;
+        invalidateCountdown();
+        dropPrepared();
+    }
+}
+
+void OLEDDisplay::drawCountdown(DrawList& list, int remainingSeconds, int totalSeconds) {
     // Title
-    display.setFont(u8g2_font_ncenB08_tr);
-    drawCenteredText("COUNTDOWN", 15);
+    list.setFont(DisplayFont::BODY);
+    list.drawCenteredStr(countdownTitle, 15);
     
     // Time display
-    display.setFont(u8g2_font_ncenB18_tr);
-    String timeStr = formatTime(remainingSeconds);
-    drawCenteredText(timeStr.c_str(), 35);
+    list.setFont(DisplayFont::LARGE);
+    char timeStr[TIME_TEXT_MAX];
+    formatTime(remainingSeconds, timeStr, sizeof(timeStr));
+    list.drawCenteredStr(timeStr, 35);
     
     // Progress bar
-    drawProgressBar(totalSeconds - remainingSeconds, totalSeconds, 10, 45, 108, 8);
+    drawProgressBar(list, totalSeconds - remainingSeconds, totalSeconds, 10, 45, 108, 8);
     
     // Instructions
-    display.setFont(u8g2_font_6x10_tr);
-    drawCenteredText("Hold 3s to cancel", 64);
+    list.setFont(DisplayFont::SMALL);
+    list.drawCenteredStr(text(AssetId::TEXT_HOLD_TO_CANCEL, "Hold 3s to cancel"), 64);
+}
+
+void OLEDDisplay::invalidateCountdown() {
+    countdownRemaining = -1;
+    countdownTotal = -1;
+}
+
+void OLEDDisplay::dropPrepared() {
+    preparedRemaining = -1;
+    preparedTotal = -1;
+    preparedRendered = false;
+}
+
+void OLEDDisplay::showPaused(int remainingSeconds, int totalSeconds) {
+    invalidateCountdown();
+    beginScreen(OLEDScreen::PAUSED, remainingSeconds);
     
-    display.sendBuffer();
+    // Title
+    screen.setFont(DisplayFont::BODY);
+    screen.drawCenteredStr(text(AssetId::TEXT_PAUSED, "PAUSED"), 15);
+    
+    // Frozen time display
+    screen.setFont(DisplayFont::LARGE);
+    char timeStr[TIME_TEXT_MAX];
+    formatTime(remainingSeconds, timeStr, sizeof(timeStr));
+    screen.drawCenteredStr(timeStr, 35);
+    
+    // Outlined progress bar to set it apart from the running view
+    screen.drawFrame(10, 45, 108, 8);
+    if (totalSeconds > 0) {
+        int markX = 10 + ((totalSeconds - remainingSeconds) * 106) / totalSeconds;
+        screen.drawBox(markX, 43, 2, 12);
+    }
+    
+    // Instructions
+    screen.setFont(DisplayFont::SMALL);
+    screen.drawCenteredStr(text(AssetId::TEXT_PRESS_TO_RESUME, "Press to resume"), 64);
+    
+    flush();
 }
 
 void OLEDDisplay::showComplete() {
-    display.clearBuffer();
+    invalidateCountdown();
+    beginScreen(OLEDScreen::COMPLETE);
     
     // Title
-    display.setFont(u8g2_font_ncenB12_tr);
-    drawCenteredText("COMPLETE!", 25);
+    screen.setFont(DisplayFont::HEADING);
+    screen.drawCenteredStr(text(AssetId::TEXT_COMPLETE, "COMPLETE!"), 25);
     
     // Message
-    display.setFont(u8g2_font_ncenB08_tr);
-    drawCenteredText("Timer finished", 40);
+    screen.setFont(DisplayFont::BODY);
+    screen.drawCenteredStr(text(AssetId::TEXT_TIMER_FINISHED, "Timer finished"), 40);
     
     // Instructions
-    display.setFont(u8g2_font_6x10_tr);
-    drawCenteredText("Press any key", 55);
-    drawCenteredText("to continue", 64);
+    screen.setFont(DisplayFont::SMALL);
+    screen.drawCenteredStr(text(AssetId::TEXT_PRESS_ANY_KEY, "Press any key"), 55);
+    screen.drawCenteredStr(text(AssetId::TEXT_TO_CONTINUE, "to continue"), 64);
     
-    display.sendBuffer();
+    flush();
 }
 
 void OLEDDisplay::showCancelled() {
-    display.clearBuffer();
+    invalidateCountdown();
+    beginScreen(OLEDScreen::CANCELLED);
     
     // Title
-    display.setFont(u8g2_font_ncenB12_tr);
-    drawCenteredText("CANCELLED", 25);
+    screen.setFont(DisplayFont::HEADING);
+    screen.drawCenteredStr(text(AssetId::TEXT_CANCELLED, "CANCELLED"), 25);
     
     // Message
-    display.setFont(u8g2_font_ncenB08_tr);
-    drawCenteredText("Timer stopped", 40);
+    screen.setFont(DisplayFont::BODY);
+    screen.drawCenteredStr(text(AssetId::TEXT_TIMER_STOPPED, "Timer stopped"), 40);
     
     // Instructions
-    display.setFont(u8g2_font_6x10_tr);
-    drawCenteredText("Press any key", 55);
-    drawCenteredText("to continue", 64);
+    screen.setFont(DisplayFont::SMALL);
+    screen.drawCenteredStr(text(AssetId::TEXT_PRESS_ANY_KEY, "Press any key"), 55);
+    screen.drawCenteredStr(text(AssetId::TEXT_TO_CONTINUE, "to continue"), 64);
     
-    display.sendBuffer();
+    flush();
 }
 
 void OLEDDisplay::clear() {
-    display.clearBuffer();
-    display.sendBuffer();
+    invalidateCountdown();
+    beginScreen(OLEDScreen::BLANK);
+    flush();
 }
 
 void OLEDDisplay::update() {
     // This method can be used for any periodic display updates if needed
 }
 
-void OLEDDisplay::drawCenteredText(const char* text, int y) {
-    int textWidth = display.getStrWidth(text);
-    int x = (OLED_WIDTH - textWidth) / 2;
-    display.drawStr(x, y, text);
+void OLEDDisplay::setLatencyProbe(LatencyProbe* probe) {
+    latency = probe;
+}
+
+uint32_t OLEDDisplay::getLastFlushMicros() const {
+    return lastFlushMicros;
 }
 
-void OLEDDisplay::drawProgressBar(int current, int total, int x, int y, int width, int height) {
+const ScreenTiming& OLEDDisplay::getTiming(OLEDScreen screen) const {
+    return timings[(int)screen];
+}
+
+void OLEDDisplay::setAssets(const AssetPack* pack) {
+    // Takes effect from the next screen drawn
+    assets = pack;
+    dropPrepared();
+}
+
+void OLEDDisplay::beginScreen(OLEDScreen id, int inputValue) {
+    screen.clear();
+    screenId = id;
+    screenKey = contentKey(id, inputValue);
+    screenRendered = false;
+}
+
+void OLEDDisplay::render() {
+#if !OLED_PAGE_BUFFER
+    if (ready && !screenRendered) {
+        uint64_t start = Clock::nowMicros();
+        display.clearBuffer();
+        screen.replay(display, assets);
+        renderMicros = (uint32_t)Clock::elapsedSince(start);
+        screenRendered = true;
+        preparedRendered = false;   // The framebuffer no longer holds it
+    }
+#endif
+}
+
+void OLEDDisplay::flush() {
+    if (!ready) {
+        return;  // Kept in the draw list until init()
+    }
+    
+    uint64_t start = Clock::nowMicros();
+    
+#if OLED_PAGE_BUFFER
+    // Only a page is held in RAM: replay the screen into each one
+    renderMicros = 0;
+    display.firstPage();
+    do {
+        uint64_t pageStart = Clock::nowMicros();
+        screen.replay(display, assets);
+        renderMicros += (uint32_t)Clock::elapsedSince(pageStart);
+    } while (display.nextPage());
+#else
+    render();
+    display.sendBuffer();
+#endif
+    
+    lastFlushMicros = (uint32_t)Clock::elapsedSince(start);
+    
+    ScreenTiming& timing = timings[(int)screenId];
+    if (timing.flushes == 0) {
+        LOG_INFOF("OLED %s: render %lu us, flush %lu us", screenNames[(int)screenId],
+                  (unsigned long)renderMicros, (unsigned long)lastFlushMicros);
+    }
+    timing.renderMicros = renderMicros;
+    timing.flushMicros = lastFlushMicros;
+    timing.flushes++;
+    
+    // Only a flush that can show an input closes its measurement
+    if (latency != nullptr && screenKey != flushedKey) {
+        latency->markOutput(LatencyChannel::OLED);
+    }
+    flushedKey = screenKey;
+}
+
+void OLEDDisplay::drawProgressBar(DrawList& list, int current, int total, int x, int y, int width, int height) {
     // Draw border
-    display.drawFrame(x, y, width, height);
+    list.drawFrame(x, y, width, height);
     
     // Draw filled portion
     if (total > 0) {
         int fillWidth = (current * (width - 2)) / total;
         if (fillWidth > 0) {
-            display.drawBox(x + 1, y + 1, fillWidth, height - 2);
+            list.drawBox(x + 1, y + 1, fillWidth, height - 2);
         }
     }
 }
 
-String OLEDDisplay::formatTime(int seconds) {
+void OLEDDisplay::formatTime(int seconds, char* out, size_t size) {
     int minutes = seconds / 60;
     int secs = seconds % 60;
     
-    String result = "";
+    // "25m 0s" or "42s", formatted in place (no String temporaries)
     if (minutes > 0) {
-        result += String(minutes) + "m ";
+        snprintf(out, size, "%dm %ds", minutes, secs);
+    } else {
+        snprintf(out, size, "%ds", secs);
     }
-    result += String(secs) + "s";
-    
-    return result;
+}
+
+const char* OLEDDisplay::text(AssetId id, const char* fallback) const {
+    return (assets != nullptr) ? assets->getText(id, fallback) : fallback;
 }
@@ -5,31 +5,106 @@
 #include <Wire.h>
 #include "config.h"
 #include "types.h"
+#include "latency.h"
+#include "draw_list.h"
+#include "asset_pack.h"
+
+// Full framebuffer (1 KB) or U8g2 page mode (128 / 256 bytes)
+#if OLED_PAGE_BUFFER == 1
+typedef U8G2_SSD1306_128X64_NONAME_1_HW_I2C OLEDDriver;
+#elif OLED_PAGE_BUFFER == 2
+typedef U8G2_SSD1306_128X64_NONAME_2_HW_I2C OLEDDriver;
+#else
+typedef U8G2_SSD1306_128X64_NONAME_F_HW_I2C OLEDDriver;
+#endif
+
+#define TIME_TEXT_MAX 16   // Longest formatTime() text ("-35791394m -8s") plus NUL
+
+// Screens OLEDDisplay draws (timings are kept per screen)
+enum class OLEDScreen : uint8_t {
+    BLANK,
+    TIME_SELECTION,
+    COUNTDOWN,
+    PAUSED,
+    COMPLETE,
+    CANCELLED,
+    COUNT
+};
+
+// Cost of the last flush of a screen
+struct ScreenTiming {
+    uint32_t renderMicros;      // Draw list replay (all pages; ahead of the flush for a prepared countdown)
+    uint32_t flushMicros;       // Replay + transfer in flush()
+    uint32_t flushes;
+};
 
 class OLEDDisplay {
 public:
     OLEDDisplay();
     
-    // Initialization
+    // Initialization; screens shown before init() are only recorded and
+    // the latest one is flushed by it
     void init();
+    bool isReady() const;
     
     // Display methods
     void showTimeSelection(int seconds);
     void showCountdown(int remainingSeconds, int totalSeconds);
+    void prepareCountdown(int remainingSeconds, int totalSeconds);
+    void setCountdownTitle(const char* title);
+    void showPaused(int remainingSeconds, int totalSeconds);
     void showComplete();
     void showCancelled();
     void clear();
     
     // Update display
     void update();
+    void setLatencyProbe(LatencyProbe* probe);  // Marks OLED output when input-driven content changes
+    void setAssets(const AssetPack* pack);      // Fonts and text; built-ins when not set
+    uint32_t getLastFlushMicros() const;        // Render + transfer of the last screen
+    const ScreenTiming& getTiming(OLEDScreen screen) const;
 
 private:
-    U8G2_SSD1306_128X64_NONAME_F_HW_I2C display;
+    OLEDDriver display;
+    
+    // Current screen; in full-buffer mode it is rasterised once, in page
+    // mode it is replayed for every page
+    DrawList screen;
+    OLEDScreen screenId;
+    uint32_t screenKey;         // Screen and the input-driven value it shows
+    uint32_t flushedKey;        // screenKey of the last flush
+    bool ready;
+    bool screenRendered;
+    uint32_t renderMicros;
+    
+    // Countdown frame cache (skips redraws when nothing visible changed)
+    const char* countdownTitle;
+    int countdownRemaining;
+    int countdownTotal;
+    
+    // Next countdown frame, built while another screen is showing and
+    // swapped in by showCountdown()
+    DrawList prepared;
+    int preparedRemaining;
+    int preparedTotal;
+    bool preparedRendered;      // Full-buffer mode: the framebuffer holds it
+    uint32_t preparedRenderMicros;
+    
+    LatencyProbe* latency;
+    uint32_t lastFlushMicros;
+    ScreenTiming timings[(int)OLEDScreen::COUNT];
+    const AssetPack* assets;
     
     // Helper methods
-    void drawCenteredText(const char* text, int y);
-    void drawProgressBar(int current, int total, int x, int y, int width, int height);
-    String formatTime(int seconds);
+    void beginScreen(OLEDScreen id, int inputValue = 0);
+    void render();
+    void flush();
+    void drawCountdown(DrawList& list, int remainingSeconds, int totalSeconds);
+    void invalidateCountdown();
+    void dropPrepared();
+    void drawProgressBar(DrawList& list, int current, int total, int x, int y, int width, int height);
+    void formatTime(int seconds, char* out, size_t size);
+    const char* text(AssetId id, const char* fallback) const;
 };
 
 #endif
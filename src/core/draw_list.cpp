@@ -0,0 +1,136 @@
+#include "draw_list.h"
+#include "asset_pack.h"
+#include "logger.h"
+#include <string.h>
+
+static const uint8_t* fontData(uint8_t font, const AssetPack* assets) {
+    if (assets != nullptr) {
+        const uint8_t* packed = assets->get((AssetId)((uint16_t)AssetId::FONT_SMALL + font));
+        if (packed != nullptr) {
+            return packed;
+        }
+    }
+    
+#if ASSET_PACK_FONTS
+    // Only the small font is linked in; it stands in for the others
+    return u8g2_font_6x10_tr;
+#else
+    switch ((DisplayFont)font) {
+        case DisplayFont::BODY:    return u8g2_font_ncenB08_tr;
+        case DisplayFont::HEADING: return u8g2_font_ncenB12_tr;
+        case DisplayFont::LARGE:   return u8g2_font_ncenB18_tr;
+        case DisplayFont::SMALL:
+        default:                   return u8g2_font_6x10_tr;
+    }
+#endif
+}
+
+static uint8_t clampCoord(int value) {
+    return (uint8_t)((value < 0) ? 0 : ((value > 255) ? 255 : value));
+}
+
+DrawList::DrawList() : opCount(0), textUsed(0), overflowLogged(false) {
+}
+
+void DrawList::clear() {
+    opCount = 0;
+    textUsed = 0;
+}
+
+void DrawList::setFont(DisplayFont font) {
+    add(OP_FONT, 0, 0, 0, 0, (uint8_t)font);
+}
+
+void DrawList::drawStr(int x, int y, const char* str) {
+    int offset = copyText(str);
+    if (offset >= 0) {
+        add(OP_TEXT, x, y, 0, 0, (uint8_t)offset);
+    }
+}
+
+void DrawList::drawCenteredStr(const char* str, int y) {
+    int offset = copyText(str);
+    if (offset >= 0) {
+        add(OP_CENTERED_TEXT, 0, y, 0, 0, (uint8_t)offset);
+    }
+}
+
+void DrawList::drawFrame(int x, int y, int width, int height) {
+    add(OP_FRAME, x, y, width, height, 0);
+}
+
+void DrawList::drawBox(int x, int y, int width, int height) {
+    add(OP_BOX, x, y, width, height, 0);
+}
+
+void DrawList::replay(U8G2& display, const AssetPack* assets) const {
+    for (int i = 0; i < opCount; i++) {
+        const Op& op = ops[i];
+        const char* str = &text[op.arg];
+        
+        switch (op.type) {
+            case OP_FONT:
+                display.setFont(fontData(op.arg, assets));
+                break;
+            case OP_TEXT:
+                display.drawStr(op.x, op.y, str);
+                break;
+            case OP_CENTERED_TEXT:
+                display.drawStr((OLED_WIDTH - display.getStrWidth(str)) / 2, op.y, str);
+                break;
+            case OP_FRAME:
+                display.drawFrame(op.x, op.y, op.width, op.height);
+                break;
+            case OP_BOX:
+                display.drawBox(op.x, op.y, op.width, op.height);
+                break;
+        }
+    }
+}
+
+bool DrawList::isEmpty() const {
+    return opCount == 0;
+}
+
+void DrawList::add(uint8_t type, int x, int y, int width, int height, uint8_t arg) {
+    if (opCount >= DRAW_LIST_OPS) {
+        logOverflow("draw call dropped");  // Screens are fixed layouts sized to fit
+        return;
+    }
+    
+    Op& op = ops[opCount++];
+    op.type = type;
+    op.x = clampCoord(x);
+    op.y = clampCoord(y);
+    op.width = clampCoord(width);
+    op.height = clampCoord(height);
+    op.arg = arg;
+}
+
+int DrawList::copyText(const char* str) {
+    // Text that does not fit is cut short rather than dropped
+    size_t length = strlen(str) + 1;
+    size_t room = DRAW_LIST_TEXT - textUsed;
+    if (room < 2) {
+        logOverflow("text dropped");
+        return -1;
+    }
+    if (length > room) {
+        length = room;
+        logOverflow("text cut short");
+    }
+    
+    int offset = textUsed;
+    memcpy(&text[offset], str, length - 1);
+    text[offset + length - 1] = '\0';
+    textUsed += (uint8_t)length;
+    return offset;
+}
+
+void DrawList::logOverflow(const char* what) {
+    // Once: screens are redrawn every second
+    if (!overflowLogged) {
+        overflowLogged = true;
+        LOG_WARNINGF("Draw list full (%d ops, %d text bytes): %s", DRAW_LIST_OPS, DRAW_LIST_TEXT, what);
+    }
+}
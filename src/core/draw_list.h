@@ -0,0 +1,62 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <U8g2lib.h>
+#include <stdint.h>
+#include "config.h"
+
+class AssetPack;
+
+// Fonts a draw list can select. Replay takes them from the asset pack
+// (AssetId::FONT_SMALL + font) and falls back to the built-in U8g2 font.
+enum class DisplayFont : uint8_t {
+    SMALL,      // u8g2_font_6x10_tr
+    BODY,       // u8g2_font_ncenB08_tr
+    HEADING,    // u8g2_font_ncenB12_tr
+    LARGE       // u8g2_font_ncenB18_tr
+};
+
+// One OLED screen as a compact list of draw calls. Text is copied into the
+// list, so it can be replayed any number of times: once into a full
+// framebuffer, or once per page when U8g2 streams the panel in pages.
+// Text past DRAW_LIST_TEXT is cut short and draw calls past DRAW_LIST_OPS
+// are dropped, with one warning logged.
+class DrawList {
+public:
+    DrawList();
+    
+    void clear();
+    void setFont(DisplayFont font);
+    void drawStr(int x, int y, const char* text);
+    void drawCenteredStr(const char* text, int y);     // Centered at replay, in the current font
+    void drawFrame(int x, int y, int width, int height);
+    void drawBox(int x, int y, int width, int height);
+    
+    void replay(U8G2& display, const AssetPack* assets = nullptr) const;
+    bool isEmpty() const;
+
+private:
+    enum OpType : uint8_t { OP_FONT, OP_TEXT, OP_CENTERED_TEXT, OP_FRAME, OP_BOX };
+    
+    // Coordinates fit the 128x64 panel; text ops keep an offset into text[]
+    struct Op {
+        uint8_t type;
+        uint8_t x;
+        uint8_t y;
+        uint8_t width;
+        uint8_t height;
+        uint8_t arg;        // Font or text offset
+    };
+    
+    Op ops[DRAW_LIST_OPS];
+    uint8_t opCount;
+    char text[DRAW_LIST_TEXT];
+    uint8_t textUsed;
+    bool overflowLogged;
+    
+    void add(uint8_t type, int x, int y, int width, int height, uint8_t arg);
+    int copyText(const char* str);
+    void logOverflow(const char* what);
+};
+
+#endif // DRAW_LIST_H
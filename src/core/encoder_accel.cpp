@@ -0,0 +1,66 @@
+#include "encoder_accel.h"
+#include "clock.h"
+
+// A slow detent weighs DETENT_UNITS; one increment is INCREMENT_UNITS
+#define DETENT_UNITS 256
+#define INCREMENT_UNITS (DETENT_UNITS * ENCODER_STEPS_PER_INCREMENT)
+#define SLOW_US MS_TO_US(ENCODER_ACCEL_SLOW_MS)
+#define FAST_US MS_TO_US(ENCODER_ACCEL_FAST_MS)
+
+EncoderAcceleration::EncoderAcceleration() {
+    reset();
+}
+
+void EncoderAcceleration::reset() {
+    pendingSteps = 0;
+    fraction = 0;
+    lastDetentUs = 0;
+    detentIntervalUs = 0;
+    moving = false;
+}
+
+int32_t EncoderAcceleration::detentWeight(uint32_t intervalUs) {
+    const int32_t slowWeight = DETENT_UNITS;
+    const int32_t fastWeight = ENCODER_ACCEL_MAX * INCREMENT_UNITS;
+    
+    if (intervalUs >= SLOW_US) {
+        return slowWeight;
+    }
+    if (intervalUs <= FAST_US) {
+        return fastWeight;
+    }
+    return slowWeight + (int32_t)((int64_t)(fastWeight - slowWeight) * (SLOW_US - intervalUs) / (SLOW_US - FAST_US));
+}
+
+int EncoderAcceleration::update(int16_t steps, uint32_t timeUs) {
+    // A reversal drops whatever was accumulated the other way
+    if ((steps > 0 && (pendingSteps < 0 || fraction < 0)) ||
+        (steps < 0 && (pendingSteps > 0 || fraction > 0))) {
+        pendingSteps = 0;
+        fraction = 0;
+        moving = false;
+    }
+    
+    pendingSteps += steps;
+    int32_t detents = pendingSteps / ENCODER_STEPS_PER_DETENT;
+    if (detents == 0) {
+        return 0;
+    }
+    pendingSteps -= detents * ENCODER_STEPS_PER_DETENT;
+    
+    // Detents reported together share the time since the previous one
+    int32_t count = (detents > 0) ? detents : -detents;
+    uint32_t interval = moving ? (timeUs - lastDetentUs) / (uint32_t)count : SLOW_US;
+    detentIntervalUs = moving ? interval : 0;
+    lastDetentUs = timeUs;
+    moving = true;
+    
+    fraction += detents * detentWeight(interval);
+    int increments = fraction / INCREMENT_UNITS;
+    fraction -= increments * INCREMENT_UNITS;
+    return increments;
+}
+
+uint32_t EncoderAcceleration::getDetentIntervalUs() const {
+    return detentIntervalUs;
+}
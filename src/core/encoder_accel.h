@@ -0,0 +1,35 @@
+#ifndef ENCODER_ACCEL_H
+#define ENCODER_ACCEL_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Turns encoder movement into value increments with a speed-dependent
+// gain. Detents ENCODER_ACCEL_SLOW_MS or more apart, and the first
+// detent of a turn, take ENCODER_STEPS_PER_INCREMENT detents per increment;
+// the gain rises linearly below that, up to ENCODER_ACCEL_MAX increments
+// per detent at ENCODER_ACCEL_FAST_MS and faster. Spin profiles are in
+// test/test_encoder_accel.
+class EncoderAcceleration {
+public:
+    EncoderAcceleration();
+    
+    void reset();
+    
+    // Feed one ROTATE event (quadrature steps, edge time); returns the
+    // signed number of whole increments it completes
+    int update(int16_t steps, uint32_t timeUs);
+    
+    uint32_t getDetentIntervalUs() const;   // Between the last two detents (0 before the second)
+
+private:
+    int32_t pendingSteps;       // Quadrature steps short of a full detent
+    int32_t fraction;           // Partial increment (a slow detent adds 256)
+    uint32_t lastDetentUs;
+    uint32_t detentIntervalUs;
+    bool moving;
+    
+    static int32_t detentWeight(uint32_t intervalUs);
+};
+
+#endif // ENCODER_ACCEL_H
@@ -0,0 +1,178 @@
+#include "flash.h"
+#include "logger.h"
+#include <string.h>
+
+#ifdef ARDUINO
+FlashPartition::FlashPartition(const char* label)
+    : label(label), partition(nullptr), mapHandle(0), mapped(nullptr), eraseCount(0) {
+}
+
+bool FlashPartition::init() {
+    partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA,
+                                         ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr) {
+        LOG_ERRORF("Flash partition '%s' not found", label);
+        return false;
+    }
+    
+    LOG_INFOF("Flash partition '%s': %lu bytes", label, (unsigned long)partition->size);
+    return true;
+}
+
+bool FlashPartition::isReady() const {
+    return partition != nullptr;
+}
+
+bool FlashPartition::read(uint32_t offset, void* dst, size_t length) const {
+    if (partition == nullptr || offset + length > partition->size) {
+        return false;
+    }
+    return esp_partition_read(partition, offset, dst, length) == ESP_OK;
+}
+
+bool FlashPartition::write(uint32_t offset, const void* src, size_t length) {
+    if (partition == nullptr || offset + length > partition->size) {
+        return false;
+    }
+    return esp_partition_write(partition, offset, src, length) == ESP_OK;
+}
+
+bool FlashPartition::eraseSector(uint32_t sector) {
+    if (partition == nullptr || sector >= getSectorCount()) {
+        return false;
+    }
+    
+    eraseCount++;
+    return esp_partition_erase_range(partition, sector * FLASH_SECTOR_SIZE,
+                                     FLASH_SECTOR_SIZE) == ESP_OK;
+}
+
+const uint8_t* FlashPartition::map() {
+    if (mapped != nullptr || partition == nullptr) {
+        return mapped;
+    }
+    
+    const void* ptr = nullptr;
+    if (esp_partition_mmap(partition, 0, partition->size, ESP_PARTITION_MMAP_DATA,
+                           &ptr, &mapHandle) != ESP_OK) {
+        LOG_ERRORF("Flash partition '%s' mmap failed", label);
+        return nullptr;
+    }
+    
+    mapped = (const uint8_t*)ptr;
+    return mapped;
+}
+
+uint32_t FlashPartition::getSize() const {
+    return (partition != nullptr) ? partition->size : 0;
+}
+#else
+FlashPartition::FlashPartition(const char* label)
+    : label(label), memory(nullptr), size(0), mapped(nullptr), eraseCount(0) {
+}
+
+struct HostRegion {
+    const char* label;
+    uint8_t* memory;
+    uint32_t size;
+};
+
+#define HOST_REGIONS 4
+static HostRegion hostRegions[HOST_REGIONS];
+static int32_t writeBudget = -1;
+
+bool HostFlash::attach(const char* label, uint8_t* memory, uint32_t size) {
+    for (int i = 0; i < HOST_REGIONS; i++) {
+        if (hostRegions[i].label == nullptr || strcmp(hostRegions[i].label, label) == 0) {
+            hostRegions[i].label = label;
+            hostRegions[i].memory = memory;
+            hostRegions[i].size = size;
+            return true;
+        }
+    }
+    return false;
+}
+
+void HostFlash::detachAll() {
+    memset(hostRegions, 0, sizeof(hostRegions));
+    writeBudget = -1;
+}
+
+void HostFlash::setWriteBudget(int32_t bytes) {
+    writeBudget = bytes;
+}
+
+bool FlashPartition::init() {
+    for (int i = 0; i < HOST_REGIONS; i++) {
+        if (hostRegions[i].label != nullptr && strcmp(hostRegions[i].label, label) == 0) {
+            memory = hostRegions[i].memory;
+            size = hostRegions[i].size;
+            mapped = nullptr;
+            return true;
+        }
+    }
+    
+    LOG_ERRORF("Flash partition '%s' not found", label);
+    return false;
+}
+
+bool FlashPartition::isReady() const {
+    return memory != nullptr;
+}
+
+bool FlashPartition::read(uint32_t offset, void* dst, size_t length) const {
+    if (memory == nullptr || offset + length > size) {
+        return false;
+    }
+    memcpy(dst, memory + offset, length);
+    return true;
+}
+
+bool FlashPartition::write(uint32_t offset, const void* src, size_t length) {
+    if (memory == nullptr || offset + length > size) {
+        return false;
+    }
+    
+    // Power loss: only the bytes within the budget reach the flash
+    size_t allowed = length;
+    if (writeBudget >= 0 && (size_t)writeBudget < length) {
+        allowed = (size_t)writeBudget;
+    }
+    if (writeBudget >= 0) {
+        writeBudget -= (int32_t)allowed;
+    }
+    
+    const uint8_t* bytes = (const uint8_t*)src;
+    for (size_t i = 0; i < allowed; i++) {
+        memory[offset + i] &= bytes[i];
+    }
+    return allowed == length;
+}
+
+bool FlashPartition::eraseSector(uint32_t sector) {
+    if (memory == nullptr || sector >= getSectorCount()) {
+        return false;
+    }
+    
+    eraseCount++;
+    memset(memory + sector * FLASH_SECTOR_SIZE, 0xFF, FLASH_SECTOR_SIZE);
+    return true;
+}
+
+const uint8_t* FlashPartition::map() {
+    mapped = memory;
+    return mapped;
+}
+
+uint32_t FlashPartition::getSize() const {
+    return size;
+}
+#endif
+
+uint32_t FlashPartition::getSectorCount() const {
+    return getSize() / FLASH_SECTOR_SIZE;
+}
+
+uint32_t FlashPartition::getEraseCount() const {
+    return eraseCount;
+}
@@ -0,0 +1,63 @@
+#ifndef FLASH_H
+#define FLASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#ifdef ARDUINO
+#include <esp_partition.h>
+#endif
+
+#define FLASH_SECTOR_SIZE 4096
+
+// Thin wrapper around a raw data partition (see partitions.csv).
+// Host builds use a RAM stand-in instead (see HostFlash).
+class FlashPartition {
+public:
+    FlashPartition(const char* label);
+    
+    // Locate the partition by label
+    bool init();
+    bool isReady() const;
+    
+    // Raw access (offsets are relative to the partition start)
+    bool read(uint32_t offset, void* dst, size_t length) const;
+    bool write(uint32_t offset, const void* src, size_t length);
+    bool eraseSector(uint32_t sector);
+    
+    // Map the whole partition into the data address space (read-only, zero copy)
+    const uint8_t* map();
+    
+    uint32_t getSize() const;
+    uint32_t getSectorCount() const;
+    uint32_t getEraseCount() const;
+
+private:
+    const char* label;
+#ifdef ARDUINO
+    const esp_partition_t* partition;
+    spi_flash_mmap_handle_t mapHandle;
+#else
+    uint8_t* memory;
+    uint32_t size;
+#endif
+    const uint8_t* mapped;
+    uint32_t eraseCount;
+};
+
+#ifndef ARDUINO
+// Host stand-in for the flash partitions (native tests). A partition is a
+// caller-owned memory region registered under its label; a file mapped
+// with MAP_SHARED makes it file-backed. As on NOR flash, erase sets bytes
+// to 0xFF and writes can only clear bits. The write budget simulates power
+// loss: once it runs out, writes stop part-way and fail.
+class HostFlash {
+public:
+    static bool attach(const char* label, uint8_t* memory, uint32_t size);
+    static void detachAll();
+    
+    // Bytes that may still be written (-1: unlimited)
+    static void setWriteBudget(int32_t bytes);
+};
+#endif
+
+#endif
@@ -0,0 +1,133 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "frame_capture.h"
+#include "crc.h"
+#include <string.h>
+
+FrameCapture::FrameCapture()
+    : enabled(false), needKeyframe(true), framesSinceKeyframe(0), lastTimestamp(0),
+      bytesSent(0), droppedFrames(0) {
+}
+
+void FrameCapture::setEnabled(bool newEnabled) {
+    enabled = newEnabled;
+    needKeyframe = true;
+}
+
+bool FrameCapture::isEnabled() const {
+    return enabled;
+}
+
+void FrameCapture::capture(const CRGB* frame, int numLeds, uint64_t timestampUs) {
+    if (!enabled) {
+        return;
+    }
+    
+    size_t length = encode(frame, numLeds, timestampUs, packet);
+    if (length == 0) {
+        return;
+    }
+    
+#ifdef ARDUINO
+    // Whole packets only, written from the same loop as the logger, so
+    // they never tear a log line or get torn by one
+    if ((size_t)Serial.availableForWrite() < length) {
+        needKeyframe = true;
+        droppedFrames++;
+        return;
+    }
+    Serial.write(packet, length);
+#endif
+    bytesSent += length;
+}
+
+size_t FrameCapture::encode(const CRGB* frame, int numLeds, uint64_t timestampUs, uint8_t* out) {
+    if (numLeds <= 0 || numLeds > NUM_LEDS) {
+        return 0;
+    }
+    
+    size_t frameBytes = numLeds * 3;
+    uint64_t interval = timestampUs - lastTimestamp;
+    uint8_t* body = out + CAPTURE_HEADER_BYTES;
+    size_t bodyLength = 0;
+    uint8_t kind = CAPTURE_DELTA;
+    
+    // Deltas only carry a 16-bit interval; periodic keyframes bound how
+    // long a decoder that joins late (or lost a packet) stays blind
+    if (!needKeyframe && interval <= 0xFFFF && framesSinceKeyframe < CAPTURE_KEYFRAME_INTERVAL) {
+        body[0] = (uint8_t)interval;
+        body[1] = (uint8_t)(interval >> 8);
+        size_t rle = encodeDelta((const uint8_t*)frame, frameBytes, body + 2, frameBytes);
+        if (rle > 0) {
+            bodyLength = 2 + rle;
+        }
+    }
+    
+    // Keyframe when forced or when the delta would not be smaller
+    if (bodyLength == 0) {
+        kind = CAPTURE_KEYFRAME;
+        // Full 64-bit time, so the stream stays ordered past 71 minutes of uptime
+        for (int i = 0; i < CAPTURE_KEYFRAME_STAMP; i++) {
+            body[i] = (uint8_t)(timestampUs >> (8 * i));
+        }
+        memcpy(body + CAPTURE_KEYFRAME_STAMP, frame, frameBytes);
+        bodyLength = CAPTURE_KEYFRAME_STAMP + frameBytes;
+        framesSinceKeyframe = 0;
+        needKeyframe = false;
+    } else {
+        framesSinceKeyframe++;
+    }
+    
+    out[0] = CAPTURE_SYNC;
+    out[1] = kind;
+    out[2] = (uint8_t)bodyLength;
+    out[3] = (uint8_t)(bodyLength >> 8);
+    out[CAPTURE_HEADER_BYTES + bodyLength] = crc8(out + 1, 3 + bodyLength);
+    
+    memcpy(previous, frame, frameBytes);
+    lastTimestamp = timestampUs;
+    return CAPTURE_HEADER_BYTES + bodyLength + 1;
+}
+
+size_t FrameCapture::encodeDelta(const uint8_t* frame, size_t length, uint8_t* out, size_t limit) const {
+    // Returns 0 if the tokens would exceed 'limit' bytes
+    const uint8_t* last = (const uint8_t*)previous;
+    size_t written = 0;
+    size_t i = 0;
+    
+    while (i < length) {
+        size_t run = 0;
+        while (i + run < length && run < 128 && frame[i + run] == last[i + run]) {
+            run++;
+        }
+        
+        if (run > 0) {
+            if (written + 1 > limit) return 0;
+            out[written++] = (uint8_t)(0x80 | (run - 1));
+            i += run;
+            continue;
+        }
+        
+        // Literal bytes up to the next unchanged byte
+        size_t literal = 0;
+        while (i + literal < length && literal < 128 && frame[i + literal] != last[i + literal]) {
+            literal++;
+        }
+        if (written + 1 + literal > limit) return 0;
+        out[written++] = (uint8_t)(literal - 1);
+        for (size_t k = 0; k < literal; k++) {
+            out[written++] = frame[i + k] ^ last[i + k];
+        }
+        i += literal;
+    }
+    return written;
+}
+
+uint32_t FrameCapture::getBytesSent() const {
+    return bytesSent;
+}
+
+uint32_t FrameCapture::getDroppedFrames() const {
+    return droppedFrames;
+}
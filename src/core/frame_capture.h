@@ -0,0 +1,55 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <FastLED.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+
+// Capture packet layout (little endian), interleaved with text log lines:
+//   0x00 sync | kind | u16 body length | body | crc8(kind .. body)
+// KEYFRAME body: u64 timestamp (us, Clock::nowMicros) + raw RGB frame
+// DELTA body:    u16 microseconds since the previous frame + RLE of
+//                (frame XOR previous frame). Token 0x80|(n-1) is a run
+//                of n zero bytes, token (n-1) is n literal bytes.
+// Log text never contains 0x00, so the decoder resyncs on it.
+#define CAPTURE_SYNC 0x00
+#define CAPTURE_KEYFRAME 0x01
+#define CAPTURE_DELTA 0x02
+#define CAPTURE_HEADER_BYTES 4
+#define CAPTURE_KEYFRAME_STAMP 8
+#define CAPTURE_PACKET_MAX (CAPTURE_HEADER_BYTES + CAPTURE_KEYFRAME_STAMP + NUM_LEDS * 3 + 1)
+
+// Opt-in stream of the frames AnimationManager puts on the wire
+class FrameCapture {
+public:
+    FrameCapture();
+    
+    // Enabling restarts the stream with a keyframe
+    void setEnabled(bool enabled);
+    bool isEnabled() const;
+    
+    // Encode and send one frame; dropped (and followed by a keyframe)
+    // rather than blocking when the serial TX buffer is full
+    void capture(const CRGB* frame, int numLeds, uint64_t timestampUs);
+    
+    // Encode the next packet without sending it; returns its length
+    size_t encode(const CRGB* frame, int numLeds, uint64_t timestampUs, uint8_t* out);
+    
+    uint32_t getBytesSent() const;
+    uint32_t getDroppedFrames() const;
+
+private:
+    bool enabled;
+    bool needKeyframe;
+    uint16_t framesSinceKeyframe;
+    uint64_t lastTimestamp;
+    CRGB previous[NUM_LEDS];
+    uint8_t packet[CAPTURE_PACKET_MAX];
+    uint32_t bytesSent;
+    uint32_t droppedFrames;
+    
+    size_t encodeDelta(const uint8_t* frame, size_t length, uint8_t* out, size_t limit) const;
+};
+
+#endif // FRAME_CAPTURE_H
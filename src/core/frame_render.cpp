@@ -0,0 +1,73 @@
+#include "frame_render.h"
+#include "clock.h"
+#include "pixel_ops.h"
+#include <stdio.h>
+
+FrameRenderer::FrameRenderer(uint32_t frameIntervalUs)
+    : manager(leds, NUM_LEDS), frameIntervalUs(frameIntervalUs), virtualNow(0) {
+}
+
+uint64_t FrameRenderer::virtualClock() const {
+    return virtualNow;
+}
+
+uint32_t FrameRenderer::render(const TimelineStep* steps, int stepCount, const FrameSink& sink) {
+    // Crossfades and the frame cache read Clock, so run them on virtual time
+    virtualNow = 0;
+    Clock::setSource(ClockSource::bind<FrameRenderer, &FrameRenderer::virtualClock>(this));
+    
+    // Effects that build on the previous frame (COMET) start from black,
+    // not from whatever the last timeline or the stack left in the strip
+    fillPixels(leds, NUM_LEDS, CRGB::Black);
+    manager = AnimationManager(leds, NUM_LEDS);
+    manager.setBrightness(LED_BRIGHTNESS);
+    
+    uint32_t frameIndex = 0;
+    for (int s = 0; s < stepCount; s++) {
+        const TimelineStep& step = steps[s];
+        manager.setAnimation(step.type, (s > 0) ? step.crossfadeMs : 0);
+        manager.setColors(step.color);
+        
+        uint32_t frames = (uint32_t)(MS_TO_US(step.durationMs) / frameIntervalUs);
+        for (uint32_t f = 0; f < frames; f++) {
+            float t = (frames > 1) ? (float)f / (float)(frames - 1) : 1.0f;
+            
+            AnimationParams params;
+            params.progress = step.progressFrom + (step.progressTo - step.progressFrom) * t;
+            params.primaryColor = step.color;
+            params.secondaryColor = CRGB::Black;
+            params.brightness = LED_BRIGHTNESS;
+            params.timestamp = virtualNow;
+            
+            manager.update(params);
+            manager.show();
+            if (sink != nullptr) {
+                sink(manager.getFrame(), NUM_LEDS, frameIndex);
+            }
+            
+            frameIndex++;
+            virtualNow += frameIntervalUs;
+        }
+    }
+    
+    Clock::setSource(nullptr);
+    return frameIndex;
+}
+
+size_t FrameRenderer::formatPpmHeader(char* buffer, size_t size, int width, int height) {
+    int length = snprintf(buffer, size, "P6\n%d %d\n255\n", width, height);
+    return (length < 0 || (size_t)length >= size) ? 0 : (size_t)length;
+}
+
+uint32_t FrameRenderer::compareFrames(const CRGB* frame, const CRGB* reference, int numLeds, uint8_t tolerance) {
+    uint32_t mismatches = 0;
+    for (int i = 0; i < numLeds; i++) {
+        for (int c = 0; c < 3; c++) {
+            int diff = (int)frame[i].raw[c] - (int)reference[i].raw[c];
+            if (diff > tolerance || -diff > tolerance) {
+                mismatches++;
+            }
+        }
+    }
+    return mismatches;
+}
@@ -0,0 +1,50 @@
+#ifndef FRAME_RENDER_H
+#define FRAME_RENDER_H
+
+#include <FastLED.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "types.h"
+#include "config.h"
+#include "animations.h"
+
+// One scripted span of an animation timeline
+struct TimelineStep {
+    AnimationType type;
+    uint32_t durationMs;
+    float progressFrom;     // progress is interpolated linearly across the step
+    float progressTo;
+    CRGB color;
+    uint16_t crossfadeMs;   // Fade in from the previous step (0 = cut)
+};
+
+// Receives each finished frame exactly as it would go on the wire
+typedef Delegate<void(const CRGB* frame, int numLeds, uint32_t frameIndex)> FrameSink;
+
+// Drives AnimationManager through a timeline on a virtual clock, so the
+// frames are deterministic and independent of wall time. Used to inspect
+// animations off-target and to compare them against reference frames.
+class FrameRenderer {
+public:
+    FrameRenderer(uint32_t frameIntervalUs = ANIMATION_INTERVAL * 1000UL);
+    
+    // Returns the number of frames delivered to sink
+    uint32_t render(const TimelineStep* steps, int stepCount, const FrameSink& sink);
+    
+    // Binary PPM (P6) header for a strip of 'height' frames of 'width' pixels.
+    // CRGB rows are already R,G,B bytes and can be appended as-is.
+    static size_t formatPpmHeader(char* buffer, size_t size, int width, int height);
+    
+    // Number of channels differing from the reference by more than tolerance
+    static uint32_t compareFrames(const CRGB* frame, const CRGB* reference, int numLeds, uint8_t tolerance);
+
+private:
+    CRGB leds[NUM_LEDS];
+    AnimationManager manager;
+    uint32_t frameIntervalUs;
+    uint64_t virtualNow;
+    
+    uint64_t virtualClock() const;
+};
+
+#endif // FRAME_RENDER_H
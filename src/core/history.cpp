@@ -0,0 +1,265 @@
+#include "history.h"
+#include "clock.h"
+#include "crc.h"
+#include "logger.h"
+#include <string.h>
+
+#define HISTORY_RECORD_MARKER 0xA0
+#define HISTORY_SECONDS_PER_DAY 86400UL
+#define HISTORY_WALL_CLOCK_MIN 1600000000UL   // Older timestamps are device time
+
+SessionHistory::SessionHistory()
+    : partition(HISTORY_PARTITION_LABEL), records(nullptr), slotCount(0), head(0),
+      count(0), timeBase(0), wallOffset(0), pendingCount(0) {
+    memset(&summary, 0, sizeof(summary));
+    for (int i = 0; i < HISTORY_DAYS; i++) {
+        summary.days[i].day = UINT32_MAX;
+    }
+}
+
+bool SessionHistory::init() {
+    if (!partition.init()) {
+        return false;
+    }
+    
+    records = (const HistoryRecord*)partition.map();
+    if (records == nullptr) {
+        return false;
+    }
+    slotCount = partition.getSize() / sizeof(HistoryRecord);
+    
+    // The sector after the head is always erased ahead of time, so the
+    // head is the first blank slot that follows a written one
+    head = 0;
+    for (uint32_t slot = 0; slot < slotCount; slot++) {
+        uint32_t prev = (slot + slotCount - 1) % slotCount;
+        if (isBlank(records[slot]) && !isBlank(records[prev])) {
+            head = slot;
+            break;
+        }
+    }
+    
+    // Everything written lies in the contiguous run behind the head
+    count = 0;
+    while (count < slotCount && !isBlank(records[(head + slotCount - 1 - count) % slotCount])) {
+        count++;
+    }
+    
+    // One pass oldest -> newest to rebuild the summary index
+    for (uint32_t i = count; i > 0; i--) {
+        const HistoryRecord& record = records[(head + slotCount - i) % slotCount];
+        if (isValid(record)) {
+            apply(record);
+            if (record.timestamp < HISTORY_WALL_CLOCK_MIN) {
+                timeBase = record.timestamp;
+            }
+        }
+    }
+    
+    // Sessions that ended before the mount, stamped as of when they ended
+    for (uint8_t i = 0; i < pendingCount; i++) {
+        append(timestampAt(pending[i].uptime), pending[i].info, pending[i].durationSec);
+    }
+    pendingCount = 0;
+    
+    LOG_INFOF("History: %lu records, %lu completed, %lu cancelled",
+              (unsigned long)count, (unsigned long)summary.completed,
+              (unsigned long)summary.cancelled);
+    return true;
+}
+
+bool SessionHistory::record(SessionOutcome outcome, SessionType type, uint32_t durationSec) {
+    uint8_t info = HISTORY_RECORD_MARKER | (((uint8_t)type & 0x03) << 2) | ((uint8_t)outcome & 0x03);
+    uint16_t duration = (durationSec > 0xFFFF) ? 0xFFFF : (uint16_t)durationSec;
+    uint32_t uptime = (uint32_t)(Clock::nowMicros() / US_PER_SEC);
+    
+    if (records == nullptr) {
+        // Not mounted yet (deferred at boot): init() writes it
+        if (pendingCount >= HISTORY_PENDING) {
+            LOG_WARNING("History: not mounted, session dropped");
+            return false;
+        }
+        PendingRecord& entry = pending[pendingCount++];
+        entry.uptime = uptime;
+        entry.durationSec = duration;
+        entry.info = info;
+        return true;
+    }
+    
+    return append(timestampAt(uptime), info, duration);
+}
+
+bool SessionHistory::append(uint32_t timestamp, uint8_t info, uint16_t durationSec) {
+    const uint32_t slotsPerSector = FLASH_SECTOR_SIZE / sizeof(HistoryRecord);
+    
+    // Self-heal after a torn erase
+    if (!isBlank(records[head]) && !partition.eraseSector(head / slotsPerSector)) {
+        return false;
+    }
+    
+    HistoryRecord record;
+    record.timestamp = timestamp;
+    record.durationSec = durationSec;
+    record.info = info;
+    record.crc = crc8(&record, sizeof(HistoryRecord) - sizeof(record.crc));
+    
+    if (!partition.write(head * sizeof(HistoryRecord), &record, sizeof(HistoryRecord))) {
+        LOG_ERROR("History: record write failed");
+        return false;
+    }
+    
+    apply(record);
+    head = (head + 1) % slotCount;
+    if (count < slotCount) {
+        count++;
+    }
+    
+    // Keep a blank sector ahead of the head; the oldest records are dropped
+    if (head % slotsPerSector == 0) {
+        partition.eraseSector(head / slotsPerSector);
+        if (count > slotCount - slotsPerSector) {
+            count = slotCount - slotsPerSector;
+        }
+    }
+    
+    return true;
+}
+
+bool SessionHistory::setTime(uint32_t unixSeconds) {
+    if (unixSeconds < HISTORY_WALL_CLOCK_MIN) {
+        return false;
+    }
+    
+    wallOffset = unixSeconds - (uint32_t)(Clock::nowMicros() / US_PER_SEC);
+    LOG_INFOF("History: wall clock set to %lu", (unsigned long)unixSeconds);
+    return true;
+}
+
+bool SessionHistory::hasTime() const {
+    return wallOffset != 0;
+}
+
+const HistorySummary& SessionHistory::getSummary() const {
+    return summary;
+}
+
+const DayTotals* SessionHistory::getDay(uint32_t daysAgo) const {
+    uint32_t today = now() / HISTORY_SECONDS_PER_DAY;
+    if (!hasTime() || daysAgo >= HISTORY_DAYS || daysAgo > today) {
+        return nullptr;
+    }
+    
+    uint32_t day = today - daysAgo;
+    const DayTotals& totals = summary.days[day % HISTORY_DAYS];
+    return (totals.day == day) ? &totals : nullptr;
+}
+
+uint16_t SessionHistory::getCurrentStreak() const {
+    // A streak survives until a full day passes without a completed work session
+    uint32_t today = now() / HISTORY_SECONDS_PER_DAY;
+    if (!hasTime() || summary.currentStreak == 0 || summary.lastStreakDay + 1 < today) {
+        return 0;
+    }
+    return summary.currentStreak;
+}
+
+uint16_t SessionHistory::getCompletionPerMille() const {
+    uint32_t total = summary.completed + summary.cancelled;
+    return (total == 0) ? 0 : (uint16_t)((summary.completed * 1000UL) / total);
+}
+
+uint32_t SessionHistory::getRecordCount() const {
+    return count;
+}
+
+const HistoryRecord* SessionHistory::getRecord(uint32_t index) const {
+    if (records == nullptr || index >= count) {
+        return nullptr;
+    }
+    
+    const HistoryRecord* record = &records[(head + slotCount - 1 - index) % slotCount];
+    return isValid(*record) ? record : nullptr;
+}
+
+uint32_t SessionHistory::now() const {
+    return timestampAt((uint32_t)(Clock::nowMicros() / US_PER_SEC));
+}
+
+uint32_t SessionHistory::timestampAt(uint32_t uptime) const {
+    if (hasTime()) {
+        return wallOffset + uptime;
+    }
+    
+    // No wall clock: continue from the newest device-time record
+    return timeBase + uptime;
+}
+
+void SessionHistory::apply(const HistoryRecord& record) {
+    bool completed = (record.getOutcome() == SessionOutcome::COMPLETED);
+    bool work = completed && (record.getType() == SessionType::WORK);
+    uint32_t day = record.timestamp / HISTORY_SECONDS_PER_DAY;
+    
+    if (completed) {
+        summary.completed++;
+    } else {
+        summary.cancelled++;
+    }
+    if (work) {
+        summary.workSeconds += record.durationSec;
+    }
+    
+    // Device-time records have no calendar day
+    if (record.timestamp < HISTORY_WALL_CLOCK_MIN) {
+        return;
+    }
+    
+    // Daily totals ring (records older than the window are not tracked)
+    DayTotals& totals = summary.days[day % HISTORY_DAYS];
+    if (totals.day != day && (totals.day == UINT32_MAX || totals.day < day)) {
+        totals.day = day;
+        totals.workSeconds = 0;
+        totals.completed = 0;
+        totals.cancelled = 0;
+    }
+    if (totals.day == day) {
+        if (completed) {
+            totals.completed++;
+        } else {
+            totals.cancelled++;
+        }
+        if (work) {
+            totals.workSeconds += record.durationSec;
+        }
+    }
+    
+    // Streak of consecutive days with completed work
+    if (!work) {
+        return;
+    }
+    if (summary.currentStreak == 0 || day > summary.lastStreakDay + 1) {
+        summary.currentStreak = 1;
+        summary.lastStreakDay = day;
+    } else if (day == summary.lastStreakDay + 1) {
+        summary.currentStreak++;
+        summary.lastStreakDay = day;
+    }
+    
+    if (summary.currentStreak > summary.bestStreak) {
+        summary.bestStreak = summary.currentStreak;
+    }
+}
+
+bool SessionHistory::isBlank(const HistoryRecord& record) {
+    const uint8_t* bytes = (const uint8_t*)&record;
+    for (size_t i = 0; i < sizeof(HistoryRecord); i++) {
+        if (bytes[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SessionHistory::isValid(const HistoryRecord& record) {
+    return (record.info & 0xF0) == HISTORY_RECORD_MARKER &&
+           record.crc == crc8(&record, sizeof(HistoryRecord) - sizeof(record.crc));
+}
@@ -0,0 +1,104 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include <stdint.h>
+#include "types.h"
+#include "config.h"
+#include "flash.h"
+
+// Fixed 8-byte history record as stored in flash
+struct HistoryRecord {
+    uint32_t timestamp;     // Unix seconds once the wall clock is set, otherwise device time
+    uint16_t durationSec;   // Time actually spent in the session
+    uint8_t info;           // Marker (high nibble), SessionType (bits 2-3), SessionOutcome (bits 0-1)
+    uint8_t crc;            // CRC-8 over the first 7 bytes
+    
+    SessionOutcome getOutcome() const { return (SessionOutcome)(info & 0x03); }
+    SessionType getType() const { return (SessionType)((info >> 2) & 0x03); }
+};
+
+static_assert(sizeof(HistoryRecord) == 8, "HistoryRecord must stay 8 bytes");
+
+// Totals for one day
+struct DayTotals {
+    uint32_t day;           // timestamp / 86400
+    uint32_t workSeconds;   // Completed work time
+    uint16_t completed;
+    uint16_t cancelled;
+};
+
+// Incrementally maintained summary index. Day totals and streaks only
+// count records with a wall-clock timestamp.
+struct HistorySummary {
+    uint32_t completed;
+    uint32_t cancelled;
+    uint32_t workSeconds;
+    uint16_t currentStreak;     // Consecutive days with a completed work session
+    uint16_t bestStreak;
+    uint32_t lastStreakDay;
+    DayTotals days[HISTORY_DAYS];
+};
+
+// Circular log of finished sessions in a raw flash partition.
+// The log is read in place through a memory mapping; the only full pass
+// happens at boot to rebuild the summary, after which every append updates
+// the summary incrementally so queries are O(1). The 64 KiB partition has
+// 8192 slots, one 512-slot sector of which is kept erased, so at least
+// the newest 7680 sessions are retained. The board has no RTC: calendar days exist only
+// after the host sets the time (CONTROL_SET_TIME).
+class SessionHistory {
+public:
+    SessionHistory();
+    
+    // Mount and map the partition, rebuild the summary index
+    bool init();
+    
+    // Append a finished session. Before init() up to HISTORY_PENDING are
+    // held in RAM (with their time) and written once the log is mounted.
+    bool record(SessionOutcome outcome, SessionType type, uint32_t durationSec);
+    
+    // Set the wall clock (Unix seconds); lost on reset
+    bool setTime(uint32_t unixSeconds);
+    bool hasTime() const;
+    
+    // Queries (never scan the log); days and streaks need the wall clock
+    const HistorySummary& getSummary() const;
+    const DayTotals* getDay(uint32_t daysAgo) const;
+    uint16_t getCurrentStreak() const;
+    uint16_t getCompletionPerMille() const;
+    
+    // Zero-copy access to stored records (0 = most recent)
+    uint32_t getRecordCount() const;
+    const HistoryRecord* getRecord(uint32_t index) const;
+    
+    // Current history timestamp in seconds
+    uint32_t now() const;
+
+private:
+    FlashPartition partition;
+    const HistoryRecord* records;   // Mapped partition
+    uint32_t slotCount;
+    uint32_t head;                  // Next slot to write
+    uint32_t count;                 // Valid records between oldest and head
+    uint32_t timeBase;              // Device time continues from the last record
+    uint32_t wallOffset;            // Unix seconds at device time 0 (0 = not set)
+    HistorySummary summary;
+    
+    // Recorded before init()
+    struct PendingRecord {
+        uint32_t uptime;            // Device seconds when it was recorded
+        uint16_t durationSec;
+        uint8_t info;
+    };
+    PendingRecord pending[HISTORY_PENDING];
+    uint8_t pendingCount;
+    
+    // Helper methods
+    bool append(uint32_t timestamp, uint8_t info, uint16_t durationSec);
+    uint32_t timestampAt(uint32_t uptime) const;
+    void apply(const HistoryRecord& record);
+    static bool isBlank(const HistoryRecord& record);
+    static bool isValid(const HistoryRecord& record);
+};
+
+#endif
@@ -0,0 +1,266 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#include <esp_timer.h>
+#include <soc/soc.h>
+#include <soc/gpio_reg.h>
+#else
+#define IRAM_ATTR
+#endif
+#include "input_scanner.h"
+#include "input_trace.h"
+#include "clock.h"
+#include "logger.h"
+#include <atomic>
+
+#define DEBOUNCE_US MS_TO_US(ENCODER_DEBOUNCE_MS)
+#define LONG_PRESS_US MS_TO_US(ENCODER_LONG_PRESS_MS)
+
+static_assert((INPUT_SAMPLE_RING & (INPUT_SAMPLE_RING - 1)) == 0 && INPUT_SAMPLE_RING <= 128,
+              "INPUT_SAMPLE_RING must be a power of two up to 128");
+
+// Quadrature step for (previous state << 2) | state, state = (CLK << 1) | DT.
+// Invalid (double) transitions count as no movement.
+static const int8_t QUADRATURE_STEPS[16] = {
+     0, -1, +1,  0,
+    +1,  0,  0, -1,
+    -1,  0,  0, +1,
+     0, +1, -1,  0
+};
+
+#ifdef ARDUINO
+// Register read, timer read and a store into DRAM: nothing that can fault
+// while the flash cache is off
+static void IRAM_ATTR scannerISR(void* arg) {
+    ((InputScanner*)arg)->latch(REG_READ(GPIO_IN_REG), (uint32_t)esp_timer_get_time());
+}
+#endif
+
+static uint32_t defaultSnapshot() {
+#ifdef ARDUINO
+    // GPIO 0..21 on the ESP32-C3, a single register
+    return REG_READ(GPIO_IN_REG);
+#else
+    return 0xFFFFFFFFUL; // Pullups: everything idle
+#endif
+}
+
+InputScanner::InputScanner()
+    : encoderCount(0), buttonCount(0), pinMask(0),
+      sampleHead(0), sampleTail(0), droppedSamples(0),
+      queueHead(0), queueCount(0), droppedEvents(0),
+      snapshotSource(PinSnapshot::bind<defaultSnapshot>()), trace(nullptr) {
+}
+
+int InputScanner::addEncoder(uint8_t clkPin, uint8_t dtPin) {
+    if (encoderCount >= MAX_INPUT_ENCODERS || clkPin >= 32 || dtPin >= 32) {
+        return -1;
+    }
+    
+    Encoder& encoder = encoders[encoderCount];
+    encoder.clkPin = clkPin;
+    encoder.dtPin = dtPin;
+    encoder.state = 0;
+    encoder.position = 0;
+    encoder.reported = 0;
+    encoder.lastEdgeUs = 0;
+    pinMask |= (1UL << clkPin) | (1UL << dtPin);
+    return encoderCount++;
+}
+
+int InputScanner::addButton(uint8_t pin) {
+    if (buttonCount >= MAX_INPUT_BUTTONS || pin >= 32) {
+        return -1;
+    }
+    
+    Button& button = buttons[buttonCount];
+    button.pin = pin;
+    button.pressed = false;
+    button.longPressed = false;
+    button.changedUs = 0;
+    pinMask |= 1UL << pin;
+    return buttonCount++;
+}
+
+void InputScanner::begin() {
+#ifdef ARDUINO
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        if (pinMask & (1UL << pin)) {
+            pinMode(pin, INPUT_PULLUP);
+        }
+    }
+#endif
+    
+    reset();
+    
+#ifdef ARDUINO
+    // One handler for every pin: any edge latches all of them
+    for (uint8_t pin = 0; pin < 32; pin++) {
+        if (pinMask & (1UL << pin)) {
+            attachInterruptArg(digitalPinToInterrupt(pin), scannerISR, this, CHANGE);
+        }
+    }
+#endif
+    
+    LOG_INFOF("Input scanner: %d encoder(s), %d button(s)", encoderCount, buttonCount);
+}
+
+void InputScanner::reset() {
+    uint32_t pins = readPins();
+    uint32_t now = (uint32_t)Clock::nowMicros();
+    
+    for (int i = 0; i < encoderCount; i++) {
+        Encoder& encoder = encoders[i];
+        encoder.state = (uint8_t)((((pins >> encoder.clkPin) & 1) << 1) | ((pins >> encoder.dtPin) & 1));
+        encoder.position = 0;
+        encoder.reported = 0;
+        encoder.lastEdgeUs = now;
+    }
+    for (int i = 0; i < buttonCount; i++) {
+        Button& button = buttons[i];
+        button.pressed = ((pins >> button.pin) & 1) == 0;
+        button.longPressed = false;
+        button.changedUs = now - (uint32_t)DEBOUNCE_US;
+    }
+    
+    sampleTail = sampleHead;
+    queueHead = 0;
+    queueCount = 0;
+}
+
+void IRAM_ATTR InputScanner::latch(uint32_t pins, uint32_t timeUs) {
+    // Single producer; a full ring drops the edge and update() catches up
+    // from the live pins
+    uint8_t head = sampleHead;
+    if ((uint8_t)(head - sampleTail) >= INPUT_SAMPLE_RING) {
+        droppedSamples = droppedSamples + 1;
+        return;
+    }
+    
+    PinSample& sample = samples[head & (INPUT_SAMPLE_RING - 1)];
+    sample.pins = pins;
+    sample.timeUs = timeUs;
+    std::atomic_signal_fence(std::memory_order_release);
+    sampleHead = (uint8_t)(head + 1);
+}
+
+void InputScanner::update() {
+    // Latched edges in order, then the pins as they are now: that takes a
+    // level that settled during a debounce lockout, and edges a full ring lost
+    uint8_t head = sampleHead;
+    std::atomic_signal_fence(std::memory_order_acquire);
+    while (sampleTail != head) {
+        const PinSample& sample = samples[sampleTail & (INPUT_SAMPLE_RING - 1)];
+        decode(sample.pins, sample.timeUs);
+        sampleTail = (uint8_t)(sampleTail + 1);
+    }
+    uint32_t now = (uint32_t)Clock::nowMicros();
+    decode(readPins(), now);
+    
+    // Encoders: one event per encoder with the net movement since the last update
+    for (int i = 0; i < encoderCount; i++) {
+        Encoder& encoder = encoders[i];
+        int32_t steps = encoder.position - encoder.reported;
+        if (steps != 0) {
+            steps = (steps > 32767) ? 32767 : ((steps < -32767) ? -32767 : steps);
+            encoder.reported += steps;
+            LOG_DEBUGF("Encoder %d: %s (%ld)", i, (steps > 0) ? "CW" : "CCW", (long)encoder.position);
+            push(InputEventType::ROTATE, (uint8_t)i, (int16_t)steps, encoder.lastEdgeUs);
+        }
+    }
+    
+    // Long press fires while still held
+    for (int i = 0; i < buttonCount; i++) {
+        Button& button = buttons[i];
+        if (button.pressed && !button.longPressed && now - button.changedUs >= LONG_PRESS_US) {
+            button.longPressed = true;
+            LOG_DEBUG("Button long pressed");
+            push(InputEventType::LONG_PRESS, (uint8_t)i, 0, now);
+        }
+    }
+}
+
+void InputScanner::decode(uint32_t pins, uint32_t timeUs) {
+    if (trace != nullptr) {
+        trace->record(pins & pinMask, timeUs);
+    }
+    
+    // Encoders: one table lookup per encoder, no branching on the transition
+    for (int i = 0; i < encoderCount; i++) {
+        Encoder& encoder = encoders[i];
+        uint8_t state = (uint8_t)((((pins >> encoder.clkPin) & 1) << 1) | ((pins >> encoder.dtPin) & 1));
+        int8_t step = QUADRATURE_STEPS[(encoder.state << 2) | state];
+        encoder.state = state;
+        encoder.position += step;
+        encoder.lastEdgeUs = step ? timeUs : encoder.lastEdgeUs;
+    }
+    
+    // Buttons: a change is taken on its first edge, then that button
+    // ignores its own bounces for the debounce time. Other buttons are not
+    // held by it.
+    for (int i = 0; i < buttonCount; i++) {
+        Button& button = buttons[i];
+        bool pressed = ((pins >> button.pin) & 1) == 0;
+        if (pressed == button.pressed || timeUs - button.changedUs < DEBOUNCE_US) {
+            continue;
+        }
+        
+        button.pressed = pressed;
+        button.changedUs = timeUs;
+        if (pressed) {
+            button.longPressed = false;
+            LOG_DEBUG("Button press started");
+        } else if (!button.longPressed) {
+            LOG_DEBUG("Button short pressed");
+            push(InputEventType::CLICK, (uint8_t)i, 0, timeUs);
+        }
+    }
+}
+
+bool InputScanner::poll(InputEvent& event) {
+    if (queueCount == 0) {
+        return false;
+    }
+    
+    event = queue[queueHead];
+    queueHead = (queueHead + 1) % INPUT_EVENT_QUEUE;
+    queueCount--;
+    return true;
+}
+
+void InputScanner::push(InputEventType type, uint8_t source, int16_t steps, uint32_t timeUs) {
+    if (queueCount >= INPUT_EVENT_QUEUE) {
+        droppedEvents++;
+        return;
+    }
+    
+    InputEvent& event = queue[(queueHead + queueCount) % INPUT_EVENT_QUEUE];
+    event.type = type;
+    event.source = source;
+    event.steps = steps;
+    event.timeUs = timeUs;
+    queueCount++;
+}
+
+void InputScanner::setSnapshotSource(const PinSnapshot& source) {
+    snapshotSource = (source != nullptr) ? source : PinSnapshot::bind<defaultSnapshot>();
+}
+
+uint32_t InputScanner::readPins() const {
+    return snapshotSource();
+}
+
+uint32_t InputScanner::getPinMask() const {
+    return pinMask;
+}
+
+void InputScanner::setTrace(InputTrace* inputTrace) {
+    trace = inputTrace;
+}
+
+uint32_t InputScanner::getDroppedEvents() const {
+    return droppedEvents;
+}
+
+uint32_t InputScanner::getDroppedSamples() const {
+    return droppedSamples;
+}
@@ -0,0 +1,109 @@
+#ifndef INPUT_SCANNER_H
+#define INPUT_SCANNER_H
+
+#include <stdint.h>
+#include "config.h"
+#include "delegate.h"
+
+class InputTrace;
+
+enum class InputEventType : uint8_t {
+    ROTATE,         // steps: net quadrature steps (+ clockwise)
+    CLICK,          // Short press, reported on release
+    LONG_PRESS      // Held for ENCODER_LONG_PRESS_MS, reported while held
+};
+
+struct InputEvent {
+    InputEventType type;
+    uint8_t source;     // Encoder or button id (from addEncoder / addButton)
+    int16_t steps;
+    uint32_t timeUs;    // Edge time as latched by the interrupt, low 32 bits of Clock::nowMicros()
+};
+
+// Pin snapshot source: bit n is the level of GPIO n
+typedef Delegate<uint32_t()> PinSnapshot;
+
+// All encoders and buttons, read from one GPIO register snapshot per edge.
+//
+// The pin-change interrupt of every registered pin only latches the GPIO
+// input register and esp_timer_get_time() into a ring in DRAM (latch()),
+// so nothing it touches lives in flash. update() (main loop) decodes the
+// samples in order - quadrature steps, a debounce lockout per button,
+// tracing - and then the pins as they are now, and turns the results into
+// events on one queue.
+class InputScanner {
+public:
+    InputScanner();
+    
+    // Registration (before begin); return the source id, or -1 when full
+    int addEncoder(uint8_t clkPin, uint8_t dtPin);
+    int addButton(uint8_t pin);
+    
+    // Configure pins and interrupts
+    void begin();
+    // Re-read every input as its idle state (no events)
+    void reset();
+    
+    // Interrupt entry (IRAM): queue one pin sample for update(). Replay and
+    // tests call it directly with recorded levels and times.
+    void latch(uint32_t pins, uint32_t timeUs);
+    void update();
+    bool poll(InputEvent& event);
+    
+    // Snapshot source for update() (GPIO input register by default, nullptr
+    // restores it); never called from the interrupt
+    void setSnapshotSource(const PinSnapshot& source);
+    uint32_t readPins() const;
+    uint32_t getPinMask() const;
+    
+    void setTrace(InputTrace* inputTrace);
+    uint32_t getDroppedEvents() const;
+    uint32_t getDroppedSamples() const;     // Edges lost to a full sample ring
+
+private:
+    struct Encoder {
+        uint8_t clkPin;
+        uint8_t dtPin;
+        uint8_t state;          // (CLK << 1) | DT
+        int32_t position;       // Quadrature steps decoded so far
+        int32_t reported;       // Position already turned into events
+        uint32_t lastEdgeUs;
+    };
+    
+    struct Button {
+        uint8_t pin;
+        bool pressed;           // Debounced (active low)
+        bool longPressed;
+        uint32_t changedUs;     // Last debounced change; starts this button's lockout
+    };
+    
+    struct PinSample {
+        uint32_t pins;
+        uint32_t timeUs;
+    };
+    
+    Encoder encoders[MAX_INPUT_ENCODERS];
+    int encoderCount;
+    Button buttons[MAX_INPUT_BUTTONS];
+    int buttonCount;
+    uint32_t pinMask;           // GPIO bits of every registered pin
+    
+    // Written by the interrupt (head) and update() (tail) only
+    PinSample samples[INPUT_SAMPLE_RING];
+    volatile uint8_t sampleHead;
+    volatile uint8_t sampleTail;
+    volatile uint32_t droppedSamples;
+    
+    InputEvent queue[INPUT_EVENT_QUEUE];
+    uint8_t queueHead;
+    uint8_t queueCount;
+    uint32_t droppedEvents;
+    
+    PinSnapshot snapshotSource;
+    InputTrace* trace;
+    
+    void decode(uint32_t pins, uint32_t timeUs);
+    void push(InputEventType type, uint8_t source, int16_t steps, uint32_t timeUs);
+};
+
+#endif // INPUT_SCANNER_H
@@ -0,0 +1,167 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "input_trace.h"
+#include "input_scanner.h"
+#include "clock.h"
+#include "logger.h"
+#include <stdio.h>
+
+InputTrace::InputTrace()
+    : count(0), recording(false), dumped(false), initialPins(0), lastPins(0), lastEventUs(0) {
+}
+
+void InputTrace::start(uint32_t pins) {
+    recording = false;
+    clear(pins);
+    lastEventUs = (uint32_t)Clock::nowMicros();
+    dumped = false;
+    recording = true;
+}
+
+void InputTrace::stop() {
+    recording = false;
+}
+
+bool InputTrace::isRecording() const {
+    return recording;
+}
+
+bool InputTrace::isFull() const {
+    return count >= INPUT_TRACE_CAPACITY;
+}
+
+void InputTrace::record(uint32_t pins, uint32_t timeUs) {
+    // Main loop only; gaps over 71 minutes are recorded short
+    if (!recording || pins == lastPins) {
+        return;
+    }
+    
+    if (append(timeUs - lastEventUs, pins)) {
+        lastEventUs = timeUs;
+    } else {
+        recording = false;
+    }
+}
+
+void InputTrace::update() {
+    if (recording && isFull()) {
+        recording = false;
+    }
+    if (!recording && !dumped && count > 0) {
+        dump();
+        dumped = true;
+    }
+}
+
+// Dumps go to serial on the device and stdout on host
+static void dumpLine(const char* line) {
+#ifdef ARDUINO
+    Serial.println(line);
+#else
+    printf("%s\n", line);
+#endif
+}
+
+void InputTrace::dump() {
+    char line[32];
+    
+    snprintf(line, sizeof(line), "# input-trace v2 %lx", (unsigned long)initialPins);
+    dumpLine(line);
+    for (int i = 0; i < count; i++) {
+        snprintf(line, sizeof(line), "%lu %lx", (unsigned long)events[i].deltaUs, (unsigned long)events[i].pins);
+        dumpLine(line);
+    }
+    dumpLine("# end");
+    
+    LOG_INFOF("Input trace dumped (%d edges)", (int)count);
+}
+
+void InputTrace::clear(uint32_t pins) {
+    count = 0;
+    initialPins = pins;
+    lastPins = pins;
+}
+
+bool InputTrace::append(uint32_t deltaUs, uint32_t pins) {
+    if (count >= INPUT_TRACE_CAPACITY) {
+        return false;
+    }
+    
+    events[count].deltaUs = deltaUs;
+    events[count].pins = pins;
+    lastPins = pins;
+    count++;
+    return true;
+}
+
+bool InputTrace::parseLine(const char* line) {
+    unsigned long deltaUs;
+    unsigned long pins;
+    
+    if (sscanf(line, "# input-trace v2 %lx", &pins) == 1) {
+        clear((uint32_t)pins);
+        return true;
+    }
+    if (sscanf(line, "%lu %lx", &deltaUs, &pins) == 2) {
+        return append((uint32_t)deltaUs, (uint32_t)pins);
+    }
+    return false; // Comments, log lines
+}
+
+int InputTrace::getCount() const {
+    return count;
+}
+
+const TraceEvent& InputTrace::getEvent(int index) const {
+    return events[index];
+}
+
+// ============================================================================
+// Replay
+// ============================================================================
+
+static uint64_t replayNow = 0;
+static uint32_t replayPins = 0;
+
+static uint64_t replayClock() {
+    return replayNow;
+}
+
+static uint32_t replaySnapshot() {
+    return replayPins;
+}
+
+void InputTrace::replay(InputScanner& scanner, const ReplayStep& step, uint32_t loopIntervalUs, uint32_t tailUs) {
+    recording = false;
+    replayNow = US_PER_SEC;
+    replayPins = initialPins;
+    Clock::setSource(replayClock);
+    scanner.setSnapshotSource(replaySnapshot);
+    scanner.reset();
+    
+    uint64_t nextStep = replayNow;
+    uint64_t edgeTime = replayNow;
+    for (int i = 0; i <= count; i++) {
+        bool tail = (i == count);
+        edgeTime += tail ? tailUs : events[i].deltaUs;
+        
+        // Loop iterations due before the edge
+        while (nextStep <= edgeTime) {
+            replayNow = nextStep;
+            step();
+            nextStep += loopIntervalUs;
+        }
+        if (tail) {
+            break;
+        }
+        
+        // The edge itself, through the pin-change interrupt's entry point
+        replayNow = edgeTime;
+        replayPins = events[i].pins;
+        scanner.latch(replayPins, (uint32_t)replayNow);
+    }
+    
+    scanner.setSnapshotSource(nullptr);
+    Clock::setSource(nullptr);
+}
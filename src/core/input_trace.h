@@ -0,0 +1,64 @@
+#ifndef INPUT_TRACE_H
+#define INPUT_TRACE_H
+
+#include <stdint.h>
+#include "config.h"
+#include "delegate.h"
+
+class InputScanner;
+
+struct TraceEvent {
+    uint32_t deltaUs;   // Since the previous event (the first: since start())
+    uint32_t pins;      // GPIO levels of the scanner's pins after the edge
+};
+
+// One iteration of the main loop, run by replay() on the virtual clock
+typedef Delegate<void()> ReplayStep;
+
+// Recorder for encoder and button edges, and a replayer that feeds them
+// back through the input scanner's interrupt entry (latch()) and polling
+// paths on a virtual clock.
+//
+// Trace file (text, as dumped over serial):
+//   # input-trace v2 <initial pins, hex>
+//   <delta us> <pins, hex>        one line per edge
+//   # end
+class InputTrace {
+public:
+    InputTrace();
+    
+    // Recording (record() is called from InputScanner::update() only, with
+    // the time the interrupt latched)
+    void start(uint32_t initialPins);
+    void stop();
+    bool isRecording() const;
+    bool isFull() const;
+    void record(uint32_t pins, uint32_t timeUs);
+    
+    // Dump the trace once it fills up (call in main loop)
+    void update();
+    void dump();
+    
+    // Building a trace on host (from a dump or by hand)
+    void clear(uint32_t initialPins);
+    bool append(uint32_t deltaUs, uint32_t pins);
+    bool parseLine(const char* line);
+    int getCount() const;
+    const TraceEvent& getEvent(int index) const;
+    
+    // Play the trace into a scanner. Virtual time starts at 1 s and only
+    // moves between steps: step runs every loopIntervalUs, pin edges
+    // land in between, and tailUs of idle steps follow the last edge.
+    void replay(InputScanner& scanner, const ReplayStep& step, uint32_t loopIntervalUs, uint32_t tailUs);
+
+private:
+    TraceEvent events[INPUT_TRACE_CAPACITY];
+    volatile int count;
+    volatile bool recording;
+    bool dumped;
+    uint32_t initialPins;
+    uint32_t lastPins;
+    uint32_t lastEventUs;
+};
+
+#endif // INPUT_TRACE_H
@@ -0,0 +1,81 @@
+#include "latency.h"
+#include "clock.h"
+#include "logger.h"
+
+static const char* const channelNames[LATENCY_CHANNELS] = { "LED", "OLED" };
+
+LatencyProbe::LatencyProbe() {
+    reset();
+}
+
+void LatencyProbe::markInput(uint32_t inputMicros) {
+    // Measure from the oldest input not yet shown
+    for (int c = 0; c < LATENCY_CHANNELS; c++) {
+        if (!channels[c].pending) {
+            channels[c].pending = true;
+            channels[c].inputMicros = inputMicros;
+        }
+    }
+}
+
+void LatencyProbe::markOutput(LatencyChannel channel) {
+    Channel& ch = channels[(int)channel];
+    if (!ch.pending) {
+        return;
+    }
+    
+    ch.pending = false;
+    ch.samples[ch.next] = (uint32_t)Clock::nowMicros() - ch.inputMicros;
+    ch.next = (ch.next + 1) % LATENCY_SAMPLES;
+    if (ch.count < LATENCY_SAMPLES) {
+        ch.count++;
+    }
+}
+
+bool LatencyProbe::getStats(LatencyChannel channel, LatencyStats& stats) const {
+    const Channel& ch = channels[(int)channel];
+    stats.count = ch.count;
+    stats.p50Us = 0;
+    stats.p99Us = 0;
+    stats.maxUs = 0;
+    if (ch.count == 0) {
+        return false;
+    }
+    
+    // Insertion sort of a copy: at most LATENCY_SAMPLES entries
+    uint32_t sorted[LATENCY_SAMPLES];
+    for (int i = 0; i < ch.count; i++) {
+        uint32_t value = ch.samples[i];
+        int j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            j--;
+        }
+        sorted[j] = value;
+    }
+    
+    stats.p50Us = sorted[(ch.count - 1) * 50 / 100];
+    stats.p99Us = sorted[(ch.count - 1) * 99 / 100];
+    stats.maxUs = sorted[ch.count - 1];
+    return true;
+}
+
+void LatencyProbe::log() const {
+    for (int c = 0; c < LATENCY_CHANNELS; c++) {
+        LatencyStats stats;
+        if (getStats((LatencyChannel)c, stats)) {
+            LOG_INFOF("Input->%s latency: p50 %lu us, p99 %lu us, max %lu us (%u samples)",
+                      channelNames[c], (unsigned long)stats.p50Us, (unsigned long)stats.p99Us,
+                      (unsigned long)stats.maxUs, (unsigned)stats.count);
+        }
+    }
+}
+
+void LatencyProbe::reset() {
+    for (int c = 0; c < LATENCY_CHANNELS; c++) {
+        channels[c].pending = false;
+        channels[c].inputMicros = 0;
+        channels[c].count = 0;
+        channels[c].next = 0;
+    }
+}
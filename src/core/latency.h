@@ -0,0 +1,50 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+#include "config.h"
+
+// Outputs an input can show up on
+enum class LatencyChannel {
+    LED,
+    OLED
+};
+
+#define LATENCY_CHANNELS 2
+
+struct LatencyStats {
+    uint16_t count;     // Samples in the window
+    uint32_t p50Us;
+    uint32_t p99Us;
+    uint32_t maxUs;
+};
+
+// Input-to-output latency. markInput() opens a measurement on every
+// channel that has none pending; the channel's next frame showing an
+// input closes it (LED: a changed frame rendered from new non-time inputs,
+// OLED: a flush whose input-driven content changed). Percentiles cover the last LATENCY_SAMPLES per
+// channel.
+class LatencyProbe {
+public:
+    LatencyProbe();
+    
+    void markInput(uint32_t inputMicros);   // Low 32 bits of Clock::nowMicros()
+    void markOutput(LatencyChannel channel);
+    
+    bool getStats(LatencyChannel channel, LatencyStats& stats) const;
+    void log() const;
+    void reset();
+
+private:
+    struct Channel {
+        bool pending;
+        uint32_t inputMicros;
+        uint32_t samples[LATENCY_SAMPLES];
+        uint16_t count;
+        uint16_t next;
+    };
+    
+    Channel channels[LATENCY_CHANNELS];
+};
+
+#endif // LATENCY_H
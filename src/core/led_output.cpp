@@ -0,0 +1,210 @@
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include "led_output.h"
+#include "clock.h"
+#include "logger.h"
+#include <string.h>
+
+#if LED_OUTPUT_RMT || !defined(ARDUINO)
+// GRB wire bytes with global brightness (same scale8 FastLED applies)
+static void encodeWireFrame(uint8_t* wire, const CRGB* frame, int count, uint8_t brightness) {
+    for (int i = 0; i < count; i++) {
+        wire[i * 3 + 0] = scale8(frame[i].g, brightness);
+        wire[i * 3 + 1] = scale8(frame[i].r, brightness);
+        wire[i * 3 + 2] = scale8(frame[i].b, brightness);
+    }
+}
+#endif
+
+#ifdef ARDUINO
+
+// ==========================================
+// FastLED (blocking) backend
+// ==========================================
+
+FastLEDOutput::FastLEDOutput() : controller(nullptr) {
+}
+
+bool FastLEDOutput::init(int numLeds) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        blankFrame[i] = CRGB::Black;
+    }
+    controller = &FastLED.addLeds<NEOPIXEL, LED_PIN>(blankFrame, min(numLeds, NUM_LEDS));
+    FastLED.show();
+    return true;
+}
+
+bool FastLEDOutput::submit(const CRGB* frame, int numLeds) {
+    if (controller == nullptr) {
+        return false;
+    }
+    
+    // FastLED only reads the frame during show()
+    controller->setLeds(const_cast<CRGB*>(frame), numLeds);
+    FastLED.show();
+    return true;
+}
+
+bool FastLEDOutput::isReady() const {
+    return true;
+}
+
+void FastLEDOutput::setBrightness(uint8_t brightness) {
+    FastLED.setBrightness(brightness);
+}
+
+#endif
+
+#if LED_OUTPUT_RMT && defined(ARDUINO)
+
+// ==========================================
+// RMT (asynchronous) backend
+// ==========================================
+
+// WS2812 bit timings in 25 ns ticks (80 MHz APB / clk_div 2)
+#define WS2812_T0H_TICKS 16     // 0.40 us
+#define WS2812_T0L_TICKS 34     // 0.85 us
+#define WS2812_T1H_TICKS 32     // 0.80 us
+#define WS2812_T1L_TICKS 18     // 0.45 us
+#define WS2812_RESET_TICKS (WS2812_RESET_MICROS * 40)
+
+static_assert(WS2812_RESET_TICKS < 32768, "Reset latch must fit one RMT duration field");
+
+// Converts wire bytes to RMT items on demand (runs in the RMT ISR)
+static void IRAM_ATTR ws2812Translator(const void* src, rmt_item32_t* dest, size_t srcSize,
+                                       size_t wantedItems, size_t* translatedSize, size_t* itemCount) {
+    static const rmt_item32_t bit0 = {{{ WS2812_T0H_TICKS, 1, WS2812_T0L_TICKS, 0 }}};
+    static const rmt_item32_t bit1 = {{{ WS2812_T1H_TICKS, 1, WS2812_T1L_TICKS, 0 }}};
+    
+    const uint8_t* bytes = (const uint8_t*)src;
+    size_t size = 0;
+    size_t items = 0;
+    
+    while (size < srcSize && items + 8 <= wantedItems) {
+        uint8_t value = bytes[size];
+        for (int bit = 7; bit >= 0; bit--) {
+            dest[items++].val = ((value >> bit) & 1) ? bit1.val : bit0.val;
+        }
+        size++;
+    }
+    
+    // Frame done: stretch the last low period into the reset latch, so
+    // the transfer (and rmt_wait_tx_done) only ends once the strip has
+    // latched and a back-to-back frame cannot run into this one
+    if (size == srcSize && items > 0) {
+        dest[items - 1].duration1 = WS2812_RESET_TICKS;
+    }
+    
+    *translatedSize = size;
+    *itemCount = items;
+}
+
+RmtLedOutput::RmtLedOutput(int pin, rmt_channel_t channel)
+    : pin(pin), channel(channel), brightness(255), installed(false) {
+}
+
+bool RmtLedOutput::init(int numLeds) {
+    rmt_config_t config = RMT_DEFAULT_CONFIG_TX((gpio_num_t)pin, channel);
+    config.clk_div = 2;
+    
+    if (rmt_config(&config) != ESP_OK ||
+        rmt_driver_install(channel, 0, 0) != ESP_OK ||
+        rmt_translator_init(channel, ws2812Translator) != ESP_OK) {
+        LOG_ERROR("RMT LED output init failed");
+        return false;
+    }
+    
+    installed = true;
+    LOG_INFO("RMT LED output initialized");
+    
+    // Latch a blank frame
+    memset(wireBuffer, 0, sizeof(wireBuffer));
+    return rmt_write_sample(channel, wireBuffer, min(numLeds, NUM_LEDS) * 3, false) == ESP_OK;
+}
+
+bool RmtLedOutput::submit(const CRGB* frame, int numLeds) {
+    if (!installed || !isReady()) {
+        return false; // Previous frame still on the wire
+    }
+    
+    int count = min(numLeds, NUM_LEDS);
+    encodeWireFrame(wireBuffer, frame, count, brightness);
+    
+    return rmt_write_sample(channel, wireBuffer, count * 3, false) == ESP_OK;
+}
+
+bool RmtLedOutput::isReady() const {
+    return !installed || rmt_wait_tx_done(channel, 0) == ESP_OK;
+}
+
+void RmtLedOutput::setBrightness(uint8_t newBrightness) {
+    brightness = newBrightness;
+}
+
+#endif
+
+#ifndef ARDUINO
+
+// ==========================================
+// Host backend (simulated wire time)
+// ==========================================
+
+HostLedOutput::HostLedOutput(bool blocking)
+    : blocking(blocking), brightness(255), sentAt(0), wireMicros(0),
+      frames(0), rejected(0), blockedMicros(0) {
+}
+
+bool HostLedOutput::init(int numLeds) {
+    // Latch a blank frame, like the hardware backends
+    static const CRGB blank[NUM_LEDS] = {};
+    return submit(blank, numLeds);
+}
+
+bool HostLedOutput::submit(const CRGB* frame, int numLeds) {
+    if (!isReady()) {
+        rejected++;
+        return false; // Previous frame still on the wire
+    }
+    
+    uint64_t start = Clock::nowMicros();
+    int count = numLeds < NUM_LEDS ? numLeds : NUM_LEDS;
+    encodeWireFrame(wireBuffer, frame, count, brightness);
+    sentAt = start;
+    wireMicros = (uint64_t)count * WS2812_LED_MICROS + WS2812_RESET_MICROS;
+    frames++;
+    
+    if (blocking) {
+        while (!isReady()) {
+        }
+    }
+    
+    blockedMicros += Clock::elapsedSince(start);
+    return true;
+}
+
+bool HostLedOutput::isReady() const {
+    return Clock::elapsedSince(sentAt) >= wireMicros;
+}
+
+void HostLedOutput::setBrightness(uint8_t newBrightness) {
+    brightness = newBrightness;
+}
+
+const uint8_t* HostLedOutput::getWireFrame() const {
+    return wireBuffer;
+}
+
+uint32_t HostLedOutput::getFrameCount() const {
+    return frames;
+}
+
+uint32_t HostLedOutput::getRejectedCount() const {
+    return rejected;
+}
+
+uint64_t HostLedOutput::getBlockedMicros() const {
+    return blockedMicros;
+}
+
+#endif
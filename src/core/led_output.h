@@ -0,0 +1,103 @@
+#ifndef LED_OUTPUT_H
+#define LED_OUTPUT_H
+
+#include <FastLED.h>
+#include "config.h"
+
+// WS2812 wire time: 24 bits at 800 kHz per LED, then the line must stay
+// low for the reset latch before the next frame may start
+#define WS2812_LED_MICROS 30
+#define WS2812_RESET_MICROS 300
+
+// LED output driver. submit() hands a finished frame to the wire and
+// returns without waiting where the backend allows it; isReady() reports
+// whether the previous frame has finished transmitting.
+class LedOutput {
+public:
+    virtual ~LedOutput() {}
+    
+    virtual bool init(int numLeds) = 0;
+    virtual bool submit(const CRGB* frame, int numLeds) = 0;
+    virtual bool isReady() const = 0;
+    virtual void setBrightness(uint8_t brightness) = 0;
+};
+
+#ifdef ARDUINO
+// Blocking backend: FastLED.show() on the frame
+class FastLEDOutput : public LedOutput {
+public:
+    FastLEDOutput();
+    
+    bool init(int numLeds) override;
+    bool submit(const CRGB* frame, int numLeds) override;
+    bool isReady() const override;
+    void setBrightness(uint8_t brightness) override;
+
+private:
+    CLEDController* controller;
+    CRGB blankFrame[NUM_LEDS];
+};
+#endif
+
+#if LED_OUTPUT_RMT && defined(ARDUINO)
+#include <driver/rmt.h>
+
+// Non-blocking ESP32-C3 RMT backend for WS2812 strips. The frame is
+// copied (GRB, brightness applied) into a wire buffer that the RMT
+// translator encodes from its ISR, so the next frame can be rendered
+// while this one is transmitted. The last bit is followed by the reset
+// latch, so isReady() only turns true once the strip has latched.
+class RmtLedOutput : public LedOutput {
+public:
+    RmtLedOutput(int pin, rmt_channel_t channel = RMT_CHANNEL_0);
+    
+    bool init(int numLeds) override;
+    bool submit(const CRGB* frame, int numLeds) override;
+    bool isReady() const override;
+    void setBrightness(uint8_t brightness) override;
+
+private:
+    int pin;
+    rmt_channel_t channel;
+    uint8_t brightness;
+    bool installed;
+    uint8_t wireBuffer[NUM_LEDS * 3];
+};
+#endif
+
+#ifndef ARDUINO
+// Host backend: encodes frames like RmtLedOutput and simulates the WS2812
+// wire time on Clock. A blocking output spins in submit() for the whole
+// transfer like FastLED.show() (it needs a clock that moves on its own);
+// otherwise submit() returns at once and isReady() stays false until the
+// transfer and the reset latch are over.
+class HostLedOutput : public LedOutput {
+public:
+    HostLedOutput(bool blocking);
+    
+    bool init(int numLeds) override;
+    bool submit(const CRGB* frame, int numLeds) override;
+    bool isReady() const override;
+    void setBrightness(uint8_t brightness) override;
+    
+    // Last frame sent (GRB, brightness applied)
+    const uint8_t* getWireFrame() const;
+    uint32_t getFrameCount() const;
+    uint32_t getRejectedCount() const;
+    
+    // Time submit() held the caller, summed over all frames
+    uint64_t getBlockedMicros() const;
+
+private:
+    bool blocking;
+    uint8_t brightness;
+    uint64_t sentAt;
+    uint64_t wireMicros;
+    uint32_t frames;
+    uint32_t rejected;
+    uint64_t blockedMicros;
+    uint8_t wireBuffer[NUM_LEDS * 3];
+};
+#endif
+
+#endif
@@ -1,13 +1,25 @@
+#ifdef ARDUINO
 #include <Arduino.h>
+#else
+#include <stdio.h>
+#include "clock.h"
+#endif
 #include <stdarg.h>
 #include "logger.h"
 
 void Logger::init() {
     if (isEnabled()) {
+#ifdef ARDUINO
         Serial.begin(SERIAL_BAUD_RATE);
-        while (!Serial && millis() < 5000) {
-            // Wait for serial connection or timeout after 5 seconds
+#endif
+        
+#if defined(ARDUINO) && SERIAL_WAIT_MS > 0
+        // Give a monitor time to attach; by default boot never blocks on
+        // it and lines logged before the host attaches are lost
+        unsigned long start = millis();
+        while (!Serial && millis() - start < SERIAL_WAIT_MS) {
         }
+#endif
         info("Logger initialized");
     }
 }
@@ -15,23 +27,33 @@ void Logger::init() {
 void Logger::log(LogLevel level, const char* message) {
     if (!isEnabled()) return;
     
+#ifdef ARDUINO
     Serial.print("[");
     Serial.print(millis());
     Serial.print("] ");
     Serial.print(getLevelString(level));
     Serial.print(": ");
     Serial.println(message);
+#else
+    // Host builds (native tests) log to stdout
+    printf("[%lu] %s: %s\n", (unsigned long)Clock::nowMillis(), getLevelString(level), message);
+#endif
 }
 
 void Logger::logf(LogLevel level, const char* format, ...) {
-    if (!isEnabled()) return;
-    
-    char buffer[256];
     va_list args;
     va_start(args, format);
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    vlogf(level, format, args);
     va_end(args);
+}
+
+// The only format buffer: every *f variant lands here, so a formatted log
+// line costs one LOG_LINE_MAX frame (longer lines are truncated)
+void Logger::vlogf(LogLevel level, const char* format, va_list args) {
+    if (!isEnabled()) return;
     
+    char buffer[LOG_LINE_MAX];
+    vsnprintf(buffer, sizeof(buffer), format, args);
     log(level, buffer);
 }
 
@@ -54,37 +76,29 @@ void Logger::error(const char* message) {
 void Logger::debugf(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    vlogf(LogLevel::DEBUG, format, args);
     va_end(args);
-    debug(buffer);
 }
 
 void Logger::infof(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    vlogf(LogLevel::INFO, format, args);
     va_end(args);
-    info(buffer);
 }
 
 void Logger::warningf(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    vlogf(LogLevel::WARNING, format, args);
     va_end(args);
-    warning(buffer);
 }
 
 void Logger::errorf(const char* format, ...) {
     va_list args;
     va_start(args, format);
-    char buffer[256];
-    vsnprintf(buffer, sizeof(buffer), format, args);
+    vlogf(LogLevel::ERROR, format, args);
     va_end(args);
-    error(buffer);
 }
 
 const char* Logger::getLevelString(LogLevel level) {
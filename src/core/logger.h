@@ -1,6 +1,7 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include <stdarg.h>
 #include "config.h"
 
 // Log levels
@@ -29,6 +30,7 @@ public:
     static void errorf(const char* format, ...);
 
 private:
+    static void vlogf(LogLevel level, const char* format, va_list args);
     static const char* getLevelString(LogLevel level);
     static bool isEnabled();
 };
@@ -0,0 +1,161 @@
+#include "pixel_ops.h"
+#include <string.h>
+
+// Even bytes of a word as two 16-bit lanes; odd bytes are handled by
+// shifting down first. A lane holds at most 255 * 256, so no carries
+// cross into the neighbouring lane.
+#define LANES_EVEN 0x00FF00FFUL
+#define LANES_ODD  0xFF00FF00UL
+
+#if FASTLED_SCALE8_FIXED == 1
+#define SCALE8_WEIGHT(scale) ((uint16_t)((scale) + 1))
+#else
+#define SCALE8_WEIGHT(scale) ((uint16_t)(scale))
+#endif
+
+static inline uint32_t loadWord(const uint8_t* p) {
+    uint32_t word;
+    memcpy(&word, p, sizeof(word));
+    return word;
+}
+
+static inline void storeWord(uint8_t* p, uint32_t word) {
+    memcpy(p, &word, sizeof(word));
+}
+
+static inline bool isWordAligned(const void* p) {
+    return ((uintptr_t)p & 3) == 0;
+}
+
+// (c * weight) >> 8 per byte, weight in 0..256
+static inline uint32_t scaleWord(uint32_t x, uint16_t weight) {
+    uint32_t even = (((x & LANES_EVEN) * weight) >> 8) & LANES_EVEN;
+    uint32_t odd = (((x >> 8) & LANES_EVEN) * weight) & LANES_ODD;
+    return even | odd;
+}
+
+// 0x01 in every non-zero byte
+static inline uint32_t nonZeroBytes(uint32_t x) {
+    return ((((x & 0x7F7F7F7FUL) + 0x7F7F7F7FUL) | x) >> 7) & 0x01010101UL;
+}
+
+// qadd8 per byte
+static inline uint32_t addSaturateWord(uint32_t a, uint32_t b) {
+    uint32_t even = (a & LANES_EVEN) + (b & LANES_EVEN);
+    uint32_t odd = ((a >> 8) & LANES_EVEN) + ((b >> 8) & LANES_EVEN);
+    even |= ((even >> 8) & 0x00010001UL) * 0xFF;
+    odd |= ((odd >> 8) & 0x00010001UL) * 0xFF;
+    return (even & LANES_EVEN) | ((odd & LANES_EVEN) << 8);
+}
+
+// Per-byte operations (word and tail forms must agree)
+struct ScaleOp {
+    uint16_t weight;
+    uint32_t word(uint32_t x) const { return scaleWord(x, weight); }
+    uint8_t byte(uint8_t x) const { return (uint8_t)((x * weight) >> 8); }
+};
+
+struct ScaleVideoOp {
+    uint8_t scale;
+    uint32_t word(uint32_t x) const {
+        return scaleWord(x, scale) + (scale ? nonZeroBytes(x) : 0);
+    }
+    uint8_t byte(uint8_t x) const {
+        return (x == 0) ? 0 : (uint8_t)(((x * scale) >> 8) + (scale ? 1 : 0));
+    }
+};
+
+struct AddScaledOp {
+    uint16_t weight;
+    uint32_t word(uint32_t a, uint32_t b) const { return addSaturateWord(a, scaleWord(b, weight)); }
+    uint8_t byte(uint8_t a, uint8_t b) const { return qadd8(a, (uint8_t)((b * weight) >> 8)); }
+};
+
+struct LerpOp {
+    uint16_t weight;
+    uint32_t word(uint32_t a, uint32_t b) const {
+        uint16_t inverse = 256 - weight;
+        uint32_t even = ((((a & LANES_EVEN) * inverse) + ((b & LANES_EVEN) * weight)) >> 8) & LANES_EVEN;
+        uint32_t odd = ((((a >> 8) & LANES_EVEN) * inverse) + (((b >> 8) & LANES_EVEN) * weight)) & LANES_ODD;
+        return even | odd;
+    }
+    uint8_t byte(uint8_t a, uint8_t b) const {
+        return (uint8_t)((a * (256 - weight) + b * weight) >> 8);
+    }
+};
+
+// Channel-independent ops run over the raw byte span: scalar up to the
+// first aligned word of the destination, whole words, then a scalar tail
+template <typename Op>
+static void applyBytes(uint8_t* out, int length, const Op& op) {
+    int i = 0;
+    for (; i < length && !isWordAligned(out + i); i++) {
+        out[i] = op.byte(out[i]);
+    }
+    for (; i + 4 <= length; i += 4) {
+        storeWord(out + i, op.word(loadWord(out + i)));
+    }
+    for (; i < length; i++) {
+        out[i] = op.byte(out[i]);
+    }
+}
+
+template <typename Op>
+static void applyBytes(uint8_t* out, const uint8_t* a, const uint8_t* b, int length, const Op& op) {
+    int i = 0;
+    for (; i < length && !isWordAligned(out + i); i++) {
+        out[i] = op.byte(a[i], b[i]);
+    }
+    for (; i + 4 <= length; i += 4) {
+        storeWord(out + i, op.word(loadWord(a + i), loadWord(b + i)));
+    }
+    for (; i < length; i++) {
+        out[i] = op.byte(a[i], b[i]);
+    }
+}
+
+void fillPixels(CRGB* leds, int numLeds, CRGB color) {
+    // Align to a word boundary (at most three pixels), then store four
+    // pixels as three words of the repeating RGBR GBRG BRGB pattern
+    int i = 0;
+    for (; i < numLeds && !isWordAligned(&leds[i]); i++) {
+        leds[i] = color;
+    }
+    
+    CRGB quad[4] = { color, color, color, color };
+    uint8_t* quadBytes = (uint8_t*)quad;
+    uint32_t w0 = loadWord(quadBytes);
+    uint32_t w1 = loadWord(quadBytes + 4);
+    uint32_t w2 = loadWord(quadBytes + 8);
+    
+    for (; i + 4 <= numLeds; i += 4) {
+        uint8_t* p = (uint8_t*)&leds[i];
+        storeWord(p, w0);
+        storeWord(p + 4, w1);
+        storeWord(p + 8, w2);
+    }
+    
+    for (; i < numLeds; i++) {
+        leds[i] = color;
+    }
+}
+
+void scalePixels(CRGB* leds, int numLeds, uint8_t scale) {
+    ScaleOp op = { SCALE8_WEIGHT(scale) };
+    applyBytes((uint8_t*)leds, numLeds * 3, op);
+}
+
+void scalePixelsVideo(CRGB* leds, int numLeds, uint8_t scale) {
+    ScaleVideoOp op = { scale };
+    applyBytes((uint8_t*)leds, numLeds * 3, op);
+}
+
+void addPixelsScaled(CRGB* dst, const CRGB* src, int numLeds, uint16_t weight) {
+    AddScaledOp op = { weight };
+    applyBytes((uint8_t*)dst, (const uint8_t*)dst, (const uint8_t*)src, numLeds * 3, op);
+}
+
+void lerpPixels(CRGB* out, const CRGB* from, const CRGB* to, int numLeds, uint16_t weight) {
+    LerpOp op = { weight };
+    applyBytes((uint8_t*)out, (const uint8_t*)from, (const uint8_t*)to, numLeds * 3, op);
+}
@@ -0,0 +1,26 @@
+#ifndef PIXEL_OPS_H
+#define PIXEL_OPS_H
+
+#include <FastLED.h>
+#include <stdint.h>
+
+// Span kernels over CRGB arrays. Channels are packed four to a 32-bit
+// word and processed as two 16-bit lanes (SIMD within a register); the
+// results match FastLED's per-pixel operations bit for bit.
+
+// leds[i] = color
+void fillPixels(CRGB* leds, int numLeds, CRGB color);
+
+// leds[i].nscale8(scale)
+void scalePixels(CRGB* leds, int numLeds, uint8_t scale);
+
+// leds[i].nscale8_video(scale)
+void scalePixelsVideo(CRGB* leds, int numLeds, uint8_t scale);
+
+// dst[i] += src[i] * weight / 256 (saturating), weight in 0..256
+void addPixelsScaled(CRGB* dst, const CRGB* src, int numLeds, uint16_t weight);
+
+// out[i] = from[i] + (to[i] - from[i]) * weight / 256, weight in 0..256
+void lerpPixels(CRGB* out, const CRGB* from, const CRGB* to, int numLeds, uint16_t weight);
+
+#endif // PIXEL_OPS_H
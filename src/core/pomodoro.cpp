@@ -0,0 +1,79 @@
+#include "pomodoro.h"
+
+PomodoroCycle::PomodoroCycle()
+    : active(false), currentType(SessionType::WORK), completedWork(0) {
+}
+
+void PomodoroCycle::start() {
+    active = true;
+    currentType = SessionType::WORK;
+    completedWork = 0;
+}
+
+void PomodoroCycle::stop() {
+    active = false;
+}
+
+SessionType PomodoroCycle::advance() {
+    SessionType next = getNextType();
+    
+    if (currentType == SessionType::WORK) {
+        completedWork++;
+    }
+    currentType = next;
+    
+    return currentType;
+}
+
+void PomodoroCycle::restore(SessionType type, uint16_t completedWork) {
+    active = true;
+    currentType = type;
+    this->completedWork = completedWork;
+}
+
+bool PomodoroCycle::isActive() const {
+    return active;
+}
+
+SessionType PomodoroCycle::getCurrentType() const {
+    return currentType;
+}
+
+SessionType PomodoroCycle::getNextType() const {
+    if (currentType != SessionType::WORK) {
+        return SessionType::WORK;
+    }
+    
+    // The work session in progress counts towards the long break
+    return ((completedWork + 1) % POMODORO_LONG_BREAK_INTERVAL == 0)
+        ? SessionType::LONG_BREAK
+        : SessionType::SHORT_BREAK;
+}
+
+uint16_t PomodoroCycle::getCompletedWorkSessions() const {
+    return completedWork;
+}
+
+unsigned long PomodoroCycle::getDurationMs(SessionType type) {
+    switch (type) {
+        case SessionType::SHORT_BREAK:
+            return POMODORO_SHORT_BREAK;
+        case SessionType::LONG_BREAK:
+            return POMODORO_LONG_BREAK;
+        case SessionType::WORK:
+        default:
+            return POMODORO_WORK_DURATION;
+    }
+}
+
+const char* PomodoroCycle::getLabel(SessionType type) {
+    switch (type) {
+        case SessionType::SHORT_BREAK:
+            return "SHORT BREAK";
+        case SessionType::LONG_BREAK:
+            return "LONG BREAK";
+        case SessionType::WORK:
+        default:
+            return "WORK";
+    }
+}
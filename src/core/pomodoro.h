@@ -0,0 +1,37 @@
+#ifndef POMODORO_H
+#define POMODORO_H
+
+#include <stdint.h>
+#include "types.h"
+#include "config.h"
+
+// Pomodoro cycle engine: WORK / SHORT_BREAK ... WORK / LONG_BREAK
+class PomodoroCycle {
+public:
+    PomodoroCycle();
+    
+    // Cycle control
+    void start();
+    void stop();
+    SessionType advance();
+    
+    // Continue a saved cycle (work sessions completed in the current round)
+    void restore(SessionType type, uint16_t completedWork);
+    
+    // State queries
+    bool isActive() const;
+    SessionType getCurrentType() const;
+    SessionType getNextType() const;
+    uint16_t getCompletedWorkSessions() const;
+    
+    // Session helpers
+    static unsigned long getDurationMs(SessionType type);
+    static const char* getLabel(SessionType type);
+
+private:
+    bool active;
+    SessionType currentType;
+    uint16_t completedWork;
+};
+
+#endif
@@ -0,0 +1,68 @@
+#include "sequence.h"
+
+Sequence::Sequence()
+    : resumeLine(0), run(0), wakeAt(0), waitEvents(0),
+      function(nullptr), markedAt(0), pendingEvents(0) {
+}
+
+void Sequence::start(const SequenceFunction& newFunction) {
+    function = newFunction;
+    resumeLine = 0;
+    run++;
+    wakeAt = 0;
+    waitEvents = 0;
+    pendingEvents = 0;
+    markedAt = Clock::nowMicros();
+}
+
+void Sequence::stop() {
+    function = nullptr;
+    resumeLine = 0;
+    waitEvents = 0;
+}
+
+bool Sequence::isRunning() const {
+    return function != nullptr;
+}
+
+void Sequence::update() {
+    if (function == nullptr || Clock::nowMicros() < wakeAt) {
+        return;
+    }
+    
+    // Woken by time or event: either way the wait is over
+    wakeAt = 0;
+    waitEvents = 0;
+    function(*this);
+}
+
+void Sequence::post(uint8_t events) {
+    pendingEvents |= events;
+    if (waitEvents & events) {
+        waitEvents = 0;
+        wakeAt = 0;
+    }
+}
+
+bool Sequence::consume(uint8_t events) {
+    bool posted = (pendingEvents & events) != 0;
+    pendingEvents &= (uint8_t)~events;
+    return posted;
+}
+
+void Sequence::mark() {
+    markedAt = Clock::nowMicros();
+}
+
+uint64_t Sequence::elapsedMicros() const {
+    return Clock::elapsedSince(markedAt);
+}
+
+bool Sequence::suspendForEvents(uint8_t events, uint64_t timeoutUs) {
+    if (pendingEvents & events) {
+        return false;
+    }
+    waitEvents = events;
+    wakeAt = (timeoutUs == SEQ_NEVER) ? SEQ_NEVER : Clock::nowMicros() + timeoutUs;
+    return true;
+}
@@ -0,0 +1,97 @@
+#ifndef SEQUENCE_H
+#define SEQUENCE_H
+
+#include <stdint.h>
+#include "clock.h"
+#include "delegate.h"
+
+class Sequence;
+typedef Delegate<void(Sequence&)> SequenceFunction;
+
+#define SEQ_NEVER UINT64_MAX
+
+// Stackless coroutine (protothread style) for timed sequences, written as
+// straight-line code between SEQ_BEGIN and SEQ_END:
+//
+//     void flash(Sequence& seq) {
+//         SEQ_BEGIN(seq);
+//         while (seq.elapsedMicros() < 3 * US_PER_SEC) {
+//             drawFrame();
+//             SEQ_YIELD(seq);
+//         }
+//         SEQ_SLEEP_MS(seq, 500);
+//         SEQ_AWAIT_EVENT(seq, EVENT_BUTTON);
+//         SEQ_AWAIT_EVENT_MS(seq, EVENT_BUTTON, 2000);
+//         if (!seq.consume(EVENT_BUTTON)) {
+//             timedOut();
+//         }
+//         SEQ_END(seq);
+//     }
+//
+// The only state is the resume point, a wake time and event bits, so a
+// sequence is a few bytes with no stack and no heap. A suspended sequence
+// costs one comparison per update() until its wake time or event.
+// Limitations of the technique: locals do not survive a suspension (keep
+// them in the Sequence or in globals) and the body cannot use 'switch'.
+class Sequence {
+public:
+    Sequence();
+    
+    // (Re)start from the top; the function runs on the next update()
+    void start(const SequenceFunction& function);
+    void stop();
+    bool isRunning() const;
+    
+    // Resume the sequence if it is due
+    void update();
+    
+    // Events: post() wakes a sequence awaiting any of the bits
+    void post(uint8_t events);
+    bool consume(uint8_t events);
+    
+    // Time since start() or the last mark()
+    void mark();
+    uint64_t elapsedMicros() const;
+    
+    // State used by the SEQ_* macros
+    uint16_t resumeLine;
+    uint16_t run;               // Bumped by start() so a restarted sequence is not stopped by SEQ_END
+    uint64_t wakeAt;
+    uint8_t waitEvents;
+    
+    bool suspendForEvents(uint8_t events, uint64_t timeoutUs = SEQ_NEVER);
+
+private:
+    SequenceFunction function;
+    uint64_t markedAt;
+    uint8_t pendingEvents;
+};
+
+#define SEQ_BEGIN(seq) \
+    { uint16_t seqRun = (seq).run; switch ((seq).resumeLine) { case 0:
+
+#define SEQ_END(seq) \
+    } if ((seq).run == seqRun) { (seq).stop(); } }
+
+// Resume on the next update()
+#define SEQ_YIELD(seq) \
+    do { (seq).resumeLine = __LINE__; return; case __LINE__:; } while (0)
+
+// Suspend for at least 'ms' milliseconds
+#define SEQ_SLEEP_MS(seq, ms) \
+    do { (seq).wakeAt = Clock::nowMicros() + MS_TO_US(ms); \
+         (seq).resumeLine = __LINE__; return; case __LINE__:; } while (0)
+
+// Suspend until any of 'events' is posted (consumed on wake)
+#define SEQ_AWAIT_EVENT(seq, events) \
+    do { if ((seq).suspendForEvents(events)) { (seq).resumeLine = __LINE__; return; } \
+         (seq).consume(events); break; \
+         case __LINE__: (seq).consume(events); } while (0)
+
+// Suspend until any of 'events' is posted or 'ms' milliseconds pass; the
+// events stay pending, so consume() afterwards tells which it was
+#define SEQ_AWAIT_EVENT_MS(seq, events, ms) \
+    do { if ((seq).suspendForEvents(events, MS_TO_US(ms))) { (seq).resumeLine = __LINE__; return; } \
+         break; case __LINE__:; } while (0)
+
+#endif // SEQUENCE_H
@@ -0,0 +1,216 @@
+#include "session_store.h"
+#include "timer.h"
+#include "pomodoro.h"
+#include "clock.h"
+#include "crc.h"
+#include "config.h"
+#include "logger.h"
+
+#define SESSION_RECORD_MARKER 0xB0      // Records of the older 0xA5 layout are ignored
+
+static_assert(POMODORO_LONG_BREAK_INTERVAL <= 64, "Cycle round is stored in 6 bits");
+
+SessionStore::SessionStore()
+    : partition(SESSION_PARTITION_LABEL), cycle(nullptr), slotCount(0), head(0),
+      nextSequence(1), hasLatest(false), lastSaveTime(0), savePending(false) {
+    latest.state = TimerState::STOPPED;
+    latest.durationMs = 0;
+    latest.elapsedMs = 0;
+    latest.cycleActive = false;
+    latest.sessionType = SessionType::WORK;
+    latest.cycleRound = 0;
+}
+
+bool SessionStore::init() {
+    if (!partition.init()) {
+        return false;
+    }
+    
+    const uint32_t slotsPerSector = FLASH_SECTOR_SIZE / sizeof(Record);
+    slotCount = partition.getSectorCount() * slotsPerSector;
+    if (slotCount == 0) {
+        return false;
+    }
+    
+    // Find the newest valid record
+    uint32_t latestSlot = 0;
+    uint32_t latestSequence = 0;
+    Record record;
+    
+    for (uint32_t slot = 0; slot < slotCount; slot++) {
+        if (!partition.read(slot * sizeof(Record), &record, sizeof(Record))) {
+            return false;
+        }
+        if (isValid(record) && record.sequence >= latestSequence) {
+            latestSequence = record.sequence;
+            latestSlot = slot;
+            decode(record, latest);
+            hasLatest = true;
+        }
+    }
+    
+    // Resume appending at the first blank slot after it, skipping torn
+    // records; if the sector has none left, the next append erases the
+    // following sector
+    head = 0;
+    if (hasLatest) {
+        nextSequence = latestSequence + 1;
+        head = latestSlot + 1;
+        
+        while (head % slotsPerSector != 0) {
+            if (!partition.read(head * sizeof(Record), &record, sizeof(Record))) {
+                return false;
+            }
+            if (isBlank(record)) {
+                break;
+            }
+            head++;
+        }
+        head %= slotCount;
+    }
+    
+    LOG_INFOF("Session store: %s (seq %lu, head %lu)",
+              hasLatest ? "recovered" : "empty",
+              (unsigned long)latestSequence, (unsigned long)head);
+    return true;
+}
+
+void SessionStore::setCycle(const PomodoroCycle* cycle) {
+    this->cycle = cycle;
+}
+
+bool SessionStore::loadLatest(SessionSnapshot& snapshot) const {
+    if (!hasLatest) {
+        return false;
+    }
+    
+    snapshot = latest;
+    return true;
+}
+
+bool SessionStore::save(const Timer& timer) {
+    SessionSnapshot snapshot;
+    snapshot.state = timer.getState();
+    snapshot.durationMs = timer.getDuration();
+    snapshot.elapsedMs = timer.getElapsed();
+    snapshot.cycleActive = (cycle != nullptr && cycle->isActive());
+    snapshot.sessionType = snapshot.cycleActive ? cycle->getCurrentType() : SessionType::WORK;
+    snapshot.cycleRound = snapshot.cycleActive
+        ? (uint8_t)(cycle->getCompletedWorkSessions() % POMODORO_LONG_BREAK_INTERVAL)
+        : 0;
+    
+    // Idle states carry no progress, so repeated writes are pure wear;
+    // neither is a record identical to the last one
+    if (hasLatest && ((snapshot.state == latest.state && !isActive(snapshot.state)) ||
+                      isSame(snapshot, latest))) {
+        savePending = false;
+        return true;
+    }
+    
+    // Pause toggling: keep one record per interval and write the state it
+    // ends in. Leaving the session (cancel, completion) is never deferred.
+    if (hasLatest && isActive(snapshot.state) && isActive(latest.state) &&
+        Clock::elapsedSince(lastSaveTime) < MS_TO_US(SESSION_MIN_SAVE_INTERVAL_MS)) {
+        savePending = true;
+        return true;
+    }
+    
+    savePending = false;
+    lastSaveTime = Clock::nowMicros();
+    return append(snapshot);
+}
+
+void SessionStore::update(const Timer& timer) {
+    uint64_t sinceSave = Clock::elapsedSince(lastSaveTime);
+    
+    if (savePending) {
+        if (sinceSave >= MS_TO_US(SESSION_MIN_SAVE_INTERVAL_MS)) {
+            save(timer);
+        }
+        return;
+    }
+    
+    if (timer.isRunning() && sinceSave >= MS_TO_US(SESSION_PERSIST_INTERVAL_MS)) {
+        save(timer);
+    }
+}
+
+uint32_t SessionStore::getEraseCount() const {
+    return partition.getEraseCount();
+}
+
+bool SessionStore::isSavePending() const {
+    return savePending;
+}
+
+bool SessionStore::append(const SessionSnapshot& snapshot) {
+    if (!partition.isReady()) {
+        return false;
+    }
+    
+    const uint32_t slotsPerSector = FLASH_SECTOR_SIZE / sizeof(Record);
+    
+    // Entering a new sector: reclaim it (it only holds the oldest records)
+    if (head % slotsPerSector == 0) {
+        if (!partition.eraseSector(head / slotsPerSector)) {
+            LOG_ERROR("Session store: sector erase failed");
+            return false;
+        }
+    }
+    
+    Record record;
+    record.sequence = nextSequence;
+    record.durationMs = snapshot.durationMs;
+    record.elapsedMs = snapshot.elapsedMs;
+    record.magic = SESSION_RECORD_MARKER | (((uint8_t)snapshot.sessionType & 0x03) << 1) |
+                   (snapshot.cycleActive ? 0x01 : 0x00);
+    record.state = ((uint8_t)snapshot.state & 0x03) | ((snapshot.cycleRound & 0x3F) << 2);
+    record.crc = crc16(&record, sizeof(Record) - sizeof(record.crc));
+    
+    if (!partition.write(head * sizeof(Record), &record, sizeof(Record))) {
+        // The slot may be partly programmed; never write over it again
+        LOG_ERROR("Session store: record write failed");
+        head = (head + 1) % slotCount;
+        return false;
+    }
+    
+    head = (head + 1) % slotCount;
+    nextSequence++;
+    latest = snapshot;
+    hasLatest = true;
+    return true;
+}
+
+void SessionStore::decode(const Record& record, SessionSnapshot& snapshot) {
+    snapshot.state = (TimerState)(record.state & 0x03);
+    snapshot.durationMs = record.durationMs;
+    snapshot.elapsedMs = record.elapsedMs;
+    snapshot.cycleActive = (record.magic & 0x01) != 0;
+    snapshot.sessionType = (SessionType)((record.magic >> 1) & 0x03);
+    snapshot.cycleRound = record.state >> 2;
+}
+
+bool SessionStore::isActive(TimerState state) {
+    return state == TimerState::RUNNING || state == TimerState::PAUSED;
+}
+
+bool SessionStore::isSame(const SessionSnapshot& a, const SessionSnapshot& b) {
+    return a.state == b.state && a.durationMs == b.durationMs && a.elapsedMs == b.elapsedMs &&
+           a.cycleActive == b.cycleActive && a.sessionType == b.sessionType &&
+           a.cycleRound == b.cycleRound;
+}
+
+bool SessionStore::isBlank(const Record& record) {
+    const uint8_t* bytes = (const uint8_t*)&record;
+    for (size_t i = 0; i < sizeof(Record); i++) {
+        if (bytes[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SessionStore::isValid(const Record& record) {
+    return (record.magic & 0xF0) == SESSION_RECORD_MARKER &&
+           record.crc == crc16(&record, sizeof(Record) - sizeof(record.crc));
+}
@@ -0,0 +1,85 @@
+#ifndef SESSION_STORE_H
+#define SESSION_STORE_H
+
+#include <stdint.h>
+#include "types.h"
+#include "flash.h"
+
+class Timer;
+class PomodoroCycle;
+
+// Persisted view of the running session
+struct SessionSnapshot {
+    TimerState state;
+    uint32_t durationMs;
+    uint32_t elapsedMs;
+    bool cycleActive;
+    SessionType sessionType;    // Only meaningful in a cycle
+    uint8_t cycleRound;         // Work sessions completed towards the long break
+};
+
+// Append-only session log in a raw flash partition.
+// Fixed 16-byte records are written sequentially; a sector is erased only
+// when the write head enters it, so wear is spread evenly across the
+// partition. At boot the record with the highest sequence number and a
+// valid CRC wins, which makes torn writes and torn erases harmless.
+// A 4 KiB sector holds 256 records. The default 30 s checkpoint writes
+// ~2880 records/day, about 11 sectors, so each of the 4 sectors is erased
+// about 3 times per day. Pause/resume saves closer together than
+// SESSION_MIN_SAVE_INTERVAL_MS are coalesced into one deferred record, so
+// toggling pause cannot write faster than one record per interval.
+class SessionStore {
+public:
+    SessionStore();
+    
+    // Mount the partition and locate the latest valid record
+    bool init();
+    
+    // Cycle whose position is saved with the timer (optional)
+    void setCycle(const PomodoroCycle* cycle);
+    
+    // Latest recovered session; false if none was found
+    bool loadLatest(SessionSnapshot& snapshot) const;
+    
+    // Persist the timer state (use on state changes). Idle states are
+    // written now; a pause or resume right after the last record is
+    // deferred to update()
+    bool save(const Timer& timer);
+    
+    // Rate-limited checkpoint while the timer is running, and deferred
+    // saves once they are due (call in main loop)
+    void update(const Timer& timer);
+    
+    uint32_t getEraseCount() const;
+    bool isSavePending() const;
+
+private:
+    struct Record {
+        uint32_t sequence;
+        uint32_t durationMs;
+        uint32_t elapsedMs;
+        uint8_t magic;          // Marker (high nibble), SessionType (bits 1-2), cycle active (bit 0)
+        uint8_t state;          // TimerState (bits 0-1), cycle round (bits 2-7)
+        uint16_t crc;
+    };
+    
+    FlashPartition partition;
+    const PomodoroCycle* cycle;
+    uint32_t slotCount;
+    uint32_t head;              // Next slot to write
+    uint32_t nextSequence;
+    bool hasLatest;
+    SessionSnapshot latest;
+    uint64_t lastSaveTime;      // Microseconds
+    bool savePending;           // A coalesced save waits for the minimum interval
+    
+    // Helper methods
+    bool append(const SessionSnapshot& snapshot);
+    static void decode(const Record& record, SessionSnapshot& snapshot);
+    static bool isActive(TimerState state);
+    static bool isSame(const SessionSnapshot& a, const SessionSnapshot& b);
+    static bool isBlank(const Record& record);
+    static bool isValid(const Record& record);
+};
+
+#endif
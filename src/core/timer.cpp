@@ -1,5 +1,5 @@
-#include <Arduino.h>
 #include "timer.h"
+#include "clock.h"
 
 Timer::Timer() : startTime(0), pausedTime(0), duration(0), 
                  state(TimerState::STOPPED), onCompleteCallback(nullptr), 
@@ -11,7 +11,7 @@ ErrorCode Timer::start(unsigned long durationMs) {
         return ErrorCode::INVALID_DURATION;
     }
     
-    duration = durationMs;
+    duration = MS_TO_US(durationMs);
     startTime = getCurrentTime();
     pausedTime = 0;
     state = TimerState::RUNNING;
@@ -41,8 +41,9 @@ ErrorCode Timer::resume() {
         return ErrorCode::TIMER_NOT_RUNNING;
     }
     
-    // Adjust start time to account for paused duration
-    unsigned long pausedDuration = getCurrentTime() - pausedTime;
+    // Shift the start by the exact paused interval (integer microseconds,
+    // so any number of pause cycles accumulates zero drift)
+    uint64_t pausedDuration = getCurrentTime() - pausedTime;
     startTime += pausedDuration;
     state = TimerState::RUNNING;
     
@@ -56,6 +57,44 @@ ErrorCode Timer::reset() {
     return ErrorCode::SUCCESS;
 }
 
+ErrorCode Timer::restore(unsigned long durationMs, unsigned long elapsedMs,
+                         TimerState restoredState) {
+    if (durationMs == 0 || elapsedMs >= durationMs) {
+        return ErrorCode::INVALID_DURATION;
+    }
+    if (restoredState != TimerState::RUNNING && restoredState != TimerState::PAUSED) {
+        return ErrorCode::TIMER_NOT_RUNNING;
+    }
+    
+    // Back-date the start; unsigned wrap keeps the subtraction exact even
+    // when elapsed exceeds the current uptime
+    uint64_t now = getCurrentTime();
+    duration = MS_TO_US(durationMs);
+    startTime = now - MS_TO_US(elapsedMs);
+    pausedTime = (restoredState == TimerState::PAUSED) ? now : 0;
+    state = restoredState;
+    
+    return ErrorCode::SUCCESS;
+}
+
+ErrorCode Timer::chain(unsigned long durationMs) {
+    if (durationMs == 0) {
+        return ErrorCode::INVALID_DURATION;
+    }
+    if (state != TimerState::COMPLETED) {
+        return ErrorCode::TIMER_NOT_RUNNING;
+    }
+    
+    // Next session starts exactly at the previous deadline, so loop latency
+    // never accumulates across back-to-back sessions
+    startTime += duration;
+    duration = MS_TO_US(durationMs);
+    pausedTime = 0;
+    state = TimerState::RUNNING;
+    
+    return ErrorCode::SUCCESS;
+}
+
 TimerState Timer::getState() const {
     return state;
 }
@@ -73,11 +112,24 @@ bool Timer::isCompleted() const {
 }
 
 unsigned long Timer::getRemaining() const {
-    if (state != TimerState::RUNNING) {
-        return (state == TimerState::COMPLETED) ? 0 : duration;
+    return (unsigned long)US_TO_MS(getRemainingMicros());
+}
+
+unsigned long Timer::getElapsed() const {
+    return (unsigned long)US_TO_MS(getElapsedMicros());
+}
+
+unsigned long Timer::getDuration() const {
+    return (unsigned long)US_TO_MS(duration);
+}
+
+uint64_t Timer::getRemainingMicros() const {
+    if (state == TimerState::STOPPED) {
+        return duration;
     }
     
-    unsigned long elapsed = getCurrentTime() - startTime;
+    // Paused and completed timers report the time left when they stopped
+    uint64_t elapsed = getElapsedMicros();
     
     if (elapsed >= duration) {
         return 0;
@@ -86,20 +138,24 @@ unsigned long Timer::getRemaining() const {
     return duration - elapsed;
 }
 
-unsigned long Timer::getElapsed() const {
+uint64_t Timer::getElapsedMicros() const {
     if (state == TimerState::STOPPED) {
         return 0;
     }
     
+    if (state == TimerState::COMPLETED) {
+        return duration;
+    }
+    
     if (state == TimerState::PAUSED) {
         return pausedTime - startTime;
     }
     
-    unsigned long elapsed = getCurrentTime() - startTime;
+    uint64_t elapsed = getCurrentTime() - startTime;
     return (elapsed > duration) ? duration : elapsed;
 }
 
-unsigned long Timer::getDuration() const {
+uint64_t Timer::getDurationMicros() const {
     return duration;
 }
 
@@ -108,7 +164,8 @@ float Timer::getFractionalRemaining() const {
         return 0.0f;
     }
     
-    return (float)getRemaining() / duration;
+    // Microsecond numerator keeps sub-millisecond resolution for LED interpolation
+    return (float)getRemainingMicros() / (float)duration;
 }
 
 float Timer::getFractionalElapsed() const {
@@ -116,7 +173,7 @@ float Timer::getFractionalElapsed() const {
         return 0.0f;
     }
     
-    return (float)getElapsed() / duration;
+    return (float)getElapsedMicros() / (float)duration;
 }
 
 void Timer::setOnCompleteCallback(TimerCallback callback) {
@@ -129,7 +186,7 @@ void Timer::setOnTickCallback(TimerCallback callback) {
 
 void Timer::update() {
     if (state == TimerState::RUNNING) {
-        unsigned long elapsed = getCurrentTime() - startTime;
+        uint64_t elapsed = getCurrentTime() - startTime;
         
         if (elapsed >= duration) {
             handleTimerCompletion();
@@ -139,8 +196,8 @@ void Timer::update() {
     }
 }
 
-unsigned long Timer::getCurrentTime() const {
-    return millis();
+uint64_t Timer::getCurrentTime() const {
+    return Clock::nowMicros();
 }
 
 void Timer::handleTimerCompletion() {
@@ -1,10 +1,12 @@
 #ifndef TIMER_H
 #define TIMER_H
 
+#include <stdint.h>
 #include "types.h"
+#include "delegate.h"
 
-// Forward declaration for callback function
-typedef void (*TimerCallback)(void);
+// Called from update() on completion and on every running update
+typedef Delegate<void()> TimerCallback;
 
 class Timer {
 public:
@@ -16,6 +18,9 @@ public:
     ErrorCode pause();
     ErrorCode resume();
     ErrorCode reset();
+    ErrorCode restore(unsigned long durationMs, unsigned long elapsedMs,
+                      TimerState restoredState = TimerState::RUNNING);
+    ErrorCode chain(unsigned long durationMs);
     
     // State queries
     TimerState getState() const;
@@ -30,6 +35,11 @@ public:
     float getFractionalRemaining() const;
     float getFractionalElapsed() const;
     
+    // Microsecond-resolution time queries
+    uint64_t getRemainingMicros() const;
+    uint64_t getElapsedMicros() const;
+    uint64_t getDurationMicros() const;
+    
     // Callback management
     void setOnCompleteCallback(TimerCallback callback);
     void setOnTickCallback(TimerCallback callback);
@@ -38,16 +48,17 @@ public:
     void update();
     
 private:
-    unsigned long startTime;
-    unsigned long pausedTime;
-    unsigned long duration;
+    // All timestamps are microseconds from Clock::nowMicros()
+    uint64_t startTime;
+    uint64_t pausedTime;
+    uint64_t duration;
     TimerState state;
     
     TimerCallback onCompleteCallback;
     TimerCallback onTickCallback;
     
     // Helper methods
-    unsigned long getCurrentTime() const;
+    uint64_t getCurrentTime() const;
     void handleTimerCompletion();
 };
 
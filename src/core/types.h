@@ -16,6 +16,12 @@ enum class SessionType {
     LONG_BREAK
 };
 
+// How a session ended
+enum class SessionOutcome {
+    COMPLETED,
+    CANCELLED
+};
+
 // Animation types
 enum class AnimationType {
     COUNTDOWN,
@@ -26,6 +32,7 @@ enum class AnimationType {
     GAUGE_SWEEP,
     FLASH_COMPLETE,
     FLASH_CANCELLED,
+    PAUSED,
     OFF
 };
 
@@ -34,6 +41,7 @@ enum class AppState {
     TIME_SELECTION,
     GAUGE_SWEEP,
     COUNTDOWN_RUNNING,
+    PAUSED,
     TIMER_COMPLETE,
     TIMER_CANCELLED
 };
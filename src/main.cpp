@@ -5,43 +5,123 @@
 #include "core/config.h"
 #include "core/types.h"
 #include "core/logger.h"
+#include "core/clock.h"
 #include "core/timer.h"
 #include "core/animations.h"
-#include "core/encoder.h"
+#include "core/led_output.h"
+#include "core/input_scanner.h"
+#include "core/encoder_accel.h"
 #include "core/display.h"
+#include "core/session_store.h"
+#include "core/history.h"
+#include "core/pomodoro.h"
+#include "core/sequence.h"
+#include "core/input_trace.h"
+#include "core/latency.h"
+#include "core/control_link.h"
+#include "core/boot_profile.h"
+#include "core/asset_pack.h"
 
 // Global objects
+CRGB leds[NUM_LEDS];
 Timer pomodoroTimer;
-AnimationManager animManager(nullptr, NUM_LEDS);
-RotaryEncoder encoder;
+AnimationManager animManager(leds, NUM_LEDS);
+InputScanner inputScanner;
 OLEDDisplay oledDisplay;
-CRGB leds[NUM_LEDS];
+SessionStore sessionStore;
+SessionHistory sessionHistory;
+PomodoroCycle pomodoroCycle;
+BootProfile bootProfile;
+AssetPack assetPack;
+#if LED_OUTPUT_RMT
+RmtLedOutput ledOutput(LED_PIN);
+#else
+FastLEDOutput ledOutput;
+#endif
+#if FRAME_CAPTURE_ENABLED
+FrameCapture frameCapture;
+#endif
+#if CONTROL_ENABLED
+ControlLink controlLink;
+#endif
+#if INPUT_TRACE_ENABLED
+InputTrace inputTrace;
+LatencyProbe latencyProbe;
+uint64_t latencyReportTime = 0;
+#endif
 
 // Application state
 AppState currentState = AppState::TIME_SELECTION;
 int selectedMinutes = 0;
-int encoderStepCount = 0;  // Track encoder steps for sensitivity control
+EncoderAcceleration selectionAcceleration;  // Detents -> timer increments
+bool selectionChanged = false;  // Redraw time selection on the next loop pass
 bool systemInitialized = false;
-unsigned long flashStartTime = 0;
-unsigned long sweepStartTime = 0;
-float sweepProgress = 0.0f;
+Sequence phaseSequence;        // Timed phases: gauge sweep and the completion/cancel flashes
+Sequence bootSequence;         // Boot work deferred past the first frame
+
+#define PHASE_EVENT_SKIP 0x01                                       // Button pressed during a flash
+#define SWEEP_DURATION_US 1000000ULL                                // 1 second sweep
+#define FLASH_DURATION_US MS_TO_US(FLASH_ANIMATION_CYCLES * 1000UL) // 3 seconds total
+CRGB countdownColor = CRGB::Red;
+uint64_t pausedFrameTime = 0;  // Last LED refresh while paused
 
 // Forward declarations
 void onTimerComplete();
-void onEncoderRotation(EncoderDirection direction);
-void onButtonPress();
-void onButtonLongPress();
+void onEncoderRotation(const InputEvent& event);
+void onButtonPress(const InputEvent& event);
+void onButtonLongPress(const InputEvent& event);
 void updateTimeSelection();
+void renderTimeSelectionLeds();
 void startCountdown();
+void startPomodoroCycle();
+void prepareNextSession();
 void updateCountdown();
-void updateGaugeSweep();
-void updateFlashComplete();
-void updateFlashCancelled();
+void updatePaused();
+bool pauseCountdown();
+bool resumeCountdown();
+bool cancelCountdown();
+void runGaugeSweep(Sequence& seq);
+void runFlashComplete(Sequence& seq);
+void runFlashCancelled(Sequence& seq);
+void runDeferredBoot(Sequence& seq);
 void transitionToState(AppState newState);
 
+// Session helpers
+SessionType currentSessionType() {
+    return pomodoroCycle.isActive() ? pomodoroCycle.getCurrentType() : SessionType::WORK;
+}
+
+CRGB sessionColor(SessionType type) {
+    switch (type) {
+        case SessionType::SHORT_BREAK: return CRGB::Green;
+        case SessionType::LONG_BREAK:  return CRGB::Blue;
+        case SessionType::WORK:
+        default:                       return CRGB::Red;
+    }
+}
+
+// An input is about to change what the LEDs and OLED show
+void markInput(uint32_t inputMicros) {
+#if INPUT_TRACE_ENABLED
+    latencyProbe.markInput(inputMicros);
+#endif
+}
+
 // Timer callback functions
 void onTimerComplete() {
     LOG_INFO("Timer completed!");
+    sessionHistory.record(SessionOutcome::COMPLETED, currentSessionType(),
+                          pomodoroTimer.getDuration() / 1000);
+    
+    if (pomodoroCycle.isActive()) {
+        // Chain straight into the next session; the completion flash plays
+        // over its first seconds
+        SessionType next = pomodoroCycle.advance();
+        pomodoroTimer.chain(PomodoroCycle::getDurationMs(next));
+        LOG_INFOF("Next session: %s", PomodoroCycle::getLabel(next));
+    }
+    
+    sessionStore.save(pomodoroTimer);
     transitionToState(AppState::TIMER_COMPLETE);
 }
 
@@ -49,34 +129,33 @@ void onTimerTick() {
     // Called every timer update - can be used for periodic tasks
 }
 
-// Encoder callback functions
-void onEncoderRotation(EncoderDirection direction) {
+// Input event handlers
+void onEncoderRotation(const InputEvent& event) {
     if (currentState == AppState::TIME_SELECTION) {
-        // Update encoder step count
-        if (direction == EncoderDirection::CLOCKWISE) {
-            encoderStepCount++;
-        } else if (direction == EncoderDirection::COUNTER_CLOCKWISE) {
-            encoderStepCount--;
+        // Faster turns step further per detent
+        int increments = selectionAcceleration.update(event.steps, event.timeUs);
+        if (increments == 0) {
+            return;
         }
         
-        // Only update timer when we've accumulated enough steps
-        if (abs(encoderStepCount) >= ENCODER_STEPS_PER_INCREMENT) {
-            if (encoderStepCount > 0) {
-                selectedMinutes = min(selectedMinutes + TIMER_STEP_MINUTES, MAX_TIMER_MINUTES);
-            } else {
-                selectedMinutes = max(selectedMinutes - TIMER_STEP_MINUTES, 0);
-            }
-            
-            // Reset step count
-            encoderStepCount = 0;
-            
+        int previousMinutes = selectedMinutes;
+        selectedMinutes = max(0, min(selectedMinutes + increments * TIMER_STEP_MINUTES, MAX_TIMER_MINUTES));
+        
+        if (selectedMinutes != previousMinutes) {
+            markInput(event.timeUs);
             LOG_INFOF("Timer set to %d minutes", selectedMinutes);
-            updateTimeSelection();
+            
+            // Drawn once per loop pass, however many detents arrive in it
+            selectionChanged = true;
         }
     }
 }
 
-void onButtonPress() {
+void onButtonPress(const InputEvent& event) {
+    if (currentState != AppState::TIME_SELECTION || selectedMinutes > 0) {
+        markInput(event.timeUs);
+    }
+    
     switch (currentState) {
         case AppState::TIME_SELECTION:
             if (selectedMinutes > 0) {
@@ -85,28 +164,45 @@ void onButtonPress() {
             break;
             
         case AppState::COUNTDOWN_RUNNING:
-            // Could add pause functionality here if needed
+            pauseCountdown();
             break;
             
-        case AppState::TIMER_COMPLETE:
-            // Return to time selection
-            transitionToState(AppState::TIME_SELECTION);
+        case AppState::PAUSED:
+            resumeCountdown();
             break;
             
+        case AppState::TIMER_COMPLETE:
         case AppState::TIMER_CANCELLED:
-            // Return to time selection
-            transitionToState(AppState::TIME_SELECTION);
+            // Cut the flash short (the sequence picks the next state)
+            phaseSequence.post(PHASE_EVENT_SKIP);
             break;
     }
 }
 
-void onButtonLongPress() {
+void onButtonLongPress(const InputEvent& event) {
+    // Held, not edge-triggered: the event time is when the hold was recognised
+    markInput(event.timeUs);
+    
     switch (currentState) {
         case AppState::COUNTDOWN_RUNNING:
-            // Cancel the countdown
+        case AppState::PAUSED:
             LOG_INFO("Timer cancelled by long press");
-            pomodoroTimer.stop();
-            transitionToState(AppState::TIMER_CANCELLED);
+            cancelCountdown();
+            break;
+            
+        case AppState::TIME_SELECTION:
+            // Start a full Pomodoro cycle (work/break sessions chain automatically)
+            startPomodoroCycle();
+            break;
+            
+        case AppState::TIMER_COMPLETE:
+            // In a cycle the next session is already running under the flash
+            if (pomodoroCycle.isActive()) {
+                LOG_INFO("Pomodoro cycle cancelled by long press");
+                cancelCountdown();
+            } else {
+                phaseSequence.post(PHASE_EVENT_SKIP);
+            }
             break;
             
         default:
@@ -115,70 +211,192 @@ void onButtonLongPress() {
     }
 }
 
+// Countdown control (shared by the button and the control link)
+bool pauseCountdown() {
+    if (currentState != AppState::COUNTDOWN_RUNNING ||
+        pomodoroTimer.pause() != ErrorCode::SUCCESS) {
+        return false;
+    }
+    LOG_INFO("Timer paused");
+    sessionStore.save(pomodoroTimer);
+    transitionToState(AppState::PAUSED);
+    return true;
+}
+
+bool resumeCountdown() {
+    if (currentState != AppState::PAUSED ||
+        pomodoroTimer.resume() != ErrorCode::SUCCESS) {
+        return false;
+    }
+    LOG_INFO("Timer resumed");
+    sessionStore.save(pomodoroTimer);
+    transitionToState(AppState::COUNTDOWN_RUNNING);
+    return true;
+}
+
+bool cancelCountdown() {
+    bool chained = (currentState == AppState::TIMER_COMPLETE && pomodoroCycle.isActive());
+    if (currentState != AppState::COUNTDOWN_RUNNING && currentState != AppState::PAUSED &&
+        !chained) {
+        return false;
+    }
+    sessionHistory.record(SessionOutcome::CANCELLED, currentSessionType(),
+                          pomodoroTimer.getElapsed() / 1000);
+    pomodoroTimer.stop();
+    pomodoroCycle.stop();
+    sessionStore.save(pomodoroTimer);
+    transitionToState(AppState::TIMER_CANCELLED);
+    return true;
+}
+
+// Control link requests; every reply carries the resulting status
+void onControlRequest(const ControlRequest& request, ControlReply& reply) {
+    bool idle = (currentState == AppState::TIME_SELECTION);
+    
+    switch (request.command) {
+        case CONTROL_PING:
+        case CONTROL_STATUS:
+            break;
+            
+        case CONTROL_START: {
+            int minutes = (request.length == 2) ? (request.args[0] | (request.args[1] << 8)) : 0;
+            if (minutes <= 0 || minutes > MAX_TIMER_MINUTES) {
+                reply.status = ControlStatus::BAD_REQUEST;
+            } else if (!idle) {
+                reply.status = ControlStatus::REJECTED;
+            } else {
+                selectedMinutes = minutes;
+                startCountdown();
+                if (!pomodoroTimer.isRunning()) {
+                    reply.status = ControlStatus::FAILED;
+                }
+            }
+            break;
+        }
+            
+        case CONTROL_START_CYCLE:
+            if (!idle) {
+                reply.status = ControlStatus::REJECTED;
+            } else {
+                startPomodoroCycle();
+            }
+            break;
+            
+        case CONTROL_PAUSE:
+            reply.status = pauseCountdown() ? ControlStatus::OK : ControlStatus::REJECTED;
+            break;
+            
+        case CONTROL_RESUME:
+            reply.status = resumeCountdown() ? ControlStatus::OK : ControlStatus::REJECTED;
+            break;
+            
+        case CONTROL_STOP:
+            reply.status = cancelCountdown() ? ControlStatus::OK : ControlStatus::REJECTED;
+            break;
+            
+        case CONTROL_SET_TIME: {
+            uint32_t seconds = 0;
+            if (request.length == 4) {
+                seconds = request.args[0] | (request.args[1] << 8) |
+                          ((uint32_t)request.args[2] << 16) | ((uint32_t)request.args[3] << 24);
+            }
+            if (!sessionHistory.setTime(seconds)) {
+                reply.status = ControlStatus::BAD_REQUEST;
+            }
+            break;
+        }
+            
+        default:
+            reply.status = ControlStatus::UNKNOWN_COMMAND;
+            break;
+    }
+    
+    // Status: app state, timer state, session type, cycle active,
+    // duration and remaining time (ms)
+    reply.put8((uint8_t)currentState);
+    reply.put8((uint8_t)pomodoroTimer.getState());
+    reply.put8((uint8_t)currentSessionType());
+    reply.put8(pomodoroCycle.isActive() ? 1 : 0);
+    reply.put32((uint32_t)pomodoroTimer.getDuration());
+    reply.put32((uint32_t)pomodoroTimer.getRemaining());
+}
+
 // State management functions
 void transitionToState(AppState newState) {
     LOG_INFOF("State transition: %d -> %d", (int)currentState, (int)newState);
     currentState = newState;
+    phaseSequence.stop();
     
     switch (newState) {
         case AppState::TIME_SELECTION:
-            animManager.setAnimation(AnimationType::TIME_SELECTION);
+            animManager.setAnimation(AnimationType::TIME_SELECTION, LED_CROSSFADE_MS);
             selectedMinutes = 0; // Reset to 0
-            encoderStepCount = 0; // Reset encoder step count
+            selectionAcceleration.reset();
+            selectionChanged = false;
             updateTimeSelection();
             break;
             
         case AppState::GAUGE_SWEEP:
-            animManager.setAnimation(AnimationType::GAUGE_SWEEP);
-            sweepStartTime = millis();
-            sweepProgress = 0.0f;
+            animManager.setAnimation(AnimationType::GAUGE_SWEEP, LED_CROSSFADE_MS);
+            phaseSequence.start(runGaugeSweep);
             LOG_INFO("Starting gauge sweep animation");
             break;
             
         case AppState::COUNTDOWN_RUNNING:
-            animManager.setAnimation(AnimationType::COUNTDOWN);
-            animManager.setColors(CRGB::Red, CRGB::Black);
+            animManager.setAnimation(AnimationType::COUNTDOWN, LED_CROSSFADE_MS);
+            animManager.setColors(countdownColor, CRGB::Black);
+            break;
+            
+        case AppState::PAUSED:
+            // Static screen; only the LEDs keep breathing at a low rate
+            animManager.setAnimation(AnimationType::PAUSED, LED_CROSSFADE_MS);
+            pausedFrameTime = 0;
+            oledDisplay.showPaused((int)(pomodoroTimer.getRemaining() / 1000),
+                                   (int)(pomodoroTimer.getDuration() / 1000));
+            updatePaused();
             break;
             
         case AppState::TIMER_COMPLETE:
-            animManager.setAnimation(AnimationType::FLASH_COMPLETE);
-            flashStartTime = millis();
+            animManager.setAnimation(AnimationType::FLASH_COMPLETE, LED_CROSSFADE_MS);
+            phaseSequence.start(runFlashComplete);
             oledDisplay.showComplete();
+            if (pomodoroCycle.isActive()) {
+                prepareNextSession();
+            }
             break;
             
         case AppState::TIMER_CANCELLED:
-            animManager.setAnimation(AnimationType::FLASH_CANCELLED);
-            flashStartTime = millis();
+            animManager.setAnimation(AnimationType::FLASH_CANCELLED, LED_CROSSFADE_MS);
+            phaseSequence.start(runFlashCancelled);
             oledDisplay.showCancelled();
             break;
     }
 }
 
-void updateTimeSelection() {
+void renderTimeSelectionLeds() {
     // Calculate progress based on selected minutes (0 to 60 minutes)
     float progress = (float)selectedMinutes / MAX_TIMER_MINUTES;
     
-    AnimationParams params;
+    TimeSelectionParams params;
     params.progress = progress;
-    params.primaryColor = CRGB::White;  // White for time selection
-    params.secondaryColor = CRGB::Black;
-    params.brightness = LED_BRIGHTNESS;
-    params.timestamp = millis();
+    params.timestamp = Clock::nowMicros();
     
-    animManager.update(params);
+    animManager.draw(params);
     animManager.show();
+}
+
+void updateTimeSelection() {
+    renderTimeSelectionLeds();
     
     // Update OLED display (convert to seconds for display)
     oledDisplay.showTimeSelection(selectedMinutes * 60);
 }
 
-void startCountdown() {
-    unsigned long durationMs = selectedMinutes * 60000UL; // Convert minutes to milliseconds
-    
-    LOG_INFOF("Starting countdown: %d minutes (%lu ms)", selectedMinutes, durationMs);
-    
+void startSession(unsigned long durationMs) {
     ErrorCode result = pomodoroTimer.start(durationMs);
     if (result == ErrorCode::SUCCESS) {
+        sessionStore.save(pomodoroTimer);
+        
         // Start with gauge sweep animation first
         transitionToState(AppState::GAUGE_SWEEP);
     } else {
@@ -186,121 +404,280 @@ void startCountdown() {
     }
 }
 
+void startCountdown() {
+    unsigned long durationMs = selectedMinutes * 60000UL; // Convert minutes to milliseconds
+    
+    LOG_INFOF("Starting countdown: %d minutes (%lu ms)", selectedMinutes, durationMs);
+    
+    countdownColor = CRGB::Red;
+    oledDisplay.setCountdownTitle("COUNTDOWN");
+    startSession(durationMs);
+}
+
+void startPomodoroCycle() {
+    pomodoroCycle.start();
+    unsigned long durationMs = PomodoroCycle::getDurationMs(SessionType::WORK);
+    selectedMinutes = durationMs / 60000UL;
+    
+    LOG_INFOF("Starting Pomodoro cycle (long break every %d sessions)",
+              POMODORO_LONG_BREAK_INTERVAL);
+    
+    countdownColor = sessionColor(SessionType::WORK);
+    oledDisplay.setCountdownTitle(PomodoroCycle::getLabel(SessionType::WORK));
+    startSession(durationMs);
+}
+
+// Precompute the next session's first frame while the completion flash plays,
+// so the handover is a plain buffer flush
+void prepareNextSession() {
+    SessionType type = pomodoroCycle.getCurrentType();
+    countdownColor = sessionColor(type);
+    oledDisplay.setCountdownTitle(PomodoroCycle::getLabel(type));
+    
+    uint64_t remaining = pomodoroTimer.getRemainingMicros();
+    uint64_t flashDuration = MS_TO_US(FLASH_ANIMATION_CYCLES * 1000UL);
+    if (remaining > flashDuration) {
+        remaining -= flashDuration;
+    }
+    
+    oledDisplay.prepareCountdown((int)(remaining / US_PER_SEC),
+                                 (int)(pomodoroTimer.getDuration() / 1000));
+    
+    // The LED ring too; the first countdown frame copies it if it still matches
+    uint64_t duration = pomodoroTimer.getDurationMicros();
+    if (duration > 0) {
+        CountdownParams params;
+        params.progress = (float)remaining / (float)duration;
+        params.color = countdownColor;
+        params.timestamp = Clock::nowMicros();
+        animManager.prepare(params);
+    }
+}
+
 void updateCountdown() {
     // Use full LED ring for countdown (always 1.0 = full ring)
     float currentProgress = pomodoroTimer.getFractionalRemaining();
     
-    AnimationParams params;
+    CountdownParams params;
     params.progress = currentProgress;  // Use full ring, no scaling
-    params.primaryColor = CRGB::Red;
-    params.secondaryColor = CRGB::Black;
-    params.brightness = LED_BRIGHTNESS;
-    params.timestamp = millis();
+    params.color = countdownColor;
+    params.timestamp = Clock::nowMicros();
     
-    animManager.update(params);
+    animManager.draw(params);
     animManager.show();
     
     // Update OLED display
     int remainingSeconds = (int)(pomodoroTimer.getRemaining() / 1000);
-    int totalSeconds = selectedMinutes * 60;
+    int totalSeconds = (int)(pomodoroTimer.getDuration() / 1000);
     oledDisplay.showCountdown(remainingSeconds, totalSeconds);
 }
 
-void updateFlashComplete() {
+void updatePaused() {
+    if (pausedFrameTime != 0 && !animManager.isCrossfading() &&
+        Clock::elapsedSince(pausedFrameTime) < MS_TO_US(PAUSED_LED_INTERVAL_MS)) {
+        return;
+    }
+    pausedFrameTime = Clock::nowMicros();
+    
     AnimationParams params;
-    params.progress = 0.0f; // Not used in flash animation
-    params.primaryColor = CRGB::Green;
+    params.progress = pomodoroTimer.getFractionalRemaining();
+    params.primaryColor = countdownColor;
     params.secondaryColor = CRGB::Black;
     params.brightness = LED_BRIGHTNESS;
-    params.timestamp = millis();
+    params.timestamp = pausedFrameTime;
     
     animManager.update(params);
     animManager.show();
-    
-    // Check if flash animation should end (3 seconds total)
-    if (millis() - flashStartTime > (FLASH_ANIMATION_CYCLES * 1000UL)) {
-        transitionToState(AppState::TIME_SELECTION);
-    }
 }
 
-void updateGaugeSweep() {
-    unsigned long elapsed = millis() - sweepStartTime;
-    const unsigned long SWEEP_DURATION_MS = 1000; // 1 second sweep
-    
-    // Calculate sweep progress (0.0 to 1.0)
-    sweepProgress = (float)elapsed / SWEEP_DURATION_MS;
-    
-    if (sweepProgress >= 1.0f) {
-        // Sweep complete, transition to countdown
-        sweepProgress = 1.0f;
-        transitionToState(AppState::COUNTDOWN_RUNNING);
-        return;
-    }
+void drawFlash(CRGB color) {
+    AnimationParams params;
+    params.progress = 0.0f; // Not used in flash animation
+    params.primaryColor = color;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = LED_BRIGHTNESS;
+    params.timestamp = Clock::nowMicros();
     
+    animManager.update(params);
+    animManager.show();
+}
+
+void drawGaugeSweep(uint64_t elapsed) {
     // Calculate selected LEDs based on selected minutes
     int selectedLeds = (selectedMinutes * NUM_LEDS) / MAX_TIMER_MINUTES;
     if (selectedLeds == 0 && selectedMinutes > 0) selectedLeds = 1; // Minimum 1 LED
     
-    AnimationParams params;
-    params.progress = sweepProgress;
-    params.primaryColor = CRGB::Red;  // Red sweep color
-    params.secondaryColor = CRGB(selectedLeds, 0, 0); // Hack: store selectedLeds in red channel
-    params.brightness = LED_BRIGHTNESS;
-    params.timestamp = millis();
+    GaugeSweepParams params;
+    params.progress = (float)elapsed / SWEEP_DURATION_US;
+    params.color = countdownColor;
+    params.startLeds = (uint16_t)selectedLeds;
+    params.timestamp = Clock::nowMicros();
     
-    animManager.update(params);
+    animManager.draw(params);
     animManager.show();
 }
 
-void updateFlashCancelled() {
-    AnimationParams params;
-    params.progress = 0.0f; // Not used in flash animation
-    params.primaryColor = CRGB::Red;
-    params.secondaryColor = CRGB::Black;
-    params.brightness = LED_BRIGHTNESS;
-    params.timestamp = millis();
+// Timed phases run as sequences: one frame per animation interval until
+// their time is up (or the button skips them), then hand over to the next
+// state. The state transition is always the last step, since it stops or
+// restarts the sequence.
+void runGaugeSweep(Sequence& seq) {
+    SEQ_BEGIN(seq);
+    while (seq.elapsedMicros() < SWEEP_DURATION_US) {
+        drawGaugeSweep(seq.elapsedMicros());
+        SEQ_SLEEP_MS(seq, ANIMATION_INTERVAL);
+    }
+    transitionToState(AppState::COUNTDOWN_RUNNING);
+    SEQ_END(seq);
+}
+
+void runFlashComplete(Sequence& seq) {
+    SEQ_BEGIN(seq);
+    while (seq.elapsedMicros() <= FLASH_DURATION_US) {
+        drawFlash(CRGB::Green);
+        SEQ_AWAIT_EVENT_MS(seq, PHASE_EVENT_SKIP, ANIMATION_INTERVAL);     // Next frame, or a skip
+        if (seq.consume(PHASE_EVENT_SKIP)) {
+            break;
+        }
+    }
+    // In a cycle the next session is already running: hand over to it
+    transitionToState(pomodoroCycle.isActive() ? AppState::COUNTDOWN_RUNNING
+                                               : AppState::TIME_SELECTION);
+    SEQ_END(seq);
+}
+
+void runFlashCancelled(Sequence& seq) {
+    SEQ_BEGIN(seq);
+    while (seq.elapsedMicros() <= FLASH_DURATION_US) {
+        drawFlash(CRGB::Red);
+        SEQ_AWAIT_EVENT_MS(seq, PHASE_EVENT_SKIP, ANIMATION_INTERVAL);
+        if (seq.consume(PHASE_EVENT_SKIP)) {
+            break;
+        }
+    }
+    transitionToState(AppState::TIME_SELECTION);
+    SEQ_END(seq);
+}
+
+bool resumeSavedSession() {
+    SessionSnapshot snapshot;
+    if (!sessionStore.loadLatest(snapshot) ||
+        (snapshot.state != TimerState::RUNNING && snapshot.state != TimerState::PAUSED)) {
+        return false;
+    }
     
-    animManager.update(params);
-    animManager.show();
+    if (pomodoroTimer.restore(snapshot.durationMs, snapshot.elapsedMs,
+                              snapshot.state) != ErrorCode::SUCCESS) {
+        LOG_WARNING("Saved session is not resumable");
+        return false;
+    }
     
-    // Check if flash animation should end (3 seconds total)
-    if (millis() - flashStartTime > (FLASH_ANIMATION_CYCLES * 1000UL)) {
-        transitionToState(AppState::TIME_SELECTION);
+    // A cycle carries on from the same session and round
+    if (snapshot.cycleActive) {
+        pomodoroCycle.restore(snapshot.sessionType, snapshot.cycleRound);
+        countdownColor = sessionColor(snapshot.sessionType);
+        oledDisplay.setCountdownTitle(PomodoroCycle::getLabel(snapshot.sessionType));
+    } else {
+        countdownColor = CRGB::Red;
+        oledDisplay.setCountdownTitle("COUNTDOWN");
     }
+    
+    selectedMinutes = snapshot.durationMs / 60000;
+    LOG_INFOF("Resuming saved %s session: %lu of %lu ms elapsed",
+              snapshot.cycleActive ? PomodoroCycle::getLabel(snapshot.sessionType) : "countdown",
+              (unsigned long)snapshot.elapsedMs, (unsigned long)snapshot.durationMs);
+    transitionToState(snapshot.state == TimerState::PAUSED ? AppState::PAUSED
+                                                           : AppState::COUNTDOWN_RUNNING);
+    return true;
 }
 
-// System initialization
+// System initialization, staged for time to interactive: only what the
+// first frame and the first input depend on runs here. The OLED (I2C
+// bring-up plus a full panel transfer) and the history index rebuild
+// follow in runDeferredBoot() once the loop is running.
 bool initializeSystem() {
     LOG_INFO("Initializing Pomodoro Timer System...");
     
-    // Initialize FastLED
-    FastLED.addLeds<NEOPIXEL, LED_PIN>(leds, NUM_LEDS);
-    FastLED.setBrightness(LED_BRIGHTNESS);
-    FastLED.clear();
-    FastLED.show();
-    
-    // Initialize animation manager with LED array
-    animManager = AnimationManager(leds, NUM_LEDS);
+    // Initialize LED output (blank frame); frames are submitted to it
+    if (!ledOutput.init(NUM_LEDS)) {
+        return false;
+    }
+    ledOutput.setBrightness(LED_BRIGHTNESS);
+    animManager.setOutput(&ledOutput);
     animManager.setAnimation(AnimationType::TIME_SELECTION);
+#if FRAME_CAPTURE_ENABLED
+    frameCapture.setEnabled(true);
+    animManager.setCapture(&frameCapture);
+#endif
+    bootProfile.mark(BootPhase::LED_OUTPUT);
     
-    // Initialize OLED display
-    oledDisplay.init();
-    
-    // Initialize rotary encoder
-    encoder.init();
-    encoder.setEncoderCallback(onEncoderRotation);
-    encoder.setButtonCallback(onButtonPress);
-    encoder.setButtonLongPressCallback(onButtonLongPress);
+    // Initialize inputs (the rotary encoder and its push button); edges
+    // from here on are queued even while the rest of boot runs
+    inputScanner.addEncoder(ENCODER_CLK_PIN, ENCODER_DT_PIN);
+    inputScanner.addButton(ENCODER_SW_PIN);
+    inputScanner.begin();
+#if INPUT_TRACE_ENABLED
+    inputTrace.start(inputScanner.readPins() & inputScanner.getPinMask());
+    inputScanner.setTrace(&inputTrace);
+    animManager.setLatencyProbe(&latencyProbe);
+    oledDisplay.setLatencyProbe(&latencyProbe);
+#endif
+    bootProfile.mark(BootPhase::INPUT);
     
     // Setup timer callbacks
-    pomodoroTimer.setOnCompleteCallback(onTimerComplete);
-    pomodoroTimer.setOnTickCallback(onTimerTick);
+    pomodoroTimer.setOnCompleteCallback(TimerCallback::bind<onTimerComplete>());
+    pomodoroTimer.setOnTickCallback(TimerCallback::bind<onTimerTick>());
+    
+#if CONTROL_ENABLED
+    controlLink.setHandler(ControlHandler::bind<onControlRequest>());
+#endif
+    
+    // Mount session log (non-fatal: the timer still works without it).
+    // It decides the first state, so it cannot be deferred.
+    sessionStore.setCycle(&pomodoroCycle);
+    if (!sessionStore.init()) {
+        LOG_WARNING("Session persistence unavailable");
+    }
     
     LOG_INFO("System initialization complete");
     return true;
 }
 
+// Remaining boot work, one stage per loop pass so none of it delays the
+// first frame or an input
+void runDeferredBoot(Sequence& seq) {
+    SEQ_BEGIN(seq);
+    // Runs at the end of the first loop pass
+    bootProfile.mark(BootPhase::INTERACTIVE);
+    SEQ_YIELD(seq);
+    
+    // Fonts, screen text and animation programs; built-ins until mapped
+    if (assetPack.init()) {
+        oledDisplay.setAssets(&assetPack);
+        animManager.setAssets(&assetPack);
+    }
+    bootProfile.mark(BootPhase::ASSETS);
+    SEQ_YIELD(seq);
+    
+    oledDisplay.init();
+    bootProfile.mark(BootPhase::DISPLAY);
+    SEQ_YIELD(seq);
+    
+    // Sessions that finished before this point (a restored session can
+    // expire on the first pass) were queued by record() and are written now
+    if (!sessionHistory.init()) {
+        LOG_WARNING("Session history unavailable");
+    }
+    bootProfile.mark(BootPhase::HISTORY);
+    
+    bootProfile.mark(BootPhase::COMPLETE);
+    bootProfile.log();
+    SEQ_END(seq);
+}
+
 void setup() {
+    bootProfile.mark(BootPhase::SETUP);
+    
     // Initialize logging first
     Logger::init();
     LOG_INFO("=== Pomodoro Timer with Rotary Encoder ===");
@@ -313,43 +690,87 @@ void setup() {
         return;
     }
     
-    // Start in time selection mode
-    transitionToState(AppState::TIME_SELECTION);
+    // Pick up an interrupted countdown, otherwise start in time selection mode
+    if (!resumeSavedSession()) {
+        transitionToState(AppState::TIME_SELECTION);
+    }
+    bootProfile.mark(BootPhase::SESSION);
+    bootSequence.start(runDeferredBoot);
     
-    LOG_INFO("System ready. Rotate encoder to set timer (0-60s), press to start.");
+    LOG_INFO("System ready. Rotate encoder to set timer, press to start, hold for a Pomodoro cycle.");
 }
 
-void loop() {
-    if (!systemInitialized) {
-        return;
+void handleInputEvents() {
+    InputEvent event;
+    while (inputScanner.poll(event)) {
+        switch (event.type) {
+            case InputEventType::ROTATE:
+                onEncoderRotation(event);
+                break;
+            case InputEventType::CLICK:
+                onButtonPress(event);
+                break;
+            case InputEventType::LONG_PRESS:
+                onButtonLongPress(event);
+                break;
+        }
     }
-    
+}
+
+// One pass of the main loop without the frame delay (a host replay steps this)
+void serviceLoop() {
     // Update input devices
-    encoder.update();
+    inputScanner.update();
+    handleInputEvents();
+#if CONTROL_ENABLED
+    controlLink.update();
+#endif
     pomodoroTimer.update();
+    sessionStore.update(pomodoroTimer);
     
     // Handle state-specific updates
     switch (currentState) {
         case AppState::TIME_SELECTION:
-            // Time selection display is updated in encoder callback
+            // Redraw after the encoder changed the selection; otherwise
+            // keep pushing LED frames only while a crossfade runs
+            if (selectionChanged) {
+                selectionChanged = false;
+                updateTimeSelection();
+            } else if (animManager.isCrossfading()) {
+                renderTimeSelectionLeds();
+            }
             break;
             
         case AppState::COUNTDOWN_RUNNING:
             updateCountdown();
             break;
             
-        case AppState::TIMER_COMPLETE:
-            updateFlashComplete();
+        case AppState::PAUSED:
+            updatePaused();
             break;
             
-        case AppState::GAUGE_SWEEP:
-            updateGaugeSweep();
-            break;
-            
-        case AppState::TIMER_CANCELLED:
-            updateFlashCancelled();
+        default:
+            // GAUGE_SWEEP, TIMER_COMPLETE and TIMER_CANCELLED run in phaseSequence
             break;
     }
+    phaseSequence.update();
+    bootSequence.update();
+    
+#if INPUT_TRACE_ENABLED
+    inputTrace.update();
+    if (Clock::elapsedSince(latencyReportTime) >= MS_TO_US(LATENCY_REPORT_INTERVAL_MS)) {
+        latencyReportTime = Clock::nowMicros();
+        latencyProbe.log();
+    }
+#endif
+}
+
+void loop() {
+    if (!systemInitialized) {
+        return;
+    }
+    
+    serviceLoop();
     
     // Small delay to prevent overwhelming the system
     delay(ANIMATION_INTERVAL);
@@ -0,0 +1,151 @@
+#ifndef U8G2LIB_H
+#define U8G2LIB_H
+
+#include <stdint.h>
+#include <string.h>
+
+// Host stand-in for the part of U8g2 that DrawList and OLEDDisplay use
+// (pio test -e native_oled). Nothing is rasterised: fonts are fixed-width
+// with the glyph width in their first byte, and the draw calls of the last
+// pass are kept so tests can check what a screen draws, where, and how many
+// times it is replayed per frame.
+
+typedef uint16_t u8g2_uint_t;
+
+struct u8g2_cb_t {
+    uint8_t rotation;
+};
+
+static const u8g2_cb_t u8g2_cb_r0 = { 0 };
+
+#define U8G2_R0 (&u8g2_cb_r0)
+#define U8X8_PIN_NONE 255
+
+static const uint8_t u8g2_font_6x10_tr[] = { 6 };
+static const uint8_t u8g2_font_ncenB08_tr[] = { 8 };
+static const uint8_t u8g2_font_ncenB12_tr[] = { 11 };
+static const uint8_t u8g2_font_ncenB18_tr[] = { 15 };
+
+#define U8G2_STUB_CALLS 32
+#define U8G2_STUB_TEXT 32
+
+struct U8G2StubCall {
+    char op;                // 'T' text, 'F' frame, 'B' box
+    int x;
+    int y;
+    int width;
+    int height;
+    char text[U8G2_STUB_TEXT];
+};
+
+class U8G2 {
+public:
+    explicit U8G2(int pagesPerFrame)
+        : pages(pagesPerFrame), passes(0), frames(0), callCount(0), totalCalls(0), font(nullptr), page(0) {
+        current() = this;
+    }
+    
+    // The driver built last (OLEDDisplay keeps its own private)
+    static U8G2*& current() {
+        static U8G2* driver = nullptr;
+        return driver;
+    }
+    
+    void begin() {}
+    
+    // Full-buffer mode
+    void clearBuffer() { startPass(); }
+    void sendBuffer() { frames++; }
+    
+    // Page mode: one pass per page
+    void firstPage() {
+        page = 0;
+        startPass();
+    }
+    
+    uint8_t nextPage() {
+        if (++page < pages) {
+            startPass();
+            return 1;
+        }
+        frames++;
+        return 0;
+    }
+    
+    void setFont(const uint8_t* data) { font = data; }
+    
+    u8g2_uint_t getStrWidth(const char* str) const {
+        return (u8g2_uint_t)(strlen(str) * (font != nullptr ? font[0] : 0));
+    }
+    
+    u8g2_uint_t drawStr(int x, int y, const char* str) {
+        U8G2StubCall* call = record('T', x, y, getStrWidth(str), font != nullptr ? font[0] : 0);
+        if (call != nullptr) {
+            strncpy(call->text, str, U8G2_STUB_TEXT - 1);
+            call->text[U8G2_STUB_TEXT - 1] = '\0';
+        }
+        return getStrWidth(str);
+    }
+    
+    void drawFrame(int x, int y, int width, int height) { record('F', x, y, width, height); }
+    void drawBox(int x, int y, int width, int height) { record('B', x, y, width, height); }
+    
+    // Text drawn in the last pass, or nullptr
+    const U8G2StubCall* findText(const char* str) const {
+        for (int i = 0; i < callCount; i++) {
+            if (calls[i].op == 'T' && strcmp(calls[i].text, str) == 0) {
+                return &calls[i];
+            }
+        }
+        return nullptr;
+    }
+    
+    int pages;              // Passes per frame (1 in full-buffer mode)
+    int passes;             // clearBuffer() and page starts so far
+    int frames;             // Frames sent to the panel
+    U8G2StubCall calls[U8G2_STUB_CALLS];
+    int callCount;          // Calls in the last pass
+    int totalCalls;         // Calls over all passes
+
+private:
+    const uint8_t* font;
+    int page;
+    
+    void startPass() {
+        passes++;
+        callCount = 0;
+    }
+    
+    U8G2StubCall* record(char op, int x, int y, int width, int height) {
+        totalCalls++;
+        if (callCount >= U8G2_STUB_CALLS) {
+            return nullptr;
+        }
+        U8G2StubCall* call = &calls[callCount++];
+        call->op = op;
+        call->x = x;
+        call->y = y;
+        call->width = width;
+        call->height = height;
+        call->text[0] = '\0';
+        return call;
+    }
+};
+
+// 128x64 SSD1306 drivers: full framebuffer, or 8 / 4 pages per frame
+class U8G2_SSD1306_128X64_NONAME_F_HW_I2C : public U8G2 {
+public:
+    U8G2_SSD1306_128X64_NONAME_F_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE) : U8G2(1) {}
+};
+
+class U8G2_SSD1306_128X64_NONAME_1_HW_I2C : public U8G2 {
+public:
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE) : U8G2(8) {}
+};
+
+class U8G2_SSD1306_128X64_NONAME_2_HW_I2C : public U8G2 {
+public:
+    U8G2_SSD1306_128X64_NONAME_2_HW_I2C(const u8g2_cb_t* rotation, uint8_t reset = U8X8_PIN_NONE) : U8G2(4) {}
+};
+
+#endif // U8G2LIB_H
@@ -0,0 +1,22 @@
+#ifndef WIRE_H
+#define WIRE_H
+
+// Host stand-in for the Arduino I2C driver (pio test -e native_oled)
+
+// XIAO ESP32-C3 pin names from the board's pins_arduino.h
+#ifndef D4
+#define D4 6
+#define D5 7
+#endif
+
+class TwoWire {
+public:
+    void begin(int sda, int scl) {
+        (void)sda;
+        (void)scl;
+    }
+};
+
+static TwoWire Wire __attribute__((unused));
+
+#endif // WIRE_H
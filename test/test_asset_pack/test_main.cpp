@@ -0,0 +1,278 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include "core/asset_pack.h"
+#include "core/anim_program.h"
+#include "core/crc.h"
+
+// Packs are laid out the way tools/asset_pack.py does it and written to a
+// temp file that the AssetPack under test maps instead of ASSET_PACK_FILE
+#define PACK_COUNT ((uint16_t)AssetId::COUNT)
+#define PACK_DATA_START (sizeof(AssetPackHeader) + PACK_COUNT * sizeof(AssetEntry))
+
+static uint8_t pack[1024];
+static uint32_t packSize;
+static char path[] = "/tmp/asset_pack_XXXXXX";
+
+static const uint8_t pulseProgram[] = { ANIM_OP(OP_FILL, 0, 5, 1), ANIM_OP(OP_END, 0, 0, 0) };
+static const uint8_t badProgram[] = { ANIM_OP(OP_JMP, 0, 0, 7), ANIM_OP(OP_END, 0, 0, 0) };
+
+static AssetPackHeader* header() {
+    return (AssetPackHeader*)pack;
+}
+
+static AssetEntry* entry(AssetId id) {
+    return (AssetEntry*)(pack + sizeof(AssetPackHeader)) + (uint16_t)id;
+}
+
+static void beginPack() {
+    memset(pack, 0, sizeof(pack));
+    header()->magic = ASSET_PACK_MAGIC;
+    header()->version = ASSET_PACK_VERSION;
+    header()->count = PACK_COUNT;
+    header()->revision = 7;
+    packSize = PACK_DATA_START;
+}
+
+static void addAsset(AssetId id, const void* data, uint32_t length) {
+    packSize = (packSize + 3) & ~3u;
+    entry(id)->offset = packSize;
+    entry(id)->length = length;
+    memcpy(pack + packSize, data, length);
+    packSize += length;
+}
+
+// Size and CRCs over what is in the buffer now
+static void sealPack() {
+    header()->size = packSize;
+    header()->indexCrc = crc16(pack + sizeof(AssetPackHeader), PACK_DATA_START - sizeof(AssetPackHeader));
+    header()->dataCrc = crc16(pack + PACK_DATA_START, packSize - PACK_DATA_START);
+}
+
+static void buildValidPack() {
+    beginPack();
+    addAsset(AssetId::TEXT_PAUSED, "PAUSA", 6);
+    addAsset(AssetId::PROGRAM_PULSE, pulseProgram, sizeof(pulseProgram));
+    sealPack();
+}
+
+static void writePack() {
+    FILE* file = fopen(path, "wb");
+    TEST_ASSERT_NOT_NULL(file);
+    TEST_ASSERT_EQUAL(packSize, fwrite(pack, 1, packSize, file));
+    fclose(file);
+}
+
+static bool mountPack(AssetPack& assets) {
+    writePack();
+    assets.setFile(path);
+    return assets.init();
+}
+
+// Mappings of the temp file, or -1 where /proc/self/maps is not available
+static int countMappings() {
+    FILE* maps = fopen("/proc/self/maps", "r");
+    if (maps == nullptr) {
+        return -1;
+    }
+    
+    int count = 0;
+    char line[512];
+    while (fgets(line, sizeof(line), maps) != nullptr) {
+        if (strstr(line, path) != nullptr) {
+            count++;
+        }
+    }
+    fclose(maps);
+    return count;
+}
+
+// A rejected pack leaves every lookup on the built-ins
+static void assertFallback(const AssetPack& assets) {
+    uint16_t length = 0;
+    TEST_ASSERT_FALSE(assets.isReady());
+    TEST_ASSERT_EQUAL_UINT32(0, assets.getRevision());
+    TEST_ASSERT_NULL(assets.get(AssetId::TEXT_PAUSED));
+    TEST_ASSERT_EQUAL_STRING("PAUSED", assets.getText(AssetId::TEXT_PAUSED, "PAUSED"));
+    TEST_ASSERT_NULL(assets.getProgram(AnimationType::PULSE, &length));
+}
+
+void setUp() {
+    strcpy(path, "/tmp/asset_pack_XXXXXX");
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    close(fd);
+}
+
+void tearDown() {
+    unlink(path);
+}
+
+void test_valid_pack_is_read_in_place() {
+    AssetPack assets;
+    buildValidPack();
+    TEST_ASSERT_TRUE(mountPack(assets));
+    
+    TEST_ASSERT_TRUE(assets.isReady());
+    TEST_ASSERT_EQUAL_UINT32(7, assets.getRevision());
+    TEST_ASSERT_EQUAL_UINT32(packSize, assets.getSize());
+    TEST_ASSERT_EQUAL_STRING("PAUSA", assets.getText(AssetId::TEXT_PAUSED, "PAUSED"));
+    TEST_ASSERT_EQUAL_STRING("COMPLETE", assets.getText(AssetId::TEXT_COMPLETE, "COMPLETE"));
+    
+    uint16_t length = 0;
+    const uint8_t* program = assets.getProgram(AnimationType::PULSE, &length);
+    TEST_ASSERT_NOT_NULL(program);
+    TEST_ASSERT_EQUAL_UINT16(sizeof(pulseProgram), length);
+    TEST_ASSERT_EQUAL_MEMORY(pulseProgram, program, sizeof(pulseProgram));
+    TEST_ASSERT_NULL(assets.getProgram(AnimationType::COMET, &length));
+}
+
+void test_missing_file_falls_back() {
+    AssetPack assets;
+    assets.setFile("/nonexistent/assets.bin");
+    TEST_ASSERT_FALSE(assets.init());
+    assertFallback(assets);
+}
+
+void test_wrong_magic_falls_back() {
+    AssetPack assets;
+    buildValidPack();
+    header()->magic = 0xFFFFFFFFUL;     // Erased partition
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+}
+
+void test_wrong_version_falls_back() {
+    AssetPack assets;
+    buildValidPack();
+    header()->version = ASSET_PACK_VERSION + 1;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+}
+
+void test_bad_size_falls_back() {
+    AssetPack assets;
+    
+    // Larger than the file
+    buildValidPack();
+    header()->size = packSize + 4;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+    
+    // Smaller than header + index
+    buildValidPack();
+    header()->size = PACK_DATA_START - 1;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+    
+    // Shorter than a header
+    buildValidPack();
+    packSize = sizeof(AssetPackHeader) - 1;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+}
+
+void test_crc_mismatch_falls_back() {
+    AssetPack assets;
+    
+    buildValidPack();
+    pack[packSize - 1] ^= 0x01;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+    
+    buildValidPack();
+    entry(AssetId::TEXT_PAUSED)->length = 5;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+}
+
+void test_entry_out_of_range_falls_back() {
+    AssetPack assets;
+    
+    // Past the end of the pack
+    buildValidPack();
+    entry(AssetId::TEXT_COMPLETE)->offset = packSize - 2;
+    entry(AssetId::TEXT_COMPLETE)->length = 4;
+    sealPack();
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+    
+    // Inside the header
+    buildValidPack();
+    entry(AssetId::TEXT_COMPLETE)->offset = 0;
+    entry(AssetId::TEXT_COMPLETE)->length = 4;
+    sealPack();
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+}
+
+void test_oversized_or_unterminated_text_falls_back() {
+    char longText[ASSET_TEXT_MAX + 1];
+    memset(longText, 'x', sizeof(longText) - 1);
+    longText[sizeof(longText) - 1] = '\0';
+    
+    AssetPack assets;
+    beginPack();
+    addAsset(AssetId::TEXT_PAUSED, longText, sizeof(longText));
+    addAsset(AssetId::TEXT_COMPLETE, longText + 1, sizeof(longText) - 1);
+    addAsset(AssetId::TEXT_CANCELLED, "STOP", 4);
+    sealPack();
+    TEST_ASSERT_TRUE(mountPack(assets));
+    
+    // The pack mounts; only the bad strings are skipped
+    TEST_ASSERT_EQUAL_STRING("PAUSED", assets.getText(AssetId::TEXT_PAUSED, "PAUSED"));
+    TEST_ASSERT_EQUAL_STRING(longText + 1, assets.getText(AssetId::TEXT_COMPLETE, "COMPLETE"));
+    TEST_ASSERT_EQUAL_STRING("CANCELLED", assets.getText(AssetId::TEXT_CANCELLED, "CANCELLED"));
+}
+
+void test_rejected_program_falls_back_alone() {
+    AssetPack assets;
+    beginPack();
+    addAsset(AssetId::PROGRAM_PULSE, pulseProgram, sizeof(pulseProgram));
+    addAsset(AssetId::PROGRAM_COMET, badProgram, sizeof(badProgram));
+    sealPack();
+    TEST_ASSERT_TRUE(mountPack(assets));
+    
+    uint16_t length = 0;
+    TEST_ASSERT_NOT_NULL(assets.getProgram(AnimationType::PULSE, &length));
+    TEST_ASSERT_NULL(assets.getProgram(AnimationType::COMET, &length));
+    TEST_ASSERT_NOT_NULL(assets.get(AssetId::PROGRAM_COMET));
+}
+
+void test_reinit_with_a_bad_pack_drops_the_old_one() {
+    AssetPack assets;
+    buildValidPack();
+    TEST_ASSERT_TRUE(mountPack(assets));
+    
+    buildValidPack();
+    header()->magic = 0;
+    TEST_ASSERT_FALSE(mountPack(assets));
+    assertFallback(assets);
+    
+    // Rejected mappings are released, so retries do not pile them up
+    for (int i = 0; i < 100; i++) {
+        TEST_ASSERT_FALSE(assets.init());
+    }
+    int mapped = countMappings();
+    TEST_ASSERT_TRUE(mapped <= 0);
+    
+    buildValidPack();
+    TEST_ASSERT_TRUE(mountPack(assets));
+    TEST_ASSERT_EQUAL_STRING("PAUSA", assets.getText(AssetId::TEXT_PAUSED, "PAUSED"));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_valid_pack_is_read_in_place);
+    RUN_TEST(test_missing_file_falls_back);
+    RUN_TEST(test_wrong_magic_falls_back);
+    RUN_TEST(test_wrong_version_falls_back);
+    RUN_TEST(test_bad_size_falls_back);
+    RUN_TEST(test_crc_mismatch_falls_back);
+    RUN_TEST(test_entry_out_of_range_falls_back);
+    RUN_TEST(test_oversized_or_unterminated_text_falls_back);
+    RUN_TEST(test_rejected_program_falls_back_alone);
+    RUN_TEST(test_reinit_with_a_bad_pack_drops_the_old_one);
+    return UNITY_END();
+}
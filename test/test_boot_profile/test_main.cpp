@@ -0,0 +1,105 @@
+#include <unity.h>
+#include "core/boot_profile.h"
+#include "core/clock.h"
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+// setup() entered at 'start', interactive 'interactiveUs' later
+static void bootTo(BootProfile& profile, uint64_t start, uint32_t interactiveUs) {
+    fakeNow = start;
+    profile.mark(BootPhase::SETUP);
+    fakeNow += interactiveUs / 4;
+    profile.mark(BootPhase::LED_OUTPUT);
+    fakeNow += interactiveUs / 4;
+    profile.mark(BootPhase::INPUT);
+    fakeNow += interactiveUs / 4;
+    profile.mark(BootPhase::SESSION);
+    fakeNow = start + interactiveUs;
+    profile.mark(BootPhase::INTERACTIVE);
+}
+
+void test_phases_record_time_since_reset() {
+    BootProfile profile;
+    TEST_ASSERT_FALSE(profile.isReached(BootPhase::SETUP));
+    TEST_ASSERT_EQUAL_UINT64(0, profile.getMicros(BootPhase::SETUP));
+    
+    bootTo(profile, 180000, 8000);
+    TEST_ASSERT_TRUE(profile.isReached(BootPhase::SESSION));
+    TEST_ASSERT_EQUAL_UINT64(180000, profile.getMicros(BootPhase::SETUP));
+    TEST_ASSERT_EQUAL_UINT64(182000, profile.getMicros(BootPhase::LED_OUTPUT));
+    TEST_ASSERT_FALSE(profile.isReached(BootPhase::DISPLAY));
+}
+
+void test_phase_in_the_first_microsecond_counts() {
+    BootProfile profile;
+    fakeNow = 0;
+    profile.mark(BootPhase::SETUP);
+    TEST_ASSERT_TRUE(profile.isReached(BootPhase::SETUP));
+}
+
+void test_time_to_interactive_is_setup_to_interactive() {
+    BootProfile profile;
+    TEST_ASSERT_EQUAL_UINT32(0, profile.getTimeToInteractiveMicros());
+    
+    fakeNow = 250000;
+    profile.mark(BootPhase::SETUP);
+    TEST_ASSERT_EQUAL_UINT32(0, profile.getTimeToInteractiveMicros());  // Not there yet
+    
+    fakeNow += 12345;
+    profile.mark(BootPhase::INTERACTIVE);
+    TEST_ASSERT_EQUAL_UINT32(12345, profile.getTimeToInteractiveMicros());
+    
+    // Deferred phases after interactive do not move it
+    fakeNow += MS_TO_US(400);
+    profile.mark(BootPhase::DISPLAY);
+    profile.mark(BootPhase::HISTORY);
+    profile.mark(BootPhase::COMPLETE);
+    TEST_ASSERT_EQUAL_UINT32(12345, profile.getTimeToInteractiveMicros());
+    profile.log();
+}
+
+void test_budget_is_inclusive() {
+    BootProfile atBudget;
+    bootTo(atBudget, 200000, MS_TO_US(BOOT_INTERACTIVE_BUDGET_MS));
+    TEST_ASSERT_FALSE(atBudget.isOverBudget());
+    
+    BootProfile over;
+    bootTo(over, 200000, MS_TO_US(BOOT_INTERACTIVE_BUDGET_MS) + 1);
+    TEST_ASSERT_TRUE(over.isOverBudget());
+    over.log();
+}
+
+void test_slow_deferred_phases_do_not_break_the_budget() {
+    // The OLED and history rebuild may take long; they run after interactive
+    BootProfile profile;
+    bootTo(profile, 200000, MS_TO_US(BOOT_INTERACTIVE_BUDGET_MS) / 2);
+    fakeNow += MS_TO_US(2 * BOOT_INTERACTIVE_BUDGET_MS);
+    profile.mark(BootPhase::ASSETS);
+    profile.mark(BootPhase::DISPLAY);
+    profile.mark(BootPhase::HISTORY);
+    profile.mark(BootPhase::COMPLETE);
+    TEST_ASSERT_FALSE(profile.isOverBudget());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_phases_record_time_since_reset);
+    RUN_TEST(test_phase_in_the_first_microsecond_counts);
+    RUN_TEST(test_time_to_interactive_is_setup_to_interactive);
+    RUN_TEST(test_budget_is_inclusive);
+    RUN_TEST(test_slow_deferred_phases_do_not_break_the_budget);
+    return UNITY_END();
+}
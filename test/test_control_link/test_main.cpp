@@ -0,0 +1,394 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#include "core/control_link.h"
+#include "core/crc.h"
+
+// Sequences the handler saw, in order
+static uint8_t handled[256];
+static int handledCount = 0;
+
+// Replies the link wrote, back to back
+static uint8_t written[4096];
+static size_t writtenLength = 0;
+
+static void recordHandler(const ControlRequest& request, ControlReply& reply) {
+    if (handledCount < (int)sizeof(handled)) {
+        handled[handledCount] = request.sequence;
+    }
+    handledCount++;
+    
+    if (request.command == CONTROL_START && request.length != 2) {
+        reply.status = ControlStatus::BAD_REQUEST;
+        return;
+    }
+    reply.put16((uint16_t)(0xA500 | request.length));
+}
+
+static void recordWriter(const uint8_t* data, size_t length) {
+    if (writtenLength + length <= sizeof(written)) {
+        memcpy(written + writtenLength, data, length);
+    }
+    writtenLength += length;
+}
+
+// A well-formed request packet; returns its length
+static size_t request(uint8_t* out, uint8_t sequence, uint8_t command,
+                      const uint8_t* args = nullptr, uint8_t argLength = 0) {
+    uint8_t body[CONTROL_MAX_BODY];
+    body[0] = sequence;
+    body[1] = command;
+    if (argLength > 0) {
+        memcpy(body + 2, args, argLength);
+    }
+    return ControlLink::encode(CONTROL_REQUEST, body, 2 + argLength, out);
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static uint32_t percentile(uint32_t* samples, int count, int percent) {
+    // Insertion sort: a few hundred samples
+    for (int i = 1; i < count; i++) {
+        uint32_t value = samples[i];
+        int j = i;
+        while (j > 0 && samples[j - 1] > value) {
+            samples[j] = samples[j - 1];
+            j--;
+        }
+        samples[j] = value;
+    }
+    return samples[(count - 1) * percent / 100];
+}
+
+// Device end of the pty: replies go straight back to the host
+static int deviceFd = -1;
+
+static void ptyWriter(const uint8_t* data, size_t length) {
+    size_t done = 0;
+    while (done < length) {
+        ssize_t count = write(deviceFd, data + done, length - done);
+        if (count <= 0) {
+            return;
+        }
+        done += (size_t)count;
+    }
+}
+
+static void discardWriter(const uint8_t* data, size_t length) {
+    (void)data;
+    (void)length;
+}
+
+static ControlLink* controlLink;
+
+void setUp() {
+    handledCount = 0;
+    writtenLength = 0;
+    controlLink = new ControlLink();
+    controlLink->setHandler(ControlHandler::bind<recordHandler>());
+    controlLink->setWriter(ControlWriter::bind<recordWriter>());
+}
+
+void tearDown() {
+    delete controlLink;
+}
+
+void test_request_gets_a_matching_reply() {
+    uint8_t packet[CONTROL_PACKET_MAX];
+    const uint8_t minutes[2] = { 25, 0 };
+    size_t length = request(packet, 7, CONTROL_START, minutes, 2);
+    controlLink->feed(packet, length);
+    
+    TEST_ASSERT_EQUAL(1, handledCount);
+    TEST_ASSERT_EQUAL_UINT32(1, controlLink->getRequestCount());
+    TEST_ASSERT_EQUAL_UINT32(0, controlLink->getErrorCount());
+    
+    // sync | REPLY | u16 5 | seq | cmd | OK | u16 payload | crc8
+    TEST_ASSERT_EQUAL(CAPTURE_HEADER_BYTES + 5 + 1, writtenLength);
+    TEST_ASSERT_EQUAL_HEX8(CAPTURE_SYNC, written[0]);
+    TEST_ASSERT_EQUAL_HEX8(CONTROL_REPLY, written[1]);
+    TEST_ASSERT_EQUAL(5, written[2] | (written[3] << 8));
+    TEST_ASSERT_EQUAL(7, written[4]);
+    TEST_ASSERT_EQUAL(CONTROL_START, written[5]);
+    TEST_ASSERT_EQUAL((int)ControlStatus::OK, written[6]);
+    TEST_ASSERT_EQUAL_HEX8(0x02, written[7]);
+    TEST_ASSERT_EQUAL_HEX8(0xA5, written[8]);
+    TEST_ASSERT_EQUAL_HEX8(crc8(written + 1, 3 + 5), written[9]);
+}
+
+void test_handler_status_is_sent_back() {
+    uint8_t packet[CONTROL_PACKET_MAX];
+    size_t length = request(packet, 9, CONTROL_START);
+    controlLink->feed(packet, length);
+    
+    TEST_ASSERT_EQUAL(1, handledCount);
+    TEST_ASSERT_EQUAL((int)ControlStatus::BAD_REQUEST, written[6]);
+}
+
+void test_byte_at_a_time_matches_one_feed() {
+    uint8_t packet[CONTROL_PACKET_MAX];
+    const uint8_t stamp[4] = { 1, 2, 3, 4 };
+    size_t length = request(packet, 3, CONTROL_SET_TIME, stamp, 4);
+    for (size_t i = 0; i < length; i++) {
+        controlLink->feed(packet + i, 1);
+        TEST_ASSERT_EQUAL(i + 1 == length ? 1 : 0, handledCount);
+    }
+}
+
+void test_log_text_between_requests_is_ignored() {
+    uint8_t stream[256];
+    size_t length = 0;
+    const char* text = "start 25\r\n[1234] INFO: typed at the monitor\n\x7f\x10\x11\xff";
+    
+    memcpy(stream, text, strlen(text));
+    length += strlen(text);
+    length += request(stream + length, 1, CONTROL_PING);
+    memcpy(stream + length, text, strlen(text));
+    length += strlen(text);
+    length += request(stream + length, 2, CONTROL_STATUS);
+    controlLink->feed(stream, length);
+    
+    TEST_ASSERT_EQUAL(2, handledCount);
+    TEST_ASSERT_EQUAL(1, handled[0]);
+    TEST_ASSERT_EQUAL(2, handled[1]);
+    TEST_ASSERT_EQUAL_UINT32(0, controlLink->getErrorCount());
+}
+
+void test_bad_headers_resync_on_a_later_sync() {
+    uint8_t stream[64];
+    size_t length = 0;
+    
+    // Wrong kind (a capture packet echoed back), length too long, too short
+    const uint8_t junk[] = {
+        CAPTURE_SYNC, CAPTURE_KEYFRAME, 2, 0,
+        CAPTURE_SYNC, CONTROL_REQUEST, CONTROL_MAX_BODY + 1, 0,
+        CAPTURE_SYNC, CONTROL_REQUEST, 1, 0,
+        CAPTURE_SYNC, CAPTURE_SYNC
+    };
+    memcpy(stream, junk, sizeof(junk));
+    length += sizeof(junk);
+    length += request(stream + length, 5, CONTROL_PAUSE);
+    controlLink->feed(stream, length);
+    
+    TEST_ASSERT_EQUAL(1, handledCount);
+    TEST_ASSERT_EQUAL(5, handled[0]);
+    TEST_ASSERT_TRUE(controlLink->getErrorCount() >= 3);
+}
+
+void test_corrupted_request_is_dropped() {
+    uint8_t stream[64];
+    size_t first = request(stream, 1, CONTROL_PING);
+    stream[first - 1] ^= 0x5A;      // Bad CRC
+    size_t length = first + request(stream + first, 2, CONTROL_PING);
+    controlLink->feed(stream, length);
+    
+    TEST_ASSERT_EQUAL(1, handledCount);
+    TEST_ASSERT_EQUAL(2, handled[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, controlLink->getRequestCount());
+    
+    // Re-reading the dropped bytes also rejects the 0x00s inside them
+    TEST_ASSERT_TRUE(controlLink->getErrorCount() >= 1);
+}
+
+void test_truncated_request_does_not_swallow_the_next() {
+    // A header whose body never arrives (the host was reset mid-packet):
+    // the following requests are read as its body, then found again
+    uint8_t stream[128];
+    size_t length = 0;
+    stream[length++] = CAPTURE_SYNC;
+    stream[length++] = CONTROL_REQUEST;
+    stream[length++] = 20;
+    stream[length++] = 0;
+    stream[length++] = 0x42;
+    for (uint8_t sequence = 10; sequence < 13; sequence++) {
+        length += request(stream + length, sequence, CONTROL_STATUS);
+    }
+    controlLink->feed(stream, length);
+    
+    TEST_ASSERT_EQUAL(3, handledCount);
+    TEST_ASSERT_EQUAL(10, handled[0]);
+    TEST_ASSERT_EQUAL(11, handled[1]);
+    TEST_ASSERT_EQUAL(12, handled[2]);
+    TEST_ASSERT_TRUE(controlLink->getErrorCount() >= 1);
+}
+
+void test_random_noise_never_loses_a_request() {
+    // Noise without sync bytes (line noise, text) between every request,
+    // fed in uneven chunks
+    uint8_t stream[4096];
+    size_t length = 0;
+    uint32_t seed = 12345;
+    int sent = 0;
+    
+    while (length + 64 + CONTROL_PACKET_MAX < sizeof(stream)) {
+        seed = seed * 1103515245 + 12345;
+        int noise = (seed >> 16) % 48;
+        for (int i = 0; i < noise; i++) {
+            seed = seed * 1103515245 + 12345;
+            stream[length++] = (uint8_t)(1 + (seed >> 16) % 255);
+        }
+        length += request(stream + length, (uint8_t)sent, CONTROL_PING);
+        sent++;
+    }
+    
+    size_t offset = 0;
+    while (offset < length) {
+        seed = seed * 1103515245 + 12345;
+        size_t chunk = 1 + (seed >> 16) % CONTROL_RX_BUDGET;
+        chunk = (chunk > length - offset) ? length - offset : chunk;
+        controlLink->feed(stream + offset, chunk);
+        offset += chunk;
+    }
+    
+    TEST_ASSERT_EQUAL(sent, handledCount);
+    for (int i = 0; i < sent; i++) {
+        TEST_ASSERT_EQUAL((uint8_t)i, handled[i]);
+    }
+}
+
+void test_noise_with_sync_bytes_is_survived() {
+    // Arbitrary bytes, syncs included: the parser must stay in bounds and
+    // still take a clean request once the noise stops
+    uint8_t noise[2048];
+    uint32_t seed = 99;
+    for (size_t i = 0; i < sizeof(noise); i++) {
+        seed = seed * 1103515245 + 12345;
+        noise[i] = (uint8_t)(seed >> 16);
+        if ((seed >> 8) % 7 == 0) {
+            noise[i] = CAPTURE_SYNC;
+        }
+    }
+    controlLink->feed(noise, sizeof(noise));
+    int before = handledCount;
+    
+    // Enough clean requests to flush any partial packet the noise left open
+    uint8_t packet[CONTROL_PACKET_MAX];
+    size_t length = request(packet, 200, CONTROL_PING);
+    for (int i = 0; i < 6; i++) {
+        controlLink->feed(packet, length);
+    }
+    TEST_ASSERT_TRUE(handledCount - before >= 5);
+    TEST_ASSERT_EQUAL(200, handled[handledCount - 1]);
+}
+
+void test_round_trip_over_a_pty() {
+    // The pty master stands in for the UART: the device side drains it in
+    // CONTROL_RX_BUDGET chunks like update(), the host writes raw packets
+    // to the slave and waits for each reply
+    int device = posix_openpt(O_RDWR | O_NOCTTY);
+    TEST_ASSERT_TRUE(device >= 0);
+    TEST_ASSERT_EQUAL(0, grantpt(device));
+    TEST_ASSERT_EQUAL(0, unlockpt(device));
+    int host = open(ptsname(device), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    TEST_ASSERT_TRUE(host >= 0);
+    
+    // Binary-safe: no echo, no CR/LF mapping, no XON/XOFF (0x11 is a reply kind)
+    struct termios mode;
+    TEST_ASSERT_EQUAL(0, tcgetattr(host, &mode));
+    cfmakeraw(&mode);
+    TEST_ASSERT_EQUAL(0, tcsetattr(host, TCSANOW, &mode));
+    fcntl(device, F_SETFL, fcntl(device, F_GETFL) | O_NONBLOCK);
+    deviceFd = device;
+    controlLink->setWriter(ControlWriter::bind<ptyWriter>());
+    
+    const int rounds = 300;
+    const size_t replyLength = CAPTURE_HEADER_BYTES + 5 + 1;
+    static uint32_t samples[rounds];
+    for (int i = 0; i < rounds; i++) {
+        uint8_t packet[CONTROL_PACKET_MAX];
+        size_t length = request(packet, (uint8_t)i, CONTROL_PING);
+        uint8_t reply[CONTROL_PACKET_MAX];
+        size_t received = 0;
+        
+        double start = steadySeconds();
+        TEST_ASSERT_EQUAL((int)length, (int)write(host, packet, length));
+        while (received < replyLength) {
+            uint8_t chunk[CONTROL_RX_BUDGET];
+            ssize_t count = read(device, chunk, sizeof(chunk));
+            if (count > 0) {
+                controlLink->feed(chunk, (size_t)count);
+            }
+            count = read(host, reply + received, replyLength - received);
+            if (count > 0) {
+                received += (size_t)count;
+            }
+            if (steadySeconds() - start > 1.0) {
+                TEST_FAIL_MESSAGE("no reply within 1 s");
+            }
+        }
+        samples[i] = (uint32_t)((steadySeconds() - start) * 1e6);
+        
+        TEST_ASSERT_EQUAL_HEX8(CONTROL_REPLY, reply[1]);
+        TEST_ASSERT_EQUAL((uint8_t)i, reply[4]);
+        TEST_ASSERT_EQUAL_HEX8(crc8(reply + 1, 3 + 5), reply[replyLength - 1]);
+    }
+    close(host);
+    close(device);
+    
+    TEST_ASSERT_EQUAL(rounds, handledCount);
+    TEST_ASSERT_EQUAL_UINT32(0, controlLink->getErrorCount());
+    
+    // Parser and pty only; on the board a request also waits up to one loop pass
+    uint32_t p50 = percentile(samples, rounds, 50);
+    uint32_t p99 = percentile(samples, rounds, 99);
+    char message[96];
+    snprintf(message, sizeof(message), "pty round trip over %d pings: p50 %lu us, p99 %lu us",
+             rounds, (unsigned long)p50, (unsigned long)p99);
+    TEST_MESSAGE(message);
+}
+
+void test_parser_throughput() {
+    // Requests with arguments between lines of log text, as on the wire
+    static uint8_t stream[16384];
+    size_t length = 0;
+    int perStream = 0;
+    const char* text = "[12345] INFO: Countdown 24m 59s\n";
+    const uint8_t stamp[4] = { 0x80, 0x1F, 0x55, 0x69 };
+    while (length + strlen(text) + CONTROL_PACKET_MAX < sizeof(stream)) {
+        memcpy(stream + length, text, strlen(text));
+        length += strlen(text);
+        length += request(stream + length, (uint8_t)perStream, CONTROL_SET_TIME, stamp, 4);
+        perStream++;
+    }
+    
+    controlLink->setWriter(ControlWriter::bind<discardWriter>());
+    const int passes = 2000;
+    double start = steadySeconds();
+    for (int pass = 0; pass < passes; pass++) {
+        controlLink->feed(stream, length);
+    }
+    double seconds = steadySeconds() - start;
+    
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)perStream * passes, controlLink->getRequestCount());
+    TEST_ASSERT_EQUAL_UINT32(0, controlLink->getErrorCount());
+    
+    char message[96];
+    snprintf(message, sizeof(message), "parser: %.1f MB/s, %.2fM requests/s (replies encoded, not sent)",
+             length * (double)passes / seconds / 1e6, perStream * (double)passes / seconds / 1e6);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_request_gets_a_matching_reply);
+    RUN_TEST(test_handler_status_is_sent_back);
+    RUN_TEST(test_byte_at_a_time_matches_one_feed);
+    RUN_TEST(test_log_text_between_requests_is_ignored);
+    RUN_TEST(test_bad_headers_resync_on_a_later_sync);
+    RUN_TEST(test_corrupted_request_is_dropped);
+    RUN_TEST(test_truncated_request_does_not_swallow_the_next);
+    RUN_TEST(test_random_noise_never_loses_a_request);
+    RUN_TEST(test_noise_with_sync_bytes_is_survived);
+    RUN_TEST(test_round_trip_over_a_pty);
+    RUN_TEST(test_parser_throughput);
+    return UNITY_END();
+}
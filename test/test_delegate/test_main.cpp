@@ -0,0 +1,242 @@
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include <functional>
+#include "core/delegate.h"
+
+static int calls = 0;
+static int lastValue = 0;
+
+static void countCall() {
+    calls++;
+}
+
+static int doubled(int value) {
+    return value * 2;
+}
+
+class Counter {
+public:
+    Counter() : total(0) {}
+    void add(int value) { total += value; }
+    int get() const { return total; }
+    int total;
+};
+
+struct Recorder {
+    int* target;
+    int offset;
+    void operator()(int value) const { *target = value + offset; }
+};
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void setUp() {
+    calls = 0;
+    lastValue = 0;
+}
+
+void tearDown() {
+}
+
+void test_bind_function() {
+    Delegate<void()> done = Delegate<void()>::bind<countCall>();
+    done();
+    done();
+    TEST_ASSERT_EQUAL(2, calls);
+    
+    Delegate<int(int)> twice = Delegate<int(int)>::bind<doubled>();
+    TEST_ASSERT_EQUAL(42, twice(21));
+}
+
+void test_function_pointer_chosen_at_run_time() {
+    int (*function)(int) = doubled;
+    Delegate<int(int)> twice = function;
+    TEST_ASSERT_EQUAL(10, twice(5));
+    
+    // A null pointer gives an empty delegate
+    function = nullptr;
+    Delegate<int(int)> empty = function;
+    TEST_ASSERT_TRUE(empty == nullptr);
+}
+
+void test_bind_member() {
+    Counter counter;
+    Delegate<void(int)> add = Delegate<void(int)>::bind<Counter, &Counter::add>(&counter);
+    add(3);
+    add(4);
+    TEST_ASSERT_EQUAL(7, counter.total);
+    
+    // Const members bind to const objects; the delegate sees later changes
+    const Counter& view = counter;
+    Delegate<int()> get = Delegate<int()>::bind<Counter, &Counter::get>(&view);
+    counter.add(1);
+    TEST_ASSERT_EQUAL(8, get());
+}
+
+void test_lambda_and_functor_are_stored_inline() {
+    int seen = 0;
+    int offset = 100;
+    
+    // Two captured words: exactly the default capacity
+    Delegate<void(int)> lambda = [&seen, offset](int value) { seen = value + offset; };
+    lambda(5);
+    TEST_ASSERT_EQUAL(105, seen);
+    
+    Recorder recorder = { &seen, 7 };
+    Delegate<void(int)> functor = recorder;
+    recorder.offset = 1000;             // The delegate holds its own copy
+    functor(1);
+    TEST_ASSERT_EQUAL(8, seen);
+    
+    // A lambda without captures is kept as an object, not a pointer
+    Delegate<void(int)> plain = [](int value) { lastValue = value; };
+    plain(9);
+    TEST_ASSERT_EQUAL(9, lastValue);
+    
+    // Invoker plus inline storage: nothing behind a pointer
+    TEST_ASSERT_EQUAL(3 * sizeof(void*), sizeof(Delegate<void(int)>));
+    TEST_ASSERT_EQUAL(sizeof(void*) + 32, sizeof(Delegate<void(int), 32>));
+}
+
+void test_copies_are_independent() {
+    int seen = 0;
+    Delegate<void(int)> first = [&seen](int value) { seen += value; };
+    Delegate<void(int)> second = first;
+    Delegate<void(int)> third;
+    third = second;
+    
+    first(1);
+    second(10);
+    third(100);
+    TEST_ASSERT_EQUAL(111, seen);
+    
+    // Reassigning one leaves the copies as they were
+    first = nullptr;
+    TEST_ASSERT_TRUE(first == nullptr);
+    TEST_ASSERT_TRUE(second != nullptr);
+    second(1000);
+    TEST_ASSERT_EQUAL(1111, seen);
+}
+
+void test_nullptr_comparison() {
+    Delegate<void()> empty;
+    Delegate<void()> cleared = nullptr;
+    Delegate<void()> bound = Delegate<void()>::bind<countCall>();
+    
+    TEST_ASSERT_TRUE(empty == nullptr);
+    TEST_ASSERT_FALSE(empty != nullptr);
+    TEST_ASSERT_FALSE((bool)empty);
+    TEST_ASSERT_TRUE(cleared == nullptr);
+    TEST_ASSERT_TRUE(bound != nullptr);
+    TEST_ASSERT_TRUE((bool)bound);
+    
+    bound = nullptr;
+    TEST_ASSERT_TRUE(bound == nullptr);
+}
+
+void test_storage_checks() {
+    // Callables at the limits are accepted. Built with
+    // -DDELEGATE_EXPECT_COMPILE_ERROR=1..3, each case below must stop the
+    // build on one of the static_asserts in store()
+    struct Words {
+        void* a;
+        void* b;
+        void operator()() const { calls += (a == b) ? 1 : 0; }
+    };
+    Words words = { nullptr, nullptr };
+    Delegate<void()> full = words;
+    full();
+    TEST_ASSERT_EQUAL(1, calls);
+    TEST_ASSERT_TRUE(std::is_trivially_copyable<Delegate<void()> >::value);
+
+#if DELEGATE_EXPECT_COMPILE_ERROR == 1
+    // Three words in a two-word delegate
+    struct TooBig { void* a; void* b; void* c; void operator()() const {} };
+    Delegate<void()> tooBig = TooBig();
+#elif DELEGATE_EXPECT_COMPILE_ERROR == 2
+    // Small enough, but not trivially copyable
+    struct Owning {
+        int* data;
+        Owning() : data(nullptr) {}
+        Owning(const Owning& other) : data(other.data) {}
+        void operator()() const {}
+    };
+    Delegate<void()> owning = Owning();
+#elif DELEGATE_EXPECT_COMPILE_ERROR == 3
+    // Over-aligned state
+    struct alignas(32) Wide { char data[8]; void operator()() const {} };
+    Delegate<void(), 64> wide = Wide();
+#endif
+}
+
+// Targets the optimiser cannot see through, so each path pays its own dispatch
+static int sink = 0;
+
+__attribute__((noinline)) static void work(int value) {
+    sink += value;
+}
+
+void test_call_cost_against_a_raw_pointer_and_std_function() {
+    const int rounds = 20000000;
+    void (*volatile raw)(int) = work;
+    Delegate<void(int)> bound = Delegate<void(int)>::bind<work>();
+    Delegate<void(int)> pointer = raw;
+    std::function<void(int)> standard = work;
+    Delegate<void(int)>* volatile boundRef = &bound;
+    Delegate<void(int)>* volatile pointerRef = &pointer;
+    std::function<void(int)>* volatile standardRef = &standard;
+    double times[4];
+    
+    double start = steadySeconds();
+    for (int i = 0; i < rounds; i++) {
+        raw(i);
+    }
+    times[0] = steadySeconds() - start;
+    
+    start = steadySeconds();
+    for (int i = 0; i < rounds; i++) {
+        (*boundRef)(i);
+    }
+    times[1] = steadySeconds() - start;
+    
+    start = steadySeconds();
+    for (int i = 0; i < rounds; i++) {
+        (*pointerRef)(i);
+    }
+    times[2] = steadySeconds() - start;
+    
+    start = steadySeconds();
+    for (int i = 0; i < rounds; i++) {
+        (*standardRef)(i);
+    }
+    times[3] = steadySeconds() - start;
+    
+    char message[160];
+    snprintf(message, sizeof(message),
+             "ns/call: raw pointer %.2f, bind<fn> %.2f, run-time pointer %.2f, std::function %.2f",
+             times[0] * 1e9 / rounds, times[1] * 1e9 / rounds, times[2] * 1e9 / rounds,
+             times[3] * 1e9 / rounds);
+    TEST_MESSAGE(message);
+    snprintf(message, sizeof(message), "sizeof: raw pointer %u, Delegate %u, std::function %u",
+             (unsigned)sizeof(raw), (unsigned)sizeof(bound), (unsigned)sizeof(standard));
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(sink != 0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_bind_function);
+    RUN_TEST(test_function_pointer_chosen_at_run_time);
+    RUN_TEST(test_bind_member);
+    RUN_TEST(test_lambda_and_functor_are_stored_inline);
+    RUN_TEST(test_copies_are_independent);
+    RUN_TEST(test_nullptr_comparison);
+    RUN_TEST(test_storage_checks);
+    RUN_TEST(test_call_cost_against_a_raw_pointer_and_std_function);
+    return UNITY_END();
+}
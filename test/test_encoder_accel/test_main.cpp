@@ -0,0 +1,126 @@
+#include <unity.h>
+#include <stdio.h>
+#include "core/clock.h"
+#include "core/encoder_accel.h"
+
+#define DETENT ENCODER_STEPS_PER_DETENT
+
+// Constant-speed spin from 0 minutes: detents until the target is reached
+static int detentsToReach(int targetMinutes, uint32_t detentMs) {
+    EncoderAcceleration accel;
+    uint32_t now = US_PER_SEC;
+    int minutes = 0;
+    int detents = 0;
+    
+    while (minutes < targetMinutes && detents < 1000) {
+        minutes += accel.update(DETENT, now) * TIMER_STEP_MINUTES;
+        detents++;
+        now += MS_TO_US(detentMs);
+    }
+    return detents;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_slow_turns_keep_the_unaccelerated_rate() {
+    // At ENCODER_ACCEL_SLOW_MS and slower: ENCODER_STEPS_PER_INCREMENT detents per increment
+    const int slow = 25 / TIMER_STEP_MINUTES * ENCODER_STEPS_PER_INCREMENT;
+    const int full = MAX_TIMER_MINUTES / TIMER_STEP_MINUTES * ENCODER_STEPS_PER_INCREMENT;
+    TEST_ASSERT_EQUAL(slow, detentsToReach(25, ENCODER_ACCEL_SLOW_MS));
+    TEST_ASSERT_EQUAL(slow, detentsToReach(25, 1000));
+    TEST_ASSERT_EQUAL(full, detentsToReach(MAX_TIMER_MINUTES, ENCODER_ACCEL_SLOW_MS));
+    
+    // Just under the threshold is already faster
+    TEST_ASSERT_TRUE(detentsToReach(MAX_TIMER_MINUTES, ENCODER_ACCEL_SLOW_MS - 5) < full);
+}
+
+void test_spin_profiles() {
+    // Faster spins never take more detents; full speed at ENCODER_ACCEL_FAST_MS and below
+    const uint32_t speeds[] = { 1000, ENCODER_ACCEL_SLOW_MS, 100, 60, 40, ENCODER_ACCEL_FAST_MS, 8 };
+    int previous25 = 1000;
+    int previous60 = 1000;
+    
+    TEST_MESSAGE("ms/detent  detents to 25 min  detents to 60 min");
+    for (size_t i = 0; i < sizeof(speeds) / sizeof(speeds[0]); i++) {
+        int to25 = detentsToReach(25, speeds[i]);
+        int to60 = detentsToReach(MAX_TIMER_MINUTES, speeds[i]);
+        
+        char message[64];
+        snprintf(message, sizeof(message), "%9lu  %17d  %17d", (unsigned long)speeds[i], to25, to60);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_TRUE(to25 <= previous25);
+        TEST_ASSERT_TRUE(to60 <= previous60);
+        previous25 = to25;
+        previous60 = to60;
+    }
+    
+    // First detent is slow (no interval yet), then ENCODER_ACCEL_MAX increments each
+    const int fastFull = 1 + (MAX_TIMER_MINUTES / TIMER_STEP_MINUTES + ENCODER_ACCEL_MAX - 1) / ENCODER_ACCEL_MAX;
+    TEST_ASSERT_EQUAL(fastFull, detentsToReach(MAX_TIMER_MINUTES, ENCODER_ACCEL_FAST_MS));
+    TEST_ASSERT_EQUAL(fastFull, detentsToReach(MAX_TIMER_MINUTES, 8));
+}
+
+void test_partial_detents_wait_for_the_rest() {
+    EncoderAcceleration accel;
+    uint32_t now = US_PER_SEC;
+    int increments = 0;
+    
+    // Slow detents arriving in two pieces each
+    for (int i = 0; i < ENCODER_STEPS_PER_INCREMENT; i++) {
+        TEST_ASSERT_EQUAL(0, accel.update(DETENT - 1, now));
+        increments += accel.update(1, now);
+        now += MS_TO_US(500);
+    }
+    TEST_ASSERT_EQUAL(1, increments);
+    TEST_ASSERT_EQUAL_UINT32(MS_TO_US(500), accel.getDetentIntervalUs());
+}
+
+void test_reversal_drops_the_partial_increment() {
+    EncoderAcceleration accel;
+    uint32_t now = US_PER_SEC;
+    
+    // Two slow detents forward: most of an increment
+    TEST_ASSERT_EQUAL(0, accel.update(DETENT, now));
+    now += MS_TO_US(500);
+    TEST_ASSERT_EQUAL(0, accel.update(DETENT, now));
+    
+    // One back does not undo them; it starts a fresh count the other way
+    now += MS_TO_US(500);
+    TEST_ASSERT_EQUAL(0, accel.update(-DETENT, now));
+    TEST_ASSERT_EQUAL_UINT32(0, accel.getDetentIntervalUs());
+    now += MS_TO_US(500);
+    TEST_ASSERT_EQUAL(0, accel.update(-DETENT, now));
+    now += MS_TO_US(500);
+    TEST_ASSERT_EQUAL(-1, accel.update(-DETENT, now));
+}
+
+void test_detents_in_one_event_share_the_interval() {
+    // A loop pass that collected three detents over 30 ms: 10 ms each
+    EncoderAcceleration together;
+    uint32_t now = US_PER_SEC;
+    together.update(DETENT, now);
+    int batched = together.update(3 * DETENT, now + MS_TO_US(30));
+    TEST_ASSERT_EQUAL_UINT32(MS_TO_US(10), together.getDetentIntervalUs());
+    
+    EncoderAcceleration apart;
+    apart.update(DETENT, now);
+    int separate = 0;
+    for (int i = 1; i <= 3; i++) {
+        separate += apart.update(DETENT, now + MS_TO_US(10 * i));
+    }
+    TEST_ASSERT_EQUAL(separate, batched);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_slow_turns_keep_the_unaccelerated_rate);
+    RUN_TEST(test_spin_profiles);
+    RUN_TEST(test_partial_detents_wait_for_the_rest);
+    RUN_TEST(test_reversal_drops_the_partial_increment);
+    RUN_TEST(test_detents_in_one_event_share_the_interval);
+    return UNITY_END();
+}
@@ -0,0 +1,247 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "core/clock.h"
+#include "core/config.h"
+#include "core/flash.h"
+#include "core/history.h"
+
+// RAM-backed history partition (same size as in partitions.csv)
+#define PARTITION_SIZE 0x10000
+#define DAY 86400UL
+#define JAN_1_2026 1767225600UL
+static uint8_t flash[PARTITION_SIZE];
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static void advanceSeconds(uint32_t seconds) {
+    fakeNow += seconds * US_PER_SEC;
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+    memset(flash, 0xFF, sizeof(flash));
+    HostFlash::attach(HISTORY_PARTITION_LABEL, flash, sizeof(flash));
+}
+
+void tearDown() {
+    HostFlash::detachAll();
+    Clock::setSource(nullptr);
+}
+
+void test_no_days_or_streaks_without_wall_clock() {
+    SessionHistory history;
+    TEST_ASSERT_TRUE(history.init());
+    TEST_ASSERT_FALSE(history.hasTime());
+    
+    history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500);
+    advanceSeconds(DAY);
+    history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500);
+    
+    // Totals still count; calendar queries have nothing to go on
+    TEST_ASSERT_EQUAL_UINT32(2, history.getSummary().completed);
+    TEST_ASSERT_EQUAL_UINT32(3000, history.getSummary().workSeconds);
+    TEST_ASSERT_NULL(history.getDay(0));
+    TEST_ASSERT_EQUAL_UINT16(0, history.getCurrentStreak());
+    TEST_ASSERT_EQUAL_UINT16(0, history.getSummary().bestStreak);
+}
+
+void test_rejects_unset_time() {
+    SessionHistory history;
+    history.init();
+    TEST_ASSERT_FALSE(history.setTime(12345));
+    TEST_ASSERT_FALSE(history.hasTime());
+}
+
+void test_days_and_streak_with_wall_clock() {
+    SessionHistory history;
+    history.init();
+    TEST_ASSERT_TRUE(history.setTime(JAN_1_2026 + 9 * 3600));
+    
+    for (int day = 0; day < 3; day++) {
+        if (day > 0) {
+            advanceSeconds(DAY);
+        }
+        history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500);
+        history.record(SessionOutcome::CANCELLED, SessionType::WORK, 300);
+    }
+    
+    const DayTotals* today = history.getDay(0);
+    TEST_ASSERT_NOT_NULL(today);
+    TEST_ASSERT_EQUAL_UINT16(1, today->completed);
+    TEST_ASSERT_EQUAL_UINT16(1, today->cancelled);
+    TEST_ASSERT_EQUAL_UINT32(1500, today->workSeconds);
+    TEST_ASSERT_NOT_NULL(history.getDay(2));
+    TEST_ASSERT_NULL(history.getDay(3));
+    TEST_ASSERT_EQUAL_UINT16(3, history.getCurrentStreak());
+    TEST_ASSERT_EQUAL_UINT16(500, history.getCompletionPerMille());
+    
+    // A whole day without completed work ends the streak
+    advanceSeconds(2 * DAY);
+    TEST_ASSERT_EQUAL_UINT16(0, history.getCurrentStreak());
+    TEST_ASSERT_EQUAL_UINT16(3, history.getSummary().bestStreak);
+}
+
+void test_summary_rebuilt_after_reboot() {
+    {
+        SessionHistory history;
+        history.init();
+        history.setTime(JAN_1_2026);
+        for (int i = 0; i < 10; i++) {
+            history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500);
+            advanceSeconds(1800);
+        }
+        history.record(SessionOutcome::CANCELLED, SessionType::SHORT_BREAK, 60);
+    }
+    
+    fakeNow = 0;
+    SessionHistory rebooted;
+    TEST_ASSERT_TRUE(rebooted.init());
+    TEST_ASSERT_EQUAL_UINT32(11, rebooted.getRecordCount());
+    TEST_ASSERT_EQUAL_UINT32(10, rebooted.getSummary().completed);
+    TEST_ASSERT_EQUAL_UINT32(1, rebooted.getSummary().cancelled);
+    TEST_ASSERT_EQUAL(SessionType::SHORT_BREAK, rebooted.getRecord(0)->getType());
+    TEST_ASSERT_EQUAL_UINT16(1, rebooted.getSummary().bestStreak);
+}
+
+void test_partition_keeps_at_least_7680() {
+    SessionHistory history;
+    history.init();
+    for (uint32_t i = 0; i < 10000; i++) {
+        TEST_ASSERT_TRUE(history.record(SessionOutcome::COMPLETED, SessionType::WORK, i));
+    }
+    
+    // 8192 slots less the sector kept erased ahead of the head, plus the
+    // 10000 % 512 records already in the head sector
+    const uint32_t kept = 7680 + 10000 % 512;
+    TEST_ASSERT_EQUAL_UINT32(kept, history.getRecordCount());
+    TEST_ASSERT_EQUAL_UINT16(9999, history.getRecord(0)->durationSec);
+    TEST_ASSERT_EQUAL_UINT16(10000 - kept, history.getRecord(kept - 1)->durationSec);
+    TEST_ASSERT_NULL(history.getRecord(kept));
+    
+    SessionHistory rebooted;
+    rebooted.init();
+    TEST_ASSERT_EQUAL_UINT32(kept, rebooted.getRecordCount());
+    TEST_ASSERT_EQUAL_UINT32(kept, rebooted.getSummary().completed);
+}
+
+void test_sessions_recorded_before_mount_are_written_by_init() {
+    // Deferred boot: a restored session expires before the log is mounted
+    SessionHistory history;
+    advanceSeconds(5);
+    TEST_ASSERT_TRUE(history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500));
+    advanceSeconds(1);
+    TEST_ASSERT_TRUE(history.record(SessionOutcome::CANCELLED, SessionType::SHORT_BREAK, 60));
+    TEST_ASSERT_EQUAL_UINT32(0, history.getRecordCount());
+    
+    advanceSeconds(2);
+    TEST_ASSERT_TRUE(history.init());
+    TEST_ASSERT_EQUAL_UINT32(2, history.getRecordCount());
+    TEST_ASSERT_EQUAL_UINT32(1, history.getSummary().completed);
+    TEST_ASSERT_EQUAL_UINT32(1, history.getSummary().cancelled);
+    TEST_ASSERT_EQUAL_UINT32(1500, history.getSummary().workSeconds);
+    
+    // Stamped when they ended, in order, not when the log came up
+    TEST_ASSERT_EQUAL_UINT32(6, history.getRecord(0)->timestamp);
+    TEST_ASSERT_EQUAL_UINT32(5, history.getRecord(1)->timestamp);
+    TEST_ASSERT_TRUE(history.getRecord(0)->getType() == SessionType::SHORT_BREAK);
+    
+    // Written once: a reboot finds them in flash
+    SessionHistory rebooted;
+    TEST_ASSERT_TRUE(rebooted.init());
+    TEST_ASSERT_EQUAL_UINT32(2, rebooted.getRecordCount());
+}
+
+void test_pending_sessions_are_bounded() {
+    SessionHistory history;
+    for (int i = 0; i < HISTORY_PENDING; i++) {
+        TEST_ASSERT_TRUE(history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500));
+    }
+    TEST_ASSERT_FALSE(history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500));
+    
+    TEST_ASSERT_TRUE(history.init());
+    TEST_ASSERT_EQUAL_UINT32(HISTORY_PENDING, history.getRecordCount());
+    TEST_ASSERT_TRUE(history.record(SessionOutcome::COMPLETED, SessionType::WORK, 1500));
+    TEST_ASSERT_EQUAL_UINT32(HISTORY_PENDING + 1, history.getRecordCount());
+}
+
+void test_million_records_file_backed() {
+    // A log larger than any partition on the board, in a mapped file
+    const uint32_t records = 1000000;
+    const uint32_t size = (records / 512 + 2) * FLASH_SECTOR_SIZE;
+    char path[] = "/tmp/history_XXXXXX";
+    int fd = mkstemp(path);
+    TEST_ASSERT_TRUE(fd >= 0);
+    unlink(path);
+    TEST_ASSERT_EQUAL(0, ftruncate(fd, size));
+    uint8_t* file = (uint8_t*)mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    TEST_ASSERT_TRUE(file != MAP_FAILED);
+    memset(file, 0xFF, size);
+    HostFlash::attach(HISTORY_PARTITION_LABEL, file, size);
+    
+    {
+        SessionHistory history;
+        history.init();
+        history.setTime(JAN_1_2026);
+        for (uint32_t i = 0; i < records; i++) {
+            history.record((i % 5 == 4) ? SessionOutcome::CANCELLED : SessionOutcome::COMPLETED,
+                           SessionType::WORK, 1500);
+            advanceSeconds(60);
+        }
+    }
+    
+    // Boot: one pass over the mapped log rebuilds the summary
+    double start = steadySeconds();
+    SessionHistory history;
+    TEST_ASSERT_TRUE(history.init());
+    double rebuild = steadySeconds() - start;
+    TEST_ASSERT_EQUAL_UINT32(records, history.getRecordCount());
+    TEST_ASSERT_EQUAL_UINT32(records / 5, history.getSummary().cancelled);
+    
+    // Queries never scan the log
+    const int queries = 1000000;
+    volatile uint32_t sink = 0;
+    start = steadySeconds();
+    for (int i = 0; i < queries; i++) {
+        sink += history.getCompletionPerMille() + history.getSummary().completed;
+        const HistoryRecord* record = history.getRecord((uint32_t)i * 7919 % records);
+        sink += record->durationSec;
+    }
+    double query = (steadySeconds() - start) / queries;
+    (void)sink;
+    
+    char message[96];
+    snprintf(message, sizeof(message), "%lu records: rebuild %.1f ms, query %.1f ns",
+             (unsigned long)records, rebuild * 1e3, query * 1e9);
+    TEST_MESSAGE(message);
+    
+    munmap(file, size);
+    close(fd);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_no_days_or_streaks_without_wall_clock);
+    RUN_TEST(test_rejects_unset_time);
+    RUN_TEST(test_days_and_streak_with_wall_clock);
+    RUN_TEST(test_summary_rebuilt_after_reboot);
+    RUN_TEST(test_partition_keeps_at_least_7680);
+    RUN_TEST(test_sessions_recorded_before_mount_are_written_by_init);
+    RUN_TEST(test_pending_sessions_are_bounded);
+    RUN_TEST(test_million_records_file_backed);
+    return UNITY_END();
+}
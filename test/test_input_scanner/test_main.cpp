@@ -0,0 +1,200 @@
+#include <unity.h>
+#include "core/clock.h"
+#include "core/input_scanner.h"
+
+#define CLK_PIN 0
+#define DT_PIN 1
+#define BUTTON_A 2
+#define BUTTON_B 3
+#define IDLE_PINS 0xFFFFFFFFUL
+
+static uint64_t fakeNow = 0;
+static uint32_t livePins = IDLE_PINS;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static uint32_t liveSnapshot() {
+    return livePins;
+}
+
+// An edge as the interrupt sees it: new levels, latched at the current time
+static void edge(InputScanner& scanner, uint32_t pins) {
+    livePins = pins;
+    scanner.latch(pins, (uint32_t)fakeNow);
+}
+
+static uint32_t pressed(int pin) {
+    return livePins & ~(1UL << pin);
+}
+
+static uint32_t released(int pin) {
+    return livePins | (1UL << pin);
+}
+
+static uint32_t encoderState(uint8_t state) {
+    return (livePins & ~3UL) | ((state >> 1) & 1) << CLK_PIN | (state & 1) << DT_PIN;
+}
+
+static InputScanner scanner;
+
+void setUp() {
+    fakeNow = US_PER_SEC;
+    livePins = IDLE_PINS;
+    Clock::setSource(fakeClock);
+    scanner = InputScanner();
+    scanner.setSnapshotSource(liveSnapshot);
+    TEST_ASSERT_EQUAL(0, scanner.addEncoder(CLK_PIN, DT_PIN));
+    TEST_ASSERT_EQUAL(0, scanner.addButton(BUTTON_A));
+    TEST_ASSERT_EQUAL(1, scanner.addButton(BUTTON_B));
+    scanner.reset();
+}
+
+void tearDown() {
+    scanner.setSnapshotSource(nullptr);
+    Clock::setSource(nullptr);
+}
+
+void test_each_button_has_its_own_debounce_lockout() {
+    uint32_t pressB = 0;
+    uint32_t releaseB = 0;
+    
+    edge(scanner, pressed(BUTTON_A));
+    fakeNow += MS_TO_US(10);            // Inside A's lockout
+    edge(scanner, pressed(BUTTON_B));
+    pressB = (uint32_t)fakeNow;
+    fakeNow += MS_TO_US(90);
+    edge(scanner, released(BUTTON_A));
+    fakeNow += MS_TO_US(20);
+    edge(scanner, released(BUTTON_B));
+    releaseB = (uint32_t)fakeNow;
+    scanner.update();
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_EQUAL(InputEventType::CLICK, event.type);
+    TEST_ASSERT_EQUAL(0, event.source);
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_EQUAL(InputEventType::CLICK, event.type);
+    TEST_ASSERT_EQUAL(1, event.source);
+    TEST_ASSERT_EQUAL_UINT32(releaseB, event.timeUs);
+    TEST_ASSERT_TRUE(releaseB - pressB >= MS_TO_US(ENCODER_DEBOUNCE_MS));
+    TEST_ASSERT_FALSE(scanner.poll(event));
+}
+
+void test_bounces_inside_the_lockout_are_ignored() {
+    // Contact bounce on press and on release: one click
+    for (int i = 0; i < 6; i++) {
+        edge(scanner, (i & 1) ? released(BUTTON_A) : pressed(BUTTON_A));
+        fakeNow += 700;
+    }
+    edge(scanner, pressed(BUTTON_A));
+    fakeNow += MS_TO_US(200);
+    for (int i = 0; i < 5; i++) {
+        edge(scanner, (i & 1) ? pressed(BUTTON_A) : released(BUTTON_A));
+        fakeNow += 900;
+    }
+    scanner.update();
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_EQUAL(InputEventType::CLICK, event.type);
+    TEST_ASSERT_FALSE(scanner.poll(event));
+}
+
+void test_level_settled_during_the_lockout_is_taken_by_update() {
+    edge(scanner, pressed(BUTTON_A));
+    fakeNow += MS_TO_US(100);
+    edge(scanner, released(BUTTON_A));
+    fakeNow += 500;
+    edge(scanner, pressed(BUTTON_A));   // Bounce...
+    fakeNow += 500;
+    edge(scanner, released(BUTTON_A));  // ...settles released, inside the lockout
+    scanner.update();
+    
+    InputEvent event;
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_FALSE(scanner.poll(event));
+    
+    // No further edge: the live pins after the lockout agree with the button
+    fakeNow += MS_TO_US(ENCODER_DEBOUNCE_MS);
+    scanner.update();
+    TEST_ASSERT_FALSE(scanner.poll(event));
+}
+
+void test_long_press_fires_while_held() {
+    edge(scanner, pressed(BUTTON_B));
+    fakeNow += MS_TO_US(ENCODER_LONG_PRESS_MS) - 1;
+    scanner.update();
+    InputEvent event;
+    TEST_ASSERT_FALSE(scanner.poll(event));
+    
+    fakeNow += 1;
+    scanner.update();
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_EQUAL(InputEventType::LONG_PRESS, event.type);
+    TEST_ASSERT_EQUAL(1, event.source);
+    
+    // No click on release after a long press
+    edge(scanner, released(BUTTON_B));
+    scanner.update();
+    TEST_ASSERT_FALSE(scanner.poll(event));
+}
+
+void test_latched_quadrature_edges_decode_in_update() {
+    // One detent clockwise (11 -> 01 -> 00 -> 10 -> 11), then half back
+    const uint8_t states[] = { 1, 0, 2, 3, 2, 0 };
+    uint32_t lastEdge = 0;
+    for (int i = 0; i < 6; i++) {
+        fakeNow += 1500;
+        edge(scanner, encoderState(states[i]));
+        lastEdge = (uint32_t)fakeNow;
+    }
+    
+    InputEvent event;
+    TEST_ASSERT_FALSE(scanner.poll(event));     // Nothing decoded in the interrupt
+    scanner.update();
+    TEST_ASSERT_TRUE(scanner.poll(event));
+    TEST_ASSERT_EQUAL(InputEventType::ROTATE, event.type);
+    TEST_ASSERT_EQUAL(2, event.steps);
+    TEST_ASSERT_EQUAL_UINT32(lastEdge, event.timeUs);
+}
+
+void test_full_ring_drops_edges_and_update_resyncs() {
+    // More edges than the ring holds before the loop gets to run
+    for (int i = 0; i < INPUT_SAMPLE_RING + 8; i++) {
+        fakeNow += 100;
+        edge(scanner, (i & 1) ? released(BUTTON_A) : pressed(BUTTON_A));
+    }
+    TEST_ASSERT_EQUAL_UINT32(8, scanner.getDroppedSamples());
+    
+    edge(scanner, released(BUTTON_A));  // Also dropped
+    fakeNow += MS_TO_US(ENCODER_DEBOUNCE_MS);
+    scanner.update();
+    
+    // The live pins bring the button back to released, then new edges latch again
+    fakeNow += MS_TO_US(100);
+    edge(scanner, pressed(BUTTON_A));
+    fakeNow += MS_TO_US(100);
+    edge(scanner, released(BUTTON_A));
+    scanner.update();
+    
+    InputEvent event;
+    int clicks = 0;
+    while (scanner.poll(event)) {
+        clicks += event.type == InputEventType::CLICK;
+    }
+    TEST_ASSERT_EQUAL(2, clicks);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_each_button_has_its_own_debounce_lockout);
+    RUN_TEST(test_bounces_inside_the_lockout_are_ignored);
+    RUN_TEST(test_level_settled_during_the_lockout_is_taken_by_update);
+    RUN_TEST(test_long_press_fires_while_held);
+    RUN_TEST(test_latched_quadrature_edges_decode_in_update);
+    RUN_TEST(test_full_ring_drops_edges_and_update_resyncs);
+    return UNITY_END();
+}
@@ -0,0 +1,97 @@
+#include <unity.h>
+#include <string.h>
+#include "core/crc.h"
+#include "core/frame_capture.h"
+
+// Minimal decoder mirroring tools/capture_decode.py
+struct CaptureReader {
+    uint64_t timestamp;
+    uint8_t frame[NUM_LEDS * 3];
+    bool haveFrame;
+    
+    bool read(const uint8_t* packet, size_t length) {
+        size_t body = packet[2] | (packet[3] << 8);
+        if (length != CAPTURE_HEADER_BYTES + body + 1 || crc8(packet + 1, 3 + body) != packet[length - 1]) {
+            return false;
+        }
+        const uint8_t* data = packet + CAPTURE_HEADER_BYTES;
+        
+        if (packet[1] == CAPTURE_KEYFRAME) {
+            timestamp = 0;
+            for (int i = CAPTURE_KEYFRAME_STAMP - 1; i >= 0; i--) {
+                timestamp = (timestamp << 8) | data[i];
+            }
+            memcpy(frame, data + CAPTURE_KEYFRAME_STAMP, body - CAPTURE_KEYFRAME_STAMP);
+            haveFrame = true;
+            return true;
+        }
+        
+        if (!haveFrame) {
+            return false;
+        }
+        timestamp += data[0] | (data[1] << 8);
+        size_t pos = 0;
+        for (size_t i = 2; i < body;) {
+            uint8_t token = data[i++];
+            size_t count = (token & 0x7F) + 1;
+            if (!(token & 0x80)) {
+                for (size_t k = 0; k < count; k++) {
+                    frame[pos + k] ^= data[i++];
+                }
+            }
+            pos += count;
+        }
+        return pos == sizeof(frame);
+    }
+};
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_keyframe_carries_the_full_64_bit_timestamp() {
+    FrameCapture capture;
+    CaptureReader reader = {};
+    uint8_t packet[CAPTURE_PACKET_MAX];
+    CRGB frame[NUM_LEDS];
+    
+    // Past 2^32 us (71.6 minutes of uptime)
+    const uint64_t start = 0x123456789AULL;
+    frame[0] = CRGB(1, 2, 3);
+    size_t length = capture.encode(frame, NUM_LEDS, start, packet);
+    TEST_ASSERT_EQUAL_UINT8(CAPTURE_KEYFRAME, packet[1]);
+    TEST_ASSERT_TRUE(reader.read(packet, length));
+    TEST_ASSERT_EQUAL_UINT64(start, reader.timestamp);
+}
+
+void test_deltas_rebuild_frames_and_time_across_the_32_bit_boundary() {
+    FrameCapture capture;
+    CaptureReader reader = {};
+    uint8_t packet[CAPTURE_PACKET_MAX];
+    CRGB frame[NUM_LEDS];
+    
+    uint64_t now = 0xFFFFFFFFULL - 50000;
+    int deltas = 0;
+    for (int f = 0; f < 200; f++) {
+        frame[f % NUM_LEDS] = CRGB(f, 255 - f, f * 3);
+        size_t length = capture.encode(frame, NUM_LEDS, now, packet);
+        deltas += packet[1] == CAPTURE_DELTA;
+        
+        TEST_ASSERT_TRUE(reader.read(packet, length));
+        TEST_ASSERT_EQUAL_UINT64(now, reader.timestamp);
+        TEST_ASSERT_EQUAL_MEMORY(frame, reader.frame, sizeof(frame));
+        now += 16667;
+    }
+    
+    // Periodic keyframes in between, the rest deltas
+    TEST_ASSERT_TRUE(deltas >= 200 - 200 / CAPTURE_KEYFRAME_INTERVAL - 1);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_keyframe_carries_the_full_64_bit_timestamp);
+    RUN_TEST(test_deltas_rebuild_frames_and_time_across_the_32_bit_boundary);
+    return UNITY_END();
+}
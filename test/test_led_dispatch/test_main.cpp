@@ -0,0 +1,183 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "core/animations.h"
+#include "core/clock.h"
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_draw_matches_update() {
+    // Both paths run the same kernel; only the dispatch differs
+    static CRGB typedLeds[NUM_LEDS];
+    static CRGB genericLeds[NUM_LEDS];
+    AnimationManager typed(typedLeds, NUM_LEDS);
+    AnimationManager generic(genericLeds, NUM_LEDS);
+    typed.setAnimation(AnimationType::COUNTDOWN);
+    generic.setAnimation(AnimationType::COUNTDOWN);
+    
+    for (int step = 0; step <= 100; step++) {
+        CountdownParams countdown;
+        countdown.progress = step / 100.0f;
+        countdown.color = CRGB::Orange;
+        countdown.timestamp = step;
+        typed.draw(countdown);
+        typed.show();
+        
+        AnimationParams params;
+        params.progress = countdown.progress;
+        params.primaryColor = CRGB::Orange;
+        params.secondaryColor = CRGB::Black;
+        params.brightness = 255;
+        params.timestamp = step;
+        generic.update(params);
+        generic.show();
+        
+        TEST_ASSERT_EQUAL_MEMORY(generic.getFrame(), typed.getFrame(), sizeof(typedLeds));
+    }
+}
+
+static void drawCountdown(AnimationManager& manager, float progress, CRGB color) {
+    CountdownParams params;
+    params.progress = progress;
+    params.color = color;
+    params.timestamp = fakeNow;
+    manager.draw(params);
+    manager.show();
+}
+
+void test_prepared_countdown_matches_a_fresh_render() {
+    // Prepared at one progress, drawn at a later one: the copy may only be
+    // used when the kernel would write the same pixels
+    static CRGB preparedLeds[NUM_LEDS];
+    static CRGB freshLeds[NUM_LEDS];
+    AnimationManager prepared(preparedLeds, NUM_LEDS);
+    AnimationManager fresh(freshLeds, NUM_LEDS);
+    prepared.setAnimation(AnimationType::COUNTDOWN);
+    fresh.setAnimation(AnimationType::COUNTDOWN);
+    
+    const float start = 0.7f;
+    for (int step = 0; step < 2000; step++) {
+        float progress = start - step * 0.00002f;
+        CountdownParams params;
+        params.progress = start;
+        params.color = CRGB::Blue;
+        params.timestamp = fakeNow;
+        prepared.prepare(params);
+        
+        drawCountdown(prepared, progress, CRGB::Blue);
+        drawCountdown(fresh, progress, CRGB::Blue);
+        TEST_ASSERT_EQUAL_MEMORY(fresh.getFrame(), prepared.getFrame(), sizeof(freshLeds));
+    }
+    
+    // Another colour is not the prepared frame either
+    CountdownParams params;
+    params.progress = start;
+    params.color = CRGB::Blue;
+    params.timestamp = fakeNow;
+    prepared.prepare(params);
+    drawCountdown(prepared, start, CRGB::Orange);
+    drawCountdown(fresh, start, CRGB::Orange);
+    TEST_ASSERT_EQUAL_MEMORY(fresh.getFrame(), prepared.getFrame(), sizeof(freshLeds));
+}
+
+void test_prepare_leaves_the_frame_in_flight_alone() {
+    static CRGB leds[NUM_LEDS];
+    static CRGB freshLeds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    AnimationManager fresh(freshLeds, NUM_LEDS);
+    manager.setAnimation(AnimationType::SOLID_COLOR);
+    manager.setColors(CRGB::Green);
+    
+    AnimationParams solid;
+    solid.progress = 1.0f;
+    solid.primaryColor = CRGB::Green;
+    solid.secondaryColor = CRGB::Black;
+    solid.brightness = 255;
+    solid.timestamp = fakeNow;
+    manager.update(solid);
+    manager.show();
+    CRGB before[NUM_LEDS];
+    memcpy(before, manager.getFrame(), sizeof(before));
+    
+    // Preparing neither queues a frame nor touches the back buffer
+    CountdownParams params;
+    params.progress = 0.5f;
+    params.color = CRGB::Red;
+    params.timestamp = fakeNow;
+    manager.prepare(params);
+    manager.show();
+    TEST_ASSERT_EQUAL_MEMORY(before, manager.getFrame(), sizeof(before));
+    manager.update(solid);
+    manager.show();
+    TEST_ASSERT_EQUAL_MEMORY(before, manager.getFrame(), sizeof(before));
+    
+    // The state change hands over to the prepared frame
+    manager.setAnimation(AnimationType::COUNTDOWN);
+    fresh.setAnimation(AnimationType::COUNTDOWN);
+    drawCountdown(manager, 0.5f, CRGB::Red);
+    drawCountdown(fresh, 0.5f, CRGB::Red);
+    TEST_ASSERT_EQUAL_MEMORY(fresh.getFrame(), manager.getFrame(), sizeof(freshLeds));
+}
+
+void test_benchmark_typed_draw_against_switch_dispatch() {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::COUNTDOWN);
+    const int frames = 2000000;
+    
+    double start = steadySeconds();
+    for (int f = 0; f < frames; f++) {
+        CountdownParams params;
+        params.progress = (float)(f & 1023) / 1024.0f;
+        params.color = CRGB::Red;
+        params.timestamp = f;
+        manager.draw(params);
+    }
+    double typed = (steadySeconds() - start) / frames;
+    
+    start = steadySeconds();
+    for (int f = 0; f < frames; f++) {
+        AnimationParams params;
+        params.progress = (float)(f & 1023) / 1024.0f;
+        params.primaryColor = CRGB::Red;
+        params.secondaryColor = CRGB::Black;
+        params.brightness = 255;
+        params.timestamp = f;
+        manager.update(params);
+    }
+    double generic = (steadySeconds() - start) / frames;
+    
+    char message[96];
+    snprintf(message, sizeof(message), "COUNTDOWN %d px: draw() %.1f ns, update() %.1f ns per frame",
+             NUM_LEDS, typed * 1e9, generic * 1e9);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_draw_matches_update);
+    RUN_TEST(test_prepared_countdown_matches_a_fresh_render);
+    RUN_TEST(test_prepare_leaves_the_frame_in_flight_alone);
+    RUN_TEST(test_benchmark_typed_draw_against_switch_dispatch);
+    return UNITY_END();
+}
@@ -0,0 +1,179 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "core/animations.h"
+
+// Cached and live managers side by side: same animation, same params
+static CRGB cachedLeds[NUM_LEDS];
+static CRGB liveLeds[NUM_LEDS];
+static AnimationManager* cached;
+static AnimationManager* live;
+
+static AnimationParams paramsAt(uint64_t timestamp, CRGB color) {
+    AnimationParams params;
+    params.progress = 0.0f;
+    params.primaryColor = color;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    params.timestamp = timestamp;
+    return params;
+}
+
+static void renderBoth(uint64_t timestamp, CRGB color = CRGB::Green) {
+    AnimationParams params = paramsAt(timestamp, color);
+    cached->update(params);
+    cached->show();
+    live->update(params);
+    live->show();
+}
+
+// Largest channel difference between the two frames
+static int frameError() {
+    const CRGB* a = cached->getFrame();
+    const CRGB* b = live->getFrame();
+    int worst = 0;
+    for (int i = 0; i < NUM_LEDS; i++) {
+        for (int c = 0; c < 3; c++) {
+            int diff = abs((int)a[i].raw[c] - (int)b[i].raw[c]);
+            worst = (diff > worst) ? diff : worst;
+        }
+    }
+    return worst;
+}
+
+static void useAnimation(AnimationType type) {
+    cached->setAnimation(type);
+    live->setAnimation(type);
+}
+
+void setUp() {
+    cached = new AnimationManager(cachedLeds, NUM_LEDS);
+    live = new AnimationManager(liveLeds, NUM_LEDS);
+    cached->setFrameCacheEnabled(true);
+    live->setFrameCacheEnabled(false);
+}
+
+void tearDown() {
+    delete cached;
+    delete live;
+}
+
+void test_cache_follows_the_config_flag() {
+    AnimationManager manager(liveLeds, NUM_LEDS);
+    manager.setAnimation(AnimationType::PULSE);
+    manager.update(paramsAt(0, CRGB::Green));
+    TEST_ASSERT_EQUAL(ANIM_FRAME_CACHE ? 188 : 0, manager.getFrameCacheFrames());
+}
+
+void test_bake_samples_one_period_at_the_frame_interval() {
+    useAnimation(AnimationType::PULSE);
+    TEST_ASSERT_EQUAL(0, cached->getFrameCacheFrames());
+    renderBoth(0);
+    
+    // 3 s at 16 ms
+    TEST_ASSERT_EQUAL(188, cached->getFrameCacheFrames());
+    TEST_ASSERT_EQUAL(0, live->getFrameCacheFrames());
+}
+
+void test_playback_is_exact_on_table_steps() {
+    const AnimationType types[] = { AnimationType::PULSE, AnimationType::FLASH_COMPLETE,
+                                    AnimationType::FLASH_CANCELLED };
+    const uint32_t periods[] = { 3000000UL, 1000000UL, 800000UL };
+    
+    for (int t = 0; t < 3; t++) {
+        useAnimation(types[t]);
+        uint32_t step = AnimationManager::frameCacheStep(periods[t]);
+        for (uint32_t f = 0; f * step < periods[t]; f++) {
+            // A later period lands on the same table entry
+            renderBoth(3ULL * periods[t] + f * step);
+            TEST_ASSERT_EQUAL(0, frameError());
+        }
+    }
+}
+
+void test_playback_stays_within_one_step_of_the_live_frame() {
+    // Between steps the cached frame holds the level of the step before;
+    // the fastest flash changes most over one step
+    const AnimationType types[] = { AnimationType::PULSE, AnimationType::FLASH_COMPLETE,
+                                    AnimationType::FLASH_CANCELLED };
+    const uint32_t periods[] = { 3000000UL, 1000000UL, 800000UL };
+    const int tolerance[] = { 6, 16, 20 };
+    char message[96];
+    
+    for (int t = 0; t < 3; t++) {
+        useAnimation(types[t]);
+        int worst = 0;
+        for (uint32_t us = 0; us < periods[t]; us += 1000) {
+            renderBoth(us);
+            int error = frameError();
+            worst = (error > worst) ? error : worst;
+        }
+        snprintf(message, sizeof(message), "type %d: max error %d/255 with a %lu us step", (int)types[t],
+                 worst, (unsigned long)AnimationManager::frameCacheStep(periods[t]));
+        TEST_MESSAGE(message);
+        TEST_ASSERT_TRUE(worst <= tolerance[t]);
+    }
+}
+
+void test_colour_and_brightness_do_not_rebake() {
+    // The table holds levels only: colour is applied at playback
+    useAnimation(AnimationType::PULSE);
+    renderBoth(500000, CRGB::Green);
+    cached->setColors(CRGB::Blue);
+    cached->setBrightness(40);
+    live->setBrightness(40);
+    renderBoth(3000000UL + 512000, CRGB::Blue);
+    TEST_ASSERT_EQUAL(188, cached->getFrameCacheFrames());
+    TEST_ASSERT_EQUAL(0, frameError());
+}
+
+void test_type_change_and_invalidate_rebake() {
+    useAnimation(AnimationType::PULSE);
+    renderBoth(0);
+    TEST_ASSERT_EQUAL(188, cached->getFrameCacheFrames());
+    
+    // 1 s at 16 ms
+    useAnimation(AnimationType::FLASH_COMPLETE);
+    renderBoth(0);
+    TEST_ASSERT_EQUAL(63, cached->getFrameCacheFrames());
+    
+    cached->invalidateFrameCache();
+    TEST_ASSERT_EQUAL(0, cached->getFrameCacheFrames());
+    renderBoth(64000);
+    TEST_ASSERT_EQUAL(63, cached->getFrameCacheFrames());
+    TEST_ASSERT_EQUAL(0, frameError());
+    
+    // Not periodic: no table
+    cached->invalidateFrameCache();
+    useAnimation(AnimationType::SOLID_COLOR);
+    renderBoth(0);
+    TEST_ASSERT_EQUAL(0, cached->getFrameCacheFrames());
+    TEST_ASSERT_EQUAL(0, frameError());
+}
+
+void test_long_periods_are_stepped_to_fit_the_cap() {
+    // Built-ins fit at the frame interval
+    TEST_ASSERT_EQUAL_UINT32(ANIMATION_INTERVAL * 1000UL, AnimationManager::frameCacheStep(3000000UL));
+    
+    // Longer periods get a coarser step, never more frames than bytes
+    const uint32_t periods[] = { ANIM_FRAME_CACHE_BYTES * ANIMATION_INTERVAL * 1000UL + 1, 10000000UL,
+                                 60000000UL, 0xFFFFFFFFUL };
+    for (int i = 0; i < 4; i++) {
+        uint32_t step = AnimationManager::frameCacheStep(periods[i]);
+        uint32_t frames = (uint32_t)(((uint64_t)periods[i] + step - 1) / step);
+        TEST_ASSERT_TRUE(step > ANIMATION_INTERVAL * 1000UL);
+        TEST_ASSERT_TRUE(frames <= ANIM_FRAME_CACHE_BYTES);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cache_follows_the_config_flag);
+    RUN_TEST(test_bake_samples_one_period_at_the_frame_interval);
+    RUN_TEST(test_playback_is_exact_on_table_steps);
+    RUN_TEST(test_playback_stays_within_one_step_of_the_live_frame);
+    RUN_TEST(test_colour_and_brightness_do_not_rebake);
+    RUN_TEST(test_type_change_and_invalidate_rebake);
+    RUN_TEST(test_long_periods_are_stepped_to_fit_the_cap);
+    return UNITY_END();
+}
@@ -0,0 +1,207 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "core/animations.h"
+#include "core/clock.h"
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static AnimationParams paramsAt(uint64_t timestamp, float progress, CRGB color) {
+    AnimationParams params;
+    params.progress = progress;
+    params.primaryColor = color;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    params.timestamp = timestamp;
+    return params;
+}
+
+// Holds each frame "on the wire" for a number of polls and checks that
+// nothing writes to it meanwhile
+class WireCheckOutput : public LedOutput {
+public:
+    WireCheckOutput(int busyPolls) : busyPolls(busyPolls), remaining(0), onWire(nullptr),
+                                     count(0), frames(0), torn(0) {}
+    
+    bool init(int numLeds) override { return true; }
+    
+    bool submit(const CRGB* frame, int numLeds) override {
+        checkWire();
+        onWire = frame;
+        count = numLeds;
+        memcpy(sent, frame, numLeds * sizeof(CRGB));
+        remaining = busyPolls;
+        frames++;
+        return true;
+    }
+    
+    bool isReady() const override {
+        return remaining == 0;
+    }
+    
+    void setBrightness(uint8_t brightness) override {}
+    
+    // One poll of the wire: the frame must still be what was sent
+    void tick() {
+        checkWire();
+        if (remaining > 0) {
+            remaining--;
+        }
+    }
+    
+    int busyPolls;
+    int remaining;
+    const CRGB* onWire;
+    int count;
+    CRGB sent[NUM_LEDS];
+    int frames;
+    int torn;
+
+private:
+    void checkWire() {
+        if (onWire != nullptr && memcmp(onWire, sent, count * sizeof(CRGB)) != 0) {
+            torn++;
+        }
+    }
+};
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_led_count_is_clamped_to_scratch_frames() {
+    // A caller asking for more LEDs than NUM_LEDS gets NUM_LEDS
+    static CRGB strip[NUM_LEDS * 4];
+    for (int i = 0; i < NUM_LEDS * 4; i++) {
+        strip[i] = CRGB(0x5A, 0x5A, 0x5A);
+    }
+    AnimationManager manager(strip, NUM_LEDS * 4);
+    manager.setAnimation(AnimationType::SOLID_COLOR);
+    
+    WireCheckOutput output(0);
+    TEST_ASSERT_FALSE(manager.addOutput(&output, 0, NUM_LEDS + 1));
+    TEST_ASSERT_EQUAL(-1, manager.addSegment("extra", NUM_LEDS, 4, AnimationType::PULSE));
+    manager.setOutput(&output);
+    
+    for (int f = 0; f < 20; f++) {
+        fakeNow += 16000;
+        manager.update(paramsAt(fakeNow, 0.5f, CRGB::Blue));
+        manager.show();
+        if (f == 5) {
+            manager.setAnimation(AnimationType::PULSE, 100);
+            manager.clear();
+        }
+    }
+    
+    TEST_ASSERT_EQUAL(NUM_LEDS, output.count);
+    for (int i = NUM_LEDS; i < NUM_LEDS * 4; i++) {
+        TEST_ASSERT_TRUE(strip[i] == CRGB(0x5A, 0x5A, 0x5A));
+    }
+}
+
+void test_frames_on_the_wire_are_never_written() {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    WireCheckOutput output(3);      // Each frame takes three loop passes to send
+    manager.setOutput(&output);
+    manager.setAnimation(AnimationType::COUNTDOWN);
+    
+    // Render every pass, with crossfades started while frames are on the wire
+    const AnimationType types[] = { AnimationType::PULSE, AnimationType::COMET, AnimationType::COUNTDOWN };
+    for (int pass = 0; pass < 600; pass++) {
+        fakeNow += 4000;
+        if (pass % 97 == 50) {
+            manager.setAnimation(types[(pass / 97) % 3], 120);
+        }
+        manager.update(paramsAt(fakeNow, (pass % 100) / 100.0f, CRGB(pass, 255 - pass, 7)));
+        manager.show();
+        output.tick();
+    }
+    
+    TEST_ASSERT_EQUAL(0, output.torn);
+    TEST_ASSERT_TRUE(output.frames >= 600 / 4);     // Pending frames never block the loop
+}
+
+void test_crossfade_runs_from_the_wire_frame_to_the_new_animation() {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::SOLID_COLOR);
+    manager.update(paramsAt(fakeNow, 1.0f, CRGB::Red));
+    manager.show();
+    
+    manager.setAnimation(AnimationType::COUNTDOWN, 100);
+    TEST_ASSERT_TRUE(manager.isCrossfading());
+    
+    // Halfway: an even integer lerp of red and blue
+    fakeNow += MS_TO_US(50);
+    manager.update(paramsAt(fakeNow, 1.0f, CRGB::Blue));
+    manager.show();
+    const CRGB* frame = manager.getFrame();
+    for (int i = 0; i < NUM_LEDS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(127, frame[i].r);
+        TEST_ASSERT_EQUAL_UINT8(127, frame[i].b);
+    }
+    
+    // Done: exactly the new animation
+    fakeNow += MS_TO_US(50);
+    manager.update(paramsAt(fakeNow, 1.0f, CRGB::Blue));
+    manager.show();
+    TEST_ASSERT_FALSE(manager.isCrossfading());
+    frame = manager.getFrame();
+    for (int i = 0; i < NUM_LEDS; i++) {
+        TEST_ASSERT_TRUE(frame[i] == CRGB(CRGB::Blue));
+    }
+}
+
+void test_benchmark_crossfade_cost() {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::COUNTDOWN);
+    const int frames = 1000000;
+    double times[2];
+    
+    for (int fading = 0; fading < 2; fading++) {
+        double start = steadySeconds();
+        for (int f = 0; f < frames; f++) {
+            // Restart the fade before it ends so every frame blends
+            if (fading && (f % 1000) == 0) {
+                manager.startCrossfade(60000);
+            }
+            fakeNow += 1000;
+            manager.update(paramsAt(fakeNow, (f & 1023) / 1024.0f, CRGB::Red));
+            manager.show();
+        }
+        times[fading] = (steadySeconds() - start) / frames;
+        manager.startCrossfade(0);
+    }
+    
+    char message[96];
+    snprintf(message, sizeof(message), "COUNTDOWN %d px: %.0f ns/frame, %.0f ns/frame while crossfading",
+             NUM_LEDS, times[0] * 1e9, times[1] * 1e9);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_led_count_is_clamped_to_scratch_frames);
+    RUN_TEST(test_frames_on_the_wire_are_never_written);
+    RUN_TEST(test_crossfade_runs_from_the_wire_frame_to_the_new_animation);
+    RUN_TEST(test_benchmark_crossfade_cost);
+    return UNITY_END();
+}
@@ -0,0 +1,191 @@
+#include <unity.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "core/frame_render.h"
+
+// Golden-frame regression suite. Each timeline is rendered on the virtual
+// clock and every GOLDEN_STRIDE-th frame is compared with golden_frames.h.
+// After an intended change to an animation, regenerate the goldens with
+//     GOLDEN_UPDATE=test/test_led_golden/golden_frames.h pio test -e native_led -f test_led_golden
+// and review the diff like any other change.
+
+#define GOLDEN_STRIDE 4         // Frames between stored goldens
+#define GOLDEN_TOLERANCE 2      // Per channel, for float rounding across compilers
+#define GOLDEN_MAX_FRAMES 64
+
+struct GoldenTimeline {
+    const char* name;
+    const TimelineStep* steps;
+    int stepCount;
+};
+
+static const TimelineStep COUNTDOWN_STEPS[] = {
+    { AnimationType::COUNTDOWN, 1000, 1.0f, 0.0f, CRGB(255, 0, 0), 0 },
+};
+static const TimelineStep COMET_STEPS[] = {
+    { AnimationType::COMET, 1000, 0.0f, 0.0f, CRGB(0, 0, 255), 0 },
+};
+static const TimelineStep PULSE_STEPS[] = {
+    { AnimationType::PULSE, 1000, 0.0f, 0.0f, CRGB(0, 255, 0), 0 },
+};
+static const TimelineStep TIME_SELECTION_STEPS[] = {
+    { AnimationType::TIME_SELECTION, 1000, 0.0f, 1.0f, CRGB(255, 0, 0), 0 },
+};
+static const TimelineStep GAUGE_SWEEP_STEPS[] = {
+    { AnimationType::GAUGE_SWEEP, 800, 0.0f, 1.0f, CRGB(255, 0, 0), 0 },
+};
+static const TimelineStep CROSSFADE_STEPS[] = {
+    { AnimationType::COUNTDOWN, 300, 0.4f, 0.3f, CRGB(255, 0, 0), 0 },
+    { AnimationType::FLASH_COMPLETE, 700, 1.0f, 1.0f, CRGB(0, 255, 0), 250 },
+};
+
+#define TIMELINE(name, steps) { name, steps, (int)(sizeof(steps) / sizeof(steps[0])) }
+
+static const GoldenTimeline TIMELINES[] = {
+    TIMELINE("COUNTDOWN", COUNTDOWN_STEPS),
+    TIMELINE("COMET", COMET_STEPS),
+    TIMELINE("PULSE", PULSE_STEPS),
+    TIMELINE("TIME_SELECTION", TIME_SELECTION_STEPS),
+    TIMELINE("GAUGE_SWEEP", GAUGE_SWEEP_STEPS),
+    TIMELINE("CROSSFADE", CROSSFADE_STEPS),
+};
+static const int TIMELINE_COUNT = (int)(sizeof(TIMELINES) / sizeof(TIMELINES[0]));
+
+#include "golden_frames.h"
+
+// Sampled frames of the timeline being rendered
+static CRGB sampled[GOLDEN_MAX_FRAMES][NUM_LEDS];
+static uint32_t sampledCount = 0;
+
+static void sampleFrame(const CRGB* frame, int numLeds, uint32_t frameIndex) {
+    if ((frameIndex % GOLDEN_STRIDE) == 0 && sampledCount < GOLDEN_MAX_FRAMES) {
+        memcpy(sampled[sampledCount++], frame, numLeds * sizeof(CRGB));
+    }
+}
+
+static uint32_t renderTimeline(const TimelineStep* steps, int stepCount) {
+    FrameRenderer renderer;
+    sampledCount = 0;
+    renderer.render(steps, stepCount, sampleFrame);
+    return sampledCount;
+}
+
+static void checkTimeline(int timeline) {
+    const GoldenTimeline& golden = TIMELINES[timeline];
+    uint32_t frames = renderTimeline(golden.steps, golden.stepCount);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(GOLDEN_FRAME_COUNTS[timeline], frames, golden.name);
+    
+    const CRGB* reference = (const CRGB*)GOLDEN_FRAMES[timeline];
+    for (uint32_t f = 0; f < frames; f++) {
+        uint32_t mismatches = FrameRenderer::compareFrames(sampled[f], reference + f * NUM_LEDS,
+                                                           NUM_LEDS, GOLDEN_TOLERANCE);
+        if (mismatches != 0) {
+            char message[96];
+            snprintf(message, sizeof(message), "%s frame %lu: %lu channels off the golden",
+                     golden.name, (unsigned long)(f * GOLDEN_STRIDE), (unsigned long)mismatches);
+            TEST_FAIL_MESSAGE(message);
+        }
+    }
+}
+
+// Writes golden_frames.h from the current renderer
+static bool writeGoldens(const char* path) {
+    FILE* file = fopen(path, "w");
+    if (file == nullptr) {
+        return false;
+    }
+    
+    fprintf(file, "// Generated by test_led_golden (GOLDEN_UPDATE); review changes like code.\n");
+    fprintf(file, "// One frame in %d of each timeline, %d LEDs, R,G,B bytes.\n\n", GOLDEN_STRIDE, NUM_LEDS);
+    for (int t = 0; t < TIMELINE_COUNT; t++) {
+        uint32_t frames = renderTimeline(TIMELINES[t].steps, TIMELINES[t].stepCount);
+        fprintf(file, "static const uint8_t GOLDEN_%s[] = {", TIMELINES[t].name);
+        const uint8_t* bytes = (const uint8_t*)sampled;
+        for (uint32_t i = 0; i < frames * NUM_LEDS * 3; i++) {
+            fprintf(file, "%s0x%02x,", (i % 12) == 0 ? "\n    " : " ", bytes[i]);
+        }
+        fprintf(file, "\n};\n\n");
+    }
+    
+    fprintf(file, "static const uint8_t* const GOLDEN_FRAMES[] = {\n");
+    for (int t = 0; t < TIMELINE_COUNT; t++) {
+        fprintf(file, "    GOLDEN_%s,\n", TIMELINES[t].name);
+    }
+    fprintf(file, "};\n\nstatic const uint32_t GOLDEN_FRAME_COUNTS[] = {\n");
+    for (int t = 0; t < TIMELINE_COUNT; t++) {
+        fprintf(file, "    sizeof(GOLDEN_%s) / (NUM_LEDS * 3),\n", TIMELINES[t].name);
+    }
+    fprintf(file, "};\n");
+    
+    fclose(file);
+    return true;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_goldens_cover_every_timeline() {
+    TEST_ASSERT_EQUAL(TIMELINE_COUNT, (int)(sizeof(GOLDEN_FRAMES) / sizeof(GOLDEN_FRAMES[0])));
+}
+
+void test_countdown_matches_golden() {
+    checkTimeline(0);
+}
+
+void test_comet_matches_golden() {
+    checkTimeline(1);
+}
+
+void test_pulse_matches_golden() {
+    checkTimeline(2);
+}
+
+void test_time_selection_matches_golden() {
+    checkTimeline(3);
+}
+
+void test_gauge_sweep_matches_golden() {
+    checkTimeline(4);
+}
+
+void test_crossfade_matches_golden() {
+    checkTimeline(5);
+}
+
+void test_changed_animation_is_caught() {
+    // The countdown in another color must not pass as the golden
+    TimelineStep changed = COUNTDOWN_STEPS[0];
+    changed.color = CRGB(250, 0, 0);
+    uint32_t frames = renderTimeline(&changed, 1);
+    
+    uint32_t mismatches = 0;
+    for (uint32_t f = 0; f < frames; f++) {
+        mismatches += FrameRenderer::compareFrames(sampled[f], (const CRGB*)GOLDEN_COUNTDOWN + f * NUM_LEDS,
+                                                   NUM_LEDS, GOLDEN_TOLERANCE);
+    }
+    TEST_ASSERT_TRUE(mismatches > 0);
+}
+
+int main() {
+    const char* update = getenv("GOLDEN_UPDATE");
+    if (update != nullptr) {
+        bool written = writeGoldens(update);
+        printf("%s %s\n", written ? "Wrote" : "Could not write", update);
+        return written ? 0 : 1;
+    }
+    
+    UNITY_BEGIN();
+    RUN_TEST(test_goldens_cover_every_timeline);
+    RUN_TEST(test_countdown_matches_golden);
+    RUN_TEST(test_comet_matches_golden);
+    RUN_TEST(test_pulse_matches_golden);
+    RUN_TEST(test_time_selection_matches_golden);
+    RUN_TEST(test_gauge_sweep_matches_golden);
+    RUN_TEST(test_crossfade_matches_golden);
+    RUN_TEST(test_changed_animation_is_caught);
+    return UNITY_END();
+}
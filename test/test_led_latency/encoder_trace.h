@@ -0,0 +1,65 @@
+// Encoder session replayed by the latency gate (input-trace v2 text,
+// as InputTrace::dump() prints it). Built by hand, not captured on a
+// device: CLK = GPIO 0, DT = GPIO 1, SW = GPIO 2, active low.
+//   6 detents clockwise, 80 ms apart
+//   2 detents back, fast (1.5 ms edges)
+//   3 detents clockwise, 40 ms apart
+//   a press with contact bounce, held 150 ms, released with bounce
+// A real trace dumped over serial can replace these lines as-is.
+
+static const char* const ENCODER_TRACE[] = {
+    "# input-trace v2 7",
+    "300000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "68000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "68000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "68000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "68000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "68000 6",
+    "4000 4",
+    "4000 5",
+    "4000 7",
+    "468000 5",
+    "1500 4",
+    "1500 6",
+    "1500 7",
+    "13500 5",
+    "1500 4",
+    "1500 6",
+    "1500 7",
+    "263500 6",
+    "2500 4",
+    "2500 5",
+    "2500 7",
+    "32500 6",
+    "2500 4",
+    "2500 5",
+    "2500 7",
+    "32500 6",
+    "2500 4",
+    "2500 5",
+    "2500 7",
+    "532500 3",
+    "400 7",
+    "400 3",
+    "400 7",
+    "400 3",
+    "148400 7",
+    "600 3",
+    "600 7",
+    "# end"
+};
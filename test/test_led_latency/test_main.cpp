@@ -0,0 +1,209 @@
+#include <unity.h>
+#include <stdio.h>
+#include "core/animations.h"
+#include "core/clock.h"
+#include "core/input_scanner.h"
+#include "core/input_trace.h"
+#include "core/latency.h"
+#include "encoder_trace.h"
+
+// Replay harness: the recorded session goes through the scanner's latch()
+// and update() paths on the virtual clock. Each loop step is a hand-written
+// model of main.cpp's TIME_SELECTION handling (adjust, press to start)
+// before drawing and showing the LED frame; main.cpp, serviceLoop() and the
+// OLED are not run, so the gate covers the scanner and AnimationManager,
+// not changes to main's input handling. OLED marking is tested in
+// test_oled_display.
+
+#define CLK_PIN 0
+#define DT_PIN 1
+#define SW_PIN 2
+#define LOOP_INTERVAL_US 10000UL
+
+// Regression gate for input -> changed LED frame. A detent shows on the
+// next pass; a press starts a crossfade whose first frame is still the
+// old one, so it shows one pass later.
+#define GATE_P99_US (2 * LOOP_INTERVAL_US)
+#define GATE_MAX_US (2 * LOOP_INTERVAL_US)
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static CRGB leds[NUM_LEDS];
+static AnimationManager* manager;
+static InputScanner* scanner;
+static LatencyProbe* probe;
+static int selectedMinutes;
+static int pendingSteps;
+static bool counting;
+static int inputs;
+
+static void markInput(uint32_t inputMicros) {
+    probe->markInput(inputMicros);
+    inputs++;
+}
+
+static void onRotate(const InputEvent& event) {
+    // Whole detents only, no acceleration
+    pendingSteps += event.steps;
+    int detents = pendingSteps / ENCODER_STEPS_PER_DETENT;
+    pendingSteps -= detents * ENCODER_STEPS_PER_DETENT;
+    
+    int previousMinutes = selectedMinutes;
+    selectedMinutes += detents * TIMER_STEP_MINUTES;
+    selectedMinutes = (selectedMinutes < 0) ? 0 : ((selectedMinutes > MAX_TIMER_MINUTES) ? MAX_TIMER_MINUTES : selectedMinutes);
+    if (selectedMinutes != previousMinutes) {
+        markInput(event.timeUs);
+    }
+}
+
+static void onClick(const InputEvent& event) {
+    if (selectedMinutes > 0) {
+        markInput(event.timeUs);
+        counting = true;
+        manager->setAnimation(AnimationType::COUNTDOWN, LED_CROSSFADE_MS);
+    }
+}
+
+static void loopStep() {
+    scanner->update();
+    
+    InputEvent event;
+    while (scanner->poll(event)) {
+        if (counting) {
+            continue;
+        }
+        if (event.type == InputEventType::ROTATE) {
+            onRotate(event);
+        } else if (event.type == InputEventType::CLICK) {
+            onClick(event);
+        }
+    }
+    
+    if (counting) {
+        CountdownParams params;
+        params.progress = 1.0f;
+        params.color = CRGB::Red;
+        params.timestamp = Clock::nowMicros();
+        manager->draw(params);
+    } else {
+        // Breathing cursor: changes every frame with no input at all
+        TimeSelectionParams params;
+        params.progress = (float)selectedMinutes / MAX_TIMER_MINUTES;
+        params.timestamp = Clock::nowMicros();
+        manager->draw(params);
+    }
+    manager->show();
+}
+
+void setUp() {
+    fakeNow = US_PER_SEC;
+    Clock::setSource(fakeClock);
+    manager = new AnimationManager(leds, NUM_LEDS);
+    manager->setAnimation(AnimationType::TIME_SELECTION);
+    scanner = new InputScanner();
+    scanner->addEncoder(CLK_PIN, DT_PIN);
+    scanner->addButton(SW_PIN);
+    probe = new LatencyProbe();
+    manager->setLatencyProbe(probe);
+    selectedMinutes = 0;
+    pendingSteps = 0;
+    counting = false;
+    inputs = 0;
+}
+
+void tearDown() {
+    delete probe;
+    delete scanner;
+    delete manager;
+    Clock::setSource(nullptr);
+}
+
+void test_breathing_cursor_does_not_answer_an_input() {
+    selectedMinutes = 20;
+    loopStep();
+    
+    // An input whose change has not reached the LEDs yet
+    probe->markInput((uint32_t)fakeNow);
+    for (int i = 0; i < 50; i++) {
+        fakeNow += LOOP_INTERVAL_US;
+        loopStep();
+    }
+    LatencyStats stats;
+    TEST_ASSERT_FALSE(probe->getStats(LatencyChannel::LED, stats));
+    
+    // The change lands: that frame, and only it, closes the measurement
+    uint32_t inputTime = (uint32_t)fakeNow - 50 * LOOP_INTERVAL_US;
+    fakeNow += LOOP_INTERVAL_US;
+    selectedMinutes = 25;
+    loopStep();
+    TEST_ASSERT_TRUE(probe->getStats(LatencyChannel::LED, stats));
+    TEST_ASSERT_EQUAL(1, stats.count);
+    TEST_ASSERT_EQUAL_UINT32((uint32_t)fakeNow - inputTime, stats.maxUs);
+}
+
+void test_crossfade_answers_on_its_first_moving_frame() {
+    selectedMinutes = 20;
+    loopStep();
+    
+    fakeNow += LOOP_INTERVAL_US;
+    uint32_t inputTime = (uint32_t)fakeNow;
+    markInput(inputTime);
+    counting = true;
+    manager->setAnimation(AnimationType::COUNTDOWN, LED_CROSSFADE_MS);
+    loopStep();     // Crossfade weight 0: the frame on the wire again
+    LatencyStats stats;
+    TEST_ASSERT_FALSE(probe->getStats(LatencyChannel::LED, stats));
+    
+    fakeNow += LOOP_INTERVAL_US;
+    loopStep();
+    TEST_ASSERT_TRUE(probe->getStats(LatencyChannel::LED, stats));
+    TEST_ASSERT_EQUAL_UINT32(LOOP_INTERVAL_US, stats.maxUs);
+}
+
+void test_trace_parses() {
+    InputTrace trace;
+    int lines = sizeof(ENCODER_TRACE) / sizeof(ENCODER_TRACE[0]);
+    for (int i = 0; i < lines; i++) {
+        trace.parseLine(ENCODER_TRACE[i]);
+    }
+    TEST_ASSERT_EQUAL(lines - 2, trace.getCount());
+    TEST_ASSERT_EQUAL_UINT32(300000, trace.getEvent(0).deltaUs);
+}
+
+void test_replayed_session_meets_the_latency_gate() {
+    static InputTrace trace;
+    for (size_t i = 0; i < sizeof(ENCODER_TRACE) / sizeof(ENCODER_TRACE[0]); i++) {
+        trace.parseLine(ENCODER_TRACE[i]);
+    }
+    trace.replay(*scanner, ReplayStep::bind<loopStep>(), LOOP_INTERVAL_US, US_PER_SEC);
+    
+    // 11 detents and the press all changed the selection or the state
+    TEST_ASSERT_EQUAL(35, selectedMinutes);
+    TEST_ASSERT_TRUE(counting);
+    TEST_ASSERT_EQUAL(12, inputs);
+    
+    LatencyStats stats;
+    TEST_ASSERT_TRUE(probe->getStats(LatencyChannel::LED, stats));
+    TEST_ASSERT_EQUAL(12, stats.count);
+    
+    char message[96];
+    snprintf(message, sizeof(message), "input->LED over %u inputs: p50 %lu us, p99 %lu us, max %lu us",
+             (unsigned)stats.count, (unsigned long)stats.p50Us, (unsigned long)stats.p99Us,
+             (unsigned long)stats.maxUs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(GATE_P99_US, stats.p99Us);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(GATE_MAX_US, stats.maxUs);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_breathing_cursor_does_not_answer_an_input);
+    RUN_TEST(test_crossfade_answers_on_its_first_moving_frame);
+    RUN_TEST(test_trace_parses);
+    RUN_TEST(test_replayed_session_meets_the_latency_gate);
+    return UNITY_END();
+}
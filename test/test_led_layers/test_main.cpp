@@ -0,0 +1,144 @@
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "core/animations.h"
+#include "core/clock.h"
+
+static uint64_t fakeNow = 0;
+static CRGB leds[NUM_LEDS];
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static AnimationParams paramsAt(uint64_t timestamp, CRGB color) {
+    AnimationParams params;
+    params.progress = 0.5f;
+    params.primaryColor = color;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    params.timestamp = timestamp;
+    return params;
+}
+
+static int litRed(const CRGB* frame) {
+    int lit = 0;
+    for (int i = 0; i < NUM_LEDS; i++) {
+        lit += (frame[i].r > 0) ? 1 : 0;
+    }
+    return lit;
+}
+
+// Runs frames at 60 fps, with every layer on the same colour
+static void runFrames(AnimationManager& manager, int frames) {
+    for (int f = 0; f < frames; f++) {
+        fakeNow += 16667;
+        manager.update(paramsAt(fakeNow, CRGB::Black));
+        manager.show();
+    }
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_comet_layer_keeps_its_trail_under_other_layers() {
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::OFF);
+    
+    int comet = manager.addLayer(AnimationType::COMET, BlendMode::ADD);
+    manager.setLayerParams(comet, paramsAt(0, CRGB::Red));
+    int tint = manager.addLayer(AnimationType::SOLID_COLOR, BlendMode::ADD, 64);
+    manager.setLayerParams(tint, paramsAt(0, CRGB::Blue));
+    
+    // With one shared scratch buffer the tint overwrote the trail each frame
+    runFrames(manager, 30);
+    TEST_ASSERT_TRUE(litRed(manager.getFrame()) >= 4);
+}
+
+void test_covering_comet_layer_keeps_its_trail() {
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::SOLID_COLOR);
+    manager.setColors(CRGB::Green);
+    
+    int comet = manager.addLayer(AnimationType::COMET, BlendMode::REPLACE, 255);
+    manager.setLayerParams(comet, paramsAt(0, CRGB::Red));
+    
+    runFrames(manager, 30);
+    const CRGB* frame = manager.getFrame();
+    TEST_ASSERT_TRUE(litRed(frame) >= 4);
+    for (int i = 0; i < NUM_LEDS; i++) {
+        TEST_ASSERT_EQUAL_UINT8(0, frame[i].g);     // Base fully covered
+    }
+}
+
+void test_comet_layers_are_independent() {
+    // Two comets on the same clock render the same trail
+    AnimationManager manager(leds, NUM_LEDS);
+    manager.setAnimation(AnimationType::OFF);
+    int first = manager.addLayer(AnimationType::COMET, BlendMode::MAX);
+    manager.setLayerParams(first, paramsAt(0, CRGB::Red));
+    int second = manager.addLayer(AnimationType::COMET, BlendMode::MAX);
+    manager.setLayerParams(second, paramsAt(0, CRGB::Red));
+    
+    AnimationManager single(leds, NUM_LEDS);
+    single.setAnimation(AnimationType::OFF);
+    single.setLayerParams(single.addLayer(AnimationType::COMET, BlendMode::MAX), paramsAt(0, CRGB::Red));
+    
+    CRGB expected[NUM_LEDS];
+    runFrames(single, 30);
+    memcpy(expected, single.getFrame(), sizeof(expected));
+    
+    fakeNow = 0;
+    runFrames(manager, 30);
+    TEST_ASSERT_EQUAL_MEMORY(expected, manager.getFrame(), sizeof(expected));
+}
+
+void test_benchmark_layer_count() {
+    static const AnimationType types[MAX_ANIMATION_LAYERS] = {
+        AnimationType::PULSE, AnimationType::COMET, AnimationType::SOLID_COLOR,
+        AnimationType::TIME_SELECTION
+    };
+    static const BlendMode blends[MAX_ANIMATION_LAYERS] = {
+        BlendMode::ALPHA, BlendMode::ADD, BlendMode::MAX, BlendMode::REPLACE
+    };
+    const int frames = 200000;
+    char message[96];
+    
+    for (int depth = 0; depth <= MAX_ANIMATION_LAYERS; depth++) {
+        AnimationManager manager(leds, NUM_LEDS);
+        manager.setAnimation(AnimationType::COUNTDOWN);
+        for (int i = 0; i < depth; i++) {
+            int layer = manager.addLayer(types[i], blends[i], 160);
+            manager.setLayerParams(layer, paramsAt(0, CRGB::Orange));
+        }
+        
+        double start = steadySeconds();
+        runFrames(manager, frames);
+        double perFrame = (steadySeconds() - start) / frames;
+        
+        snprintf(message, sizeof(message), "%d layer(s) over COUNTDOWN, %d LEDs: %.0f ns/frame",
+                 depth, NUM_LEDS, perFrame * 1e9);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_comet_layer_keeps_its_trail_under_other_layers);
+    RUN_TEST(test_covering_comet_layer_keeps_its_trail);
+    RUN_TEST(test_comet_layers_are_independent);
+    RUN_TEST(test_benchmark_layer_count);
+    return UNITY_END();
+}
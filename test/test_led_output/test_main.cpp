@@ -0,0 +1,151 @@
+#include <unity.h>
+#include <stdio.h>
+#include "core/animations.h"
+#include "core/clock.h"
+#include "core/led_output.h"
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static const uint64_t FRAME_WIRE_MICROS = NUM_LEDS * WS2812_LED_MICROS + WS2812_RESET_MICROS;
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_async_output_is_busy_until_the_reset_latch_ends() {
+    HostLedOutput output(false);
+    TEST_ASSERT_TRUE(output.init(NUM_LEDS));
+    TEST_ASSERT_FALSE(output.isReady());    // Blank frame on the wire
+    
+    fakeNow += FRAME_WIRE_MICROS;
+    CRGB frame[NUM_LEDS];
+    for (int i = 0; i < NUM_LEDS; i++) {
+        frame[i] = CRGB::White;
+    }
+    TEST_ASSERT_TRUE(output.submit(frame, NUM_LEDS));
+    TEST_ASSERT_EQUAL_UINT64(0, output.getBlockedMicros());
+    
+    // A back-to-back frame must wait for the data and the latch
+    fakeNow += NUM_LEDS * WS2812_LED_MICROS;
+    TEST_ASSERT_FALSE(output.submit(frame, NUM_LEDS));
+    fakeNow += WS2812_RESET_MICROS - 1;
+    TEST_ASSERT_FALSE(output.isReady());
+    fakeNow += 1;
+    TEST_ASSERT_TRUE(output.isReady());
+    TEST_ASSERT_TRUE(output.submit(frame, NUM_LEDS));
+    
+    TEST_ASSERT_EQUAL_UINT32(3, output.getFrameCount());
+    TEST_ASSERT_EQUAL_UINT32(1, output.getRejectedCount());
+}
+
+void test_wire_frame_is_grb_with_brightness() {
+    HostLedOutput output(false);
+    output.setBrightness(128);
+    
+    CRGB frame[2] = { CRGB(200, 100, 50), CRGB(255, 0, 1) };
+    TEST_ASSERT_TRUE(output.submit(frame, 2));
+    
+    const uint8_t* wire = output.getWireFrame();
+    TEST_ASSERT_EQUAL_UINT8(scale8(100, 128), wire[0]);
+    TEST_ASSERT_EQUAL_UINT8(scale8(200, 128), wire[1]);
+    TEST_ASSERT_EQUAL_UINT8(scale8(50, 128), wire[2]);
+    TEST_ASSERT_EQUAL_UINT8(0, wire[3]);
+    TEST_ASSERT_EQUAL_UINT8(scale8(255, 128), wire[4]);
+    TEST_ASSERT_EQUAL_UINT8(scale8(1, 128), wire[5]);
+}
+
+void test_manager_keeps_frames_pending_while_the_wire_is_busy() {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    HostLedOutput output(false);
+    output.init(NUM_LEDS);
+    manager.setOutput(&output);
+    manager.setAnimation(AnimationType::COUNTDOWN);
+    
+    // Loop passes every 100 us: a frame goes out on the first pass after
+    // the wire frees up, so one every 700 us
+    AnimationParams params;
+    params.primaryColor = CRGB::Red;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    for (int pass = 0; pass < 1000; pass++) {
+        fakeNow += 100;
+        params.progress = pass / 1000.0f;
+        params.timestamp = fakeNow;
+        manager.update(params);
+        manager.show();
+    }
+    
+    TEST_ASSERT_EQUAL_UINT32(0, output.getRejectedCount());
+    uint64_t period = (FRAME_WIRE_MICROS + 99) / 100 * 100;
+    TEST_ASSERT_UINT32_WITHIN(1, 1 + 100000 / period, output.getFrameCount());
+}
+
+// Time show() holds the loop per frame with each backend, on the steady clock
+static double blockedPerFrame(bool blocking, int frames) {
+    static CRGB leds[NUM_LEDS];
+    AnimationManager manager(leds, NUM_LEDS);
+    HostLedOutput output(blocking);
+    output.init(NUM_LEDS);
+    manager.setOutput(&output);
+    manager.setAnimation(AnimationType::COMET);
+    
+    AnimationParams params;
+    params.primaryColor = CRGB::Green;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    params.progress = 0.5f;
+    
+    // Start with the blank frame latched
+    while (!output.isReady()) {
+    }
+    
+    uint64_t blocked = 0;
+    for (int f = 0; f < frames; f++) {
+        // One loop pass per millisecond, longer than a frame on the wire
+        uint64_t passStart = Clock::nowMicros();
+        params.timestamp = passStart;
+        manager.update(params);
+        manager.show();
+        blocked += manager.getLastShowMicros();
+        while (Clock::elapsedSince(passStart) < 1000) {
+        }
+    }
+    
+    TEST_ASSERT_EQUAL_UINT32(frames + 1, output.getFrameCount());
+    return (double)blocked / frames;
+}
+
+void test_benchmark_sync_vs_async_blocking() {
+    Clock::setSource(nullptr);
+    const int frames = 200;
+    double sync = blockedPerFrame(true, frames);
+    double async = blockedPerFrame(false, frames);
+    
+    // The blocking backend holds the loop for the whole transfer
+    TEST_ASSERT_TRUE(sync >= NUM_LEDS * WS2812_LED_MICROS + WS2812_RESET_MICROS);
+    TEST_ASSERT_TRUE(async * 10 < sync);
+    
+    char message[96];
+    snprintf(message, sizeof(message), "%d px: show() blocks %.1f us/frame blocking, %.2f us/frame async",
+             NUM_LEDS, sync, async);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_async_output_is_busy_until_the_reset_latch_ends);
+    RUN_TEST(test_wire_frame_is_grb_with_brightness);
+    RUN_TEST(test_manager_keeps_frames_pending_while_the_wire_is_busy);
+    RUN_TEST(test_benchmark_sync_vs_async_blocking);
+    return UNITY_END();
+}
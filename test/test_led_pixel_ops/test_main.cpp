@@ -0,0 +1,168 @@
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "core/pixel_ops.h"
+
+// Spans start at every byte alignment and cover every tail length
+#define MAX_SPAN 40
+static CRGB pixels[MAX_SPAN + 4];
+static CRGB expected[MAX_SPAN + 4];
+static CRGB other[MAX_SPAN + 4];
+static uint32_t seed = 1;
+
+static uint8_t random8() {
+    seed = seed * 1103515245 + 12345;
+    return (uint8_t)(seed >> 16);
+}
+
+static void randomize(CRGB* leds, int count) {
+    for (int i = 0; i < count; i++) {
+        leds[i] = CRGB(random8(), random8(), random8());
+        if (random8() < 32) {
+            leds[i].g = 0;      // Zero channels take the nscale8_video special case
+        }
+    }
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_fill_matches_per_pixel() {
+    for (int offset = 0; offset < 4; offset++) {
+        for (int count = 0; count <= MAX_SPAN; count++) {
+            CRGB color(random8(), random8(), random8());
+            randomize(pixels, MAX_SPAN + 4);
+            memcpy(expected, pixels, sizeof(pixels));
+            for (int i = 0; i < count; i++) {
+                expected[offset + i] = color;
+            }
+            fillPixels(pixels + offset, count, color);
+            TEST_ASSERT_EQUAL_MEMORY(expected, pixels, sizeof(pixels));
+        }
+    }
+}
+
+void test_scale_matches_nscale8() {
+    for (int offset = 0; offset < 4; offset++) {
+        for (int count = 0; count <= MAX_SPAN; count++) {
+            uint8_t scale = (count == 0) ? 0 : (count == 1) ? 255 : random8();
+            randomize(pixels, MAX_SPAN + 4);
+            memcpy(expected, pixels, sizeof(pixels));
+            for (int i = 0; i < count; i++) {
+                expected[offset + i].nscale8(scale);
+            }
+            scalePixels(pixels + offset, count, scale);
+            TEST_ASSERT_EQUAL_MEMORY(expected, pixels, sizeof(pixels));
+        }
+    }
+}
+
+void test_scale_video_matches_nscale8_video() {
+    for (int offset = 0; offset < 4; offset++) {
+        for (int count = 0; count <= MAX_SPAN; count++) {
+            uint8_t scale = (count == 0) ? 0 : (count == 1) ? 255 : random8();
+            randomize(pixels, MAX_SPAN + 4);
+            memcpy(expected, pixels, sizeof(pixels));
+            for (int i = 0; i < count; i++) {
+                expected[offset + i].nscale8_video(scale);
+            }
+            scalePixelsVideo(pixels + offset, count, scale);
+            TEST_ASSERT_EQUAL_MEMORY(expected, pixels, sizeof(pixels));
+        }
+    }
+}
+
+void test_add_and_lerp_match_per_channel() {
+    for (int offset = 0; offset < 4; offset++) {
+        for (int count = 0; count <= MAX_SPAN; count++) {
+            uint16_t weight = (count == 0) ? 0 : (count == 1) ? 256 : random8();
+            randomize(pixels, MAX_SPAN + 4);
+            randomize(other, MAX_SPAN + 4);
+            
+            memcpy(expected, pixels, sizeof(pixels));
+            for (int i = offset; i < offset + count; i++) {
+                for (int c = 0; c < 3; c++) {
+                    expected[i].raw[c] = qadd8(pixels[i].raw[c], (uint8_t)((other[i].raw[c] * weight) >> 8));
+                }
+            }
+            CRGB added[MAX_SPAN + 4];
+            memcpy(added, pixels, sizeof(pixels));
+            addPixelsScaled(added + offset, other + offset, count, weight);
+            TEST_ASSERT_EQUAL_MEMORY(expected, added, sizeof(pixels));
+            
+            for (int i = offset; i < offset + count; i++) {
+                for (int c = 0; c < 3; c++) {
+                    expected[i].raw[c] = (uint8_t)((pixels[i].raw[c] * (256 - weight) +
+                                                    other[i].raw[c] * weight) >> 8);
+                }
+            }
+            lerpPixels(pixels + offset, pixels + offset, other + offset, count, weight);
+            TEST_ASSERT_EQUAL_MEMORY(expected, pixels, sizeof(pixels));
+        }
+    }
+}
+
+// Per-pixel loops the kernels replaced
+static void scalarFill(CRGB* leds, int count, CRGB color) {
+    for (int i = 0; i < count; i++) {
+        leds[i] = color;
+    }
+}
+
+static void scalarScaleVideo(CRGB* leds, int count, uint8_t scale) {
+    for (int i = 0; i < count; i++) {
+        leds[i].nscale8_video(scale);
+    }
+}
+
+void test_benchmark_kernels_against_per_pixel() {
+    static CRGB strip[1024];
+    static const int sizes[] = { 12, 1024 };
+    char message[128];
+    
+    for (unsigned s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++) {
+        int count = sizes[s];
+        int rounds = 24000000 / count;
+        double times[4];
+        
+        double start = steadySeconds();
+        for (int r = 0; r < rounds; r++) {
+            scalarFill(strip, count, CRGB((uint8_t)r, 40, 200));
+            scalarScaleVideo(strip, count, (uint8_t)(r | 1));
+        }
+        times[0] = steadySeconds() - start;
+        uint8_t check = strip[count - 1].r;
+        
+        start = steadySeconds();
+        for (int r = 0; r < rounds; r++) {
+            fillPixels(strip, count, CRGB((uint8_t)r, 40, 200));
+            scalePixelsVideo(strip, count, (uint8_t)(r | 1));
+        }
+        times[1] = steadySeconds() - start;
+        TEST_ASSERT_EQUAL_UINT8(check, strip[count - 1].r);
+        
+        snprintf(message, sizeof(message),
+                 "%4d px fill+scale_video: per-pixel %.1f ns, SWAR %.1f ns (%.2fx)",
+                 count, times[0] * 1e9 / rounds, times[1] * 1e9 / rounds, times[0] / times[1]);
+        TEST_MESSAGE(message);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_fill_matches_per_pixel);
+    RUN_TEST(test_scale_matches_nscale8);
+    RUN_TEST(test_scale_video_matches_nscale8_video);
+    RUN_TEST(test_add_and_lerp_match_per_channel);
+    RUN_TEST(test_benchmark_kernels_against_per_pixel);
+    return UNITY_END();
+}
@@ -0,0 +1,312 @@
+#include <unity.h>
+#include <elf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "core/anim_program.h"
+#include "core/animations.h"
+
+static CRGB leds[NUM_LEDS];
+
+// Native renderer per type, in AnimationType order
+static const AnimationFunction natives[] = {
+    anim_countdown, anim_pulse, anim_comet, anim_solidColor, anim_timeSelection,
+    anim_gaugeSweep, anim_flashComplete, anim_flashCancelled, anim_paused, anim_off
+};
+static const char* const nativeNames[] = {
+    "anim_countdown", "anim_pulse", "anim_comet", "anim_solidColor", "anim_timeSelection",
+    "anim_gaugeSweep", "anim_flashComplete", "anim_flashCancelled", "anim_paused", "anim_off"
+};
+// Kernels the renderers share with the segment paths; counted when the
+// compiler kept them out of line
+static const char* const nativeKernels[] = {
+    "countdownKernel", nullptr, nullptr, nullptr, "timeSelectionKernel",
+    "gaugeSweepKernel", nullptr, nullptr, "countdownKernel", nullptr
+};
+#define BUILTIN_COUNT ((int)AnimationType::OFF + 1)
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+// A timeline frame: 16 ms steps, progress swept 0..1 over 'frames' and
+// the colours a session uses
+static AnimationParams timelineParams(int frame, int frames) {
+    AnimationParams params;
+    params.progress = (float)frame / (float)(frames - 1);
+    params.primaryColor = (frame / 97) % 2 ? CRGB(255, 120, 30) : CRGB(0, 255, 60);
+    params.secondaryColor = CRGB::Blue;
+    params.brightness = 255;
+    params.timestamp = (uint64_t)frame * ANIMATION_INTERVAL * 1000ULL + 123;
+    return params;
+}
+
+// '_Z<n>name...' for a function, '_ZL<n>name...' for a static one
+static bool isMangled(const char* symbol, const char* lengthAndName) {
+    if (strncmp(symbol, "_Z", 2) != 0) {
+        return false;
+    }
+    symbol += (symbol[2] == 'L') ? 3 : 2;
+    return strncmp(symbol, lengthAndName, strlen(lengthAndName)) == 0;
+}
+
+// Size of a function in this test binary's symbol table, 0 if not found
+// (inlined, stripped binary, or not an ELF host)
+static unsigned long nativeSize(const char* name) {
+    if (name == nullptr) {
+        return 0;
+    }
+    char mangled[64];
+    snprintf(mangled, sizeof(mangled), "%u%s", (unsigned)strlen(name), name);
+    
+    FILE* self = fopen("/proc/self/exe", "rb");
+    if (self == nullptr) {
+        return 0;
+    }
+    unsigned long size = 0;
+    Elf64_Ehdr header;
+    if (fread(&header, sizeof(header), 1, self) == 1 && memcmp(header.e_ident, ELFMAG, SELFMAG) == 0 &&
+        header.e_ident[EI_CLASS] == ELFCLASS64) {
+        Elf64_Shdr* sections = (Elf64_Shdr*)calloc(header.e_shnum, sizeof(Elf64_Shdr));
+        fseek(self, (long)header.e_shoff, SEEK_SET);
+        if (fread(sections, sizeof(Elf64_Shdr), header.e_shnum, self) == header.e_shnum) {
+            for (int i = 0; i < header.e_shnum && size == 0; i++) {
+                if (sections[i].sh_type != SHT_SYMTAB || sections[i].sh_link >= header.e_shnum) {
+                    continue;
+                }
+                const Elf64_Shdr& strings = sections[sections[i].sh_link];
+                char* names = (char*)malloc(strings.sh_size);
+                fseek(self, (long)strings.sh_offset, SEEK_SET);
+                if (fread(names, 1, strings.sh_size, self) == strings.sh_size) {
+                    Elf64_Sym symbol;
+                    fseek(self, (long)sections[i].sh_offset, SEEK_SET);
+                    for (uint64_t n = 0; n < sections[i].sh_size / sizeof(symbol); n++) {
+                        if (fread(&symbol, sizeof(symbol), 1, self) != 1) {
+                            break;
+                        }
+                        if (symbol.st_name < strings.sh_size && ELF64_ST_TYPE(symbol.st_info) == STT_FUNC &&
+                            isMangled(names + symbol.st_name, mangled)) {
+                            size = symbol.st_size;
+                            break;
+                        }
+                    }
+                }
+                free(names);
+            }
+        }
+        free(sections);
+    }
+    fclose(self);
+    return size;
+}
+
+static AnimationParams defaultParams() {
+    AnimationParams params;
+    params.progress = 0.5f;
+    params.primaryColor = CRGB::Red;
+    params.secondaryColor = CRGB::Blue;
+    params.brightness = 255;
+    params.timestamp = 0;
+    return params;
+}
+
+static void clearStrip(CRGB* strip) {
+    for (int i = 0; i < NUM_LEDS; i++) {
+        strip[i] = CRGB::Black;
+    }
+}
+
+static void clearLeds() {
+    clearStrip(leds);
+}
+
+void setUp() {
+    clearLeds();
+}
+
+void tearDown() {
+}
+
+void test_builtin_programs_validate() {
+    for (int type = 0; type <= (int)AnimationType::OFF; type++) {
+        uint16_t length = 0;
+        const uint8_t* program = getBuiltinProgram((AnimationType)type, &length);
+        TEST_ASSERT_NOT_NULL(program);
+        TEST_ASSERT_TRUE(validateAnimationProgram(program, length));
+    }
+}
+
+void test_validation_rejects_malformed_programs() {
+    const uint8_t noEnd[] = { ANIM_OP(OP_FILL, 0, 5, 1) };
+    const uint8_t unknownOp[] = { ANIM_OP(OP_COUNT, 0, 0, 0), ANIM_OP(OP_END, 0, 0, 0) };
+    const uint8_t jumpPastEnd[] = { ANIM_OP(OP_JMP, 0, 0, 1), ANIM_OP(OP_END, 0, 0, 0) };
+    const uint8_t jumpBeforeStart[] = { ANIM_OP(OP_JLT, 0, 1, -2), ANIM_OP(OP_END, 0, 0, 0) };
+    const uint8_t ok[] = { ANIM_OP(OP_JLT, 0, 1, 0), ANIM_OP(OP_END, 0, 0, 0) };
+    
+    TEST_ASSERT_FALSE(validateAnimationProgram(nullptr, 4));
+    TEST_ASSERT_FALSE(validateAnimationProgram(ok, 0));
+    TEST_ASSERT_FALSE(validateAnimationProgram(ok, 6));
+    TEST_ASSERT_FALSE(validateAnimationProgram(noEnd, sizeof(noEnd)));
+    TEST_ASSERT_FALSE(validateAnimationProgram(unknownOp, sizeof(unknownOp)));
+    TEST_ASSERT_FALSE(validateAnimationProgram(jumpPastEnd, sizeof(jumpPastEnd)));
+    TEST_ASSERT_FALSE(validateAnimationProgram(jumpBeforeStart, sizeof(jumpBeforeStart)));
+    TEST_ASSERT_TRUE(validateAnimationProgram(ok, sizeof(ok)));
+    
+    static uint8_t tooLong[(ANIM_PROGRAM_MAX_LENGTH + 1) * 4];
+    TEST_ASSERT_FALSE(validateAnimationProgram(tooLong, sizeof(tooLong)));
+}
+
+void test_interpreter_stops_at_the_program_length() {
+    // Only the first instruction is in the program; the red fill after it is not
+    const uint8_t blob[] = {
+        ANIM_OP(OP_FILL, 3, 5, 1),      // White
+        ANIM_OP(OP_FILL, 0, 5, 1),      // Red, past 'length'
+        ANIM_OP(OP_END, 0, 0, 0)
+    };
+    runAnimationProgram(blob, 4, leds, NUM_LEDS, defaultParams());
+    for (int i = 0; i < NUM_LEDS; i++) {
+        TEST_ASSERT_TRUE(leds[i] == CRGB(CRGB::White));
+    }
+}
+
+void test_interpreter_stops_on_a_jump_out_of_the_program() {
+    const uint8_t blob[] = {
+        ANIM_OP(OP_JMP, 0, 0, 1),       // To the red fill, outside 'length'
+        ANIM_OP(OP_END, 0, 0, 0),
+        ANIM_OP(OP_FILL, 0, 5, 1),
+        ANIM_OP(OP_END, 0, 0, 0)
+    };
+    runAnimationProgram(blob, 8, leds, NUM_LEDS, defaultParams());
+    TEST_ASSERT_TRUE(leds[0] == CRGB(CRGB::Black));
+    
+    const uint8_t backwards[] = { ANIM_OP(OP_FILL, 0, 5, 1), ANIM_OP(OP_JMP, 0, 0, -3) };
+    runAnimationProgram(backwards, sizeof(backwards), leds, NUM_LEDS, defaultParams());
+    TEST_ASSERT_TRUE(leds[0] == CRGB(CRGB::Red));
+}
+
+void test_endless_loop_is_cut_at_the_step_budget() {
+    // r2 counts executed increments; the loop never exits on its own
+    const uint8_t loop[] = {
+        ANIM_IMM(OP_LDI, 3, 1),
+        ANIM_OP(OP_ADD, 2, 2, 3),
+        ANIM_OP(OP_PIXEL, 1, 2, 0),     // Secondary colour at r2 while it is on the strip
+        ANIM_OP(OP_JMP, 0, 0, -3),
+        ANIM_OP(OP_END, 0, 0, 0)
+    };
+    TEST_ASSERT_TRUE(validateAnimationProgram(loop, sizeof(loop)));
+    runAnimationProgram(loop, sizeof(loop), leds, NUM_LEDS, defaultParams());
+    
+    TEST_ASSERT_TRUE(leds[0] == CRGB(CRGB::Black));
+    for (int i = 1; i < NUM_LEDS; i++) {
+        TEST_ASSERT_TRUE(leds[i] == CRGB(CRGB::Blue));
+    }
+}
+
+void test_set_program_rejects_invalid_programs() {
+    AnimationManager manager(leds, NUM_LEDS);
+    const uint8_t bad[] = { ANIM_OP(OP_JMP, 0, 0, 7), ANIM_OP(OP_END, 0, 0, 0) };
+    const uint8_t fill[] = { ANIM_OP(OP_FILL, 1, 5, 1), ANIM_OP(OP_END, 0, 0, 0) };
+    
+    TEST_ASSERT_FALSE(manager.setProgram(bad, sizeof(bad)));
+    TEST_ASSERT_TRUE(manager.setProgram(fill, sizeof(fill)));
+    manager.update(defaultParams());
+    manager.show();
+    TEST_ASSERT_TRUE(manager.getFrame()[NUM_LEDS - 1] == CRGB(CRGB::Blue));
+}
+
+void test_builtin_programs_match_the_native_renderers() {
+    // Same timeline through both, each on its own strip (the comet trail
+    // carries over between frames); Q16 against float, within 2/255
+    const int frames = 375;
+    CRGB native[NUM_LEDS];
+    CRGB bytecode[NUM_LEDS];
+    char message[96];
+    
+    for (int type = 0; type < BUILTIN_COUNT; type++) {
+        uint16_t length = 0;
+        const uint8_t* program = getBuiltinProgram((AnimationType)type, &length);
+        clearStrip(native);
+        clearStrip(bytecode);
+        
+        int worst = 0;
+        int worstFrame = 0;
+        for (int frame = 0; frame < frames; frame++) {
+            AnimationParams params = timelineParams(frame, frames);
+            natives[type](native, NUM_LEDS, params);
+            runAnimationProgram(program, length, bytecode, NUM_LEDS, params);
+            for (int i = 0; i < NUM_LEDS; i++) {
+                for (int c = 0; c < 3; c++) {
+                    int diff = abs((int)native[i].raw[c] - (int)bytecode[i].raw[c]);
+                    if (diff > worst) {
+                        worst = diff;
+                        worstFrame = frame;
+                    }
+                }
+            }
+        }
+        snprintf(message, sizeof(message), "%s: max error %d/255 (frame %d)", nativeNames[type], worst,
+                 worstFrame);
+        TEST_MESSAGE(message);
+        TEST_ASSERT_TRUE_MESSAGE(worst <= 2, nativeNames[type]);
+    }
+}
+
+void test_bytecode_against_native_cost_and_size() {
+    const int frames = 375;
+    const int rounds = 40;
+    CRGB strip[NUM_LEDS];
+    char message[128];
+    
+    for (int type = 0; type < BUILTIN_COUNT; type++) {
+        uint16_t length = 0;
+        const uint8_t* program = getBuiltinProgram((AnimationType)type, &length);
+        double times[2];
+        
+        clearStrip(strip);
+        double start = steadySeconds();
+        for (int r = 0; r < rounds; r++) {
+            for (int frame = 0; frame < frames; frame++) {
+                natives[type](strip, NUM_LEDS, timelineParams(frame, frames));
+            }
+        }
+        times[0] = steadySeconds() - start;
+        uint8_t check = strip[0].g;
+        
+        clearStrip(strip);
+        start = steadySeconds();
+        for (int r = 0; r < rounds; r++) {
+            for (int frame = 0; frame < frames; frame++) {
+                runAnimationProgram(program, length, strip, NUM_LEDS, timelineParams(frame, frames));
+            }
+        }
+        times[1] = steadySeconds() - start;
+        TEST_ASSERT_TRUE(abs((int)check - (int)strip[0].g) <= 2);
+        
+        // Native size is the renderer and its kernel; pixel helpers are not counted
+        snprintf(message, sizeof(message),
+                 "%-19s native %6.1f ns/frame %5lu B, bytecode %6.1f ns/frame %4u B (%.2fx)",
+                 nativeNames[type], times[0] * 1e9 / (rounds * frames),
+                 nativeSize(nativeNames[type]) + nativeSize(nativeKernels[type]),
+                 times[1] * 1e9 / (rounds * frames), (unsigned)length, times[1] / times[0]);
+        TEST_MESSAGE(message);
+    }
+    snprintf(message, sizeof(message), "%d px; interpreter (runAnimationProgram) %lu B, shared by all programs",
+             NUM_LEDS, nativeSize("runAnimationProgram"));
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_builtin_programs_validate);
+    RUN_TEST(test_validation_rejects_malformed_programs);
+    RUN_TEST(test_interpreter_stops_at_the_program_length);
+    RUN_TEST(test_interpreter_stops_on_a_jump_out_of_the_program);
+    RUN_TEST(test_endless_loop_is_cut_at_the_step_budget);
+    RUN_TEST(test_set_program_rejects_invalid_programs);
+    RUN_TEST(test_builtin_programs_match_the_native_renderers);
+    RUN_TEST(test_bytecode_against_native_cost_and_size);
+    return UNITY_END();
+}
@@ -0,0 +1,211 @@
+#include <unity.h>
+#include <stdio.h>
+#include "core/clock.h"
+#include "core/display.h"
+#include "core/latency.h"
+
+// OLEDDisplay on the U8g2 stand-in (test/oled_stubs). native_oled builds it
+// in page mode (OLED_PAGE_BUFFER as configured), native_oled_full with the
+// full framebuffer; the checks below hold for both.
+
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static U8G2& panel() {
+    return *U8G2::current();
+}
+
+void setUp() {
+    fakeNow = 0;
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_prepared_countdown_leaves_the_shown_screen() {
+    OLEDDisplay oled;
+    oled.init();
+    oled.showComplete();
+    int frames = panel().frames;
+    
+    oled.prepareCountdown(1500, 1500);
+    TEST_ASSERT_EQUAL(frames, panel().frames);
+    
+    // Redrawing the shown screen still draws it, not the prepared one
+    oled.showComplete();
+    TEST_ASSERT_NOT_NULL(panel().findText("COMPLETE!"));
+    TEST_ASSERT_NULL(panel().findText("25m 0s"));
+    
+    // The prepared frame is swapped in when its time comes
+    int passes = panel().passes;
+    oled.showCountdown(1500, 1500);
+    TEST_ASSERT_EQUAL(frames + 2, panel().frames);
+    TEST_ASSERT_NOT_NULL(panel().findText("25m 0s"));
+    TEST_ASSERT_NOT_NULL(panel().findText("COUNTDOWN"));
+    TEST_ASSERT_EQUAL(OLED_PAGE_BUFFER ? panel().pages : 1, panel().passes - passes);
+}
+
+void test_prepared_countdown_skips_the_render_in_full_buffer_mode() {
+    OLEDDisplay oled;
+    oled.init();
+    oled.showComplete();
+    
+    oled.prepareCountdown(1500, 1500);
+    int passes = panel().passes;
+    oled.showCountdown(1500, 1500);
+    
+    // Full buffer: only the transfer is left. Pages: one replay per page.
+    TEST_ASSERT_EQUAL(OLED_PAGE_BUFFER ? panel().pages : 0, panel().passes - passes);
+    TEST_ASSERT_NOT_NULL(panel().findText("25m 0s"));
+}
+
+void test_screen_shown_before_init_is_flushed_by_init() {
+    OLEDDisplay oled;
+    oled.showComplete();
+    oled.prepareCountdown(1500, 1500);
+    TEST_ASSERT_EQUAL(0, panel().frames);
+    
+    oled.init();
+    TEST_ASSERT_EQUAL(1, panel().frames);
+    TEST_ASSERT_NOT_NULL(panel().findText("COMPLETE!"));
+    TEST_ASSERT_NULL(panel().findText("25m 0s"));
+}
+
+void test_other_countdown_values_are_drawn_fresh() {
+    OLEDDisplay oled;
+    oled.init();
+    oled.prepareCountdown(1500, 1500);
+    oled.showCountdown(1499, 1500);
+    TEST_ASSERT_NOT_NULL(panel().findText("24m 59s"));
+}
+
+void test_title_change_drops_the_prepared_frame() {
+    OLEDDisplay oled;
+    oled.init();
+    oled.prepareCountdown(300, 300);
+    oled.setCountdownTitle("BREAK");
+    oled.showCountdown(300, 300);
+    TEST_ASSERT_NOT_NULL(panel().findText("BREAK"));
+    TEST_ASSERT_NULL(panel().findText("COUNTDOWN"));
+}
+
+void test_unchanged_countdown_is_not_sent_again() {
+    OLEDDisplay oled;
+    oled.init();
+    oled.showCountdown(90, 1500);
+    int frames = panel().frames;
+    oled.showCountdown(90, 1500);
+    TEST_ASSERT_EQUAL(frames, panel().frames);
+    oled.showCountdown(89, 1500);
+    TEST_ASSERT_EQUAL(frames + 1, panel().frames);
+}
+
+void test_every_page_replays_the_whole_screen() {
+    OLEDDisplay oled;
+    oled.init();
+    int passes = panel().passes;
+    int calls = panel().totalCalls;
+    oled.showPaused(600, 1500);
+    
+    // Title, time, frame, mark, instructions on every pass
+    TEST_ASSERT_EQUAL(panel().pages, panel().passes - passes);
+    TEST_ASSERT_EQUAL(5, panel().callCount);
+    TEST_ASSERT_EQUAL(panel().pages * 5, panel().totalCalls - calls);
+}
+
+void test_countdown_ticks_do_not_close_an_input() {
+    Clock::setSource(fakeClock);
+    LatencyProbe probe;
+    LatencyStats stats;
+    OLEDDisplay oled;
+    oled.setLatencyProbe(&probe);
+    oled.init();
+    oled.showCountdown(600, 1500);
+    
+    // An input with no visible effect stays open through per-second redraws
+    fakeNow = 1000;
+    probe.markInput(1000);
+    for (int second = 1; second <= 3; second++) {
+        fakeNow += 1000000;
+        oled.showCountdown(600 - second, 1500);
+    }
+    TEST_ASSERT_FALSE(probe.getStats(LatencyChannel::OLED, stats));
+    
+    // ...until a screen that shows it: the pause
+    fakeNow += 5000;
+    oled.showPaused(597, 1500);
+    TEST_ASSERT_TRUE(probe.getStats(LatencyChannel::OLED, stats));
+    TEST_ASSERT_EQUAL_UINT32(3005000, stats.maxUs);
+    
+    // The selected time is input-driven on its own screen
+    oled.showTimeSelection(1500);
+    fakeNow += 1000;
+    probe.markInput((uint32_t)fakeNow);
+    fakeNow += 2000;
+    oled.showTimeSelection(1560);
+    TEST_ASSERT_TRUE(probe.getStats(LatencyChannel::OLED, stats));
+    TEST_ASSERT_EQUAL(2, stats.count);
+    TEST_ASSERT_EQUAL_UINT32(2000, stats.p50Us);
+}
+
+static void addTiming(const OLEDDisplay& oled, OLEDScreen screen, uint32_t* render, uint32_t* flush) {
+    render[(int)screen] += oled.getTiming(screen).renderMicros;
+    flush[(int)screen] += oled.getTiming(screen).flushMicros;
+}
+
+void test_render_and_flush_time_per_screen() {
+    static const char* const names[] = { "blank", "time selection", "countdown", "paused", "complete", "cancelled" };
+    const int rounds = 200;
+    
+    OLEDDisplay oled;
+    oled.init();
+    uint32_t render[(int)OLEDScreen::COUNT] = { 0 };
+    uint32_t flush[(int)OLEDScreen::COUNT] = { 0 };
+    for (int i = 0; i < rounds; i++) {
+        oled.clear();
+        addTiming(oled, OLEDScreen::BLANK, render, flush);
+        oled.showTimeSelection(1500);
+        addTiming(oled, OLEDScreen::TIME_SELECTION, render, flush);
+        oled.showCountdown(1500 - i, 1500);
+        addTiming(oled, OLEDScreen::COUNTDOWN, render, flush);
+        oled.showPaused(1500 - i, 1500);
+        addTiming(oled, OLEDScreen::PAUSED, render, flush);
+        oled.showComplete();
+        addTiming(oled, OLEDScreen::COMPLETE, render, flush);
+        oled.showCancelled();
+        addTiming(oled, OLEDScreen::CANCELLED, render, flush);
+    }
+    
+    // Host replay into the stand-in only: no glyph rasterising, no I2C
+    char message[128];
+    for (int screen = 0; screen < (int)OLEDScreen::COUNT; screen++) {
+        TEST_ASSERT_EQUAL_UINT32(rounds, oled.getTiming((OLEDScreen)screen).flushes);
+        TEST_ASSERT_TRUE(oled.getTiming((OLEDScreen)screen).renderMicros <=
+                         oled.getTiming((OLEDScreen)screen).flushMicros);
+        snprintf(message, sizeof(message), "OLED_PAGE_BUFFER=%d %s: render %.2f us, flush %.2f us (%d passes)",
+                 OLED_PAGE_BUFFER, names[screen], (double)render[screen] / rounds,
+                 (double)flush[screen] / rounds, panel().pages);
+        TEST_MESSAGE(message);
+    }
+    snprintf(message, sizeof(message), "DrawList %u bytes, OLEDDisplay %u bytes on this host",
+             (unsigned)sizeof(DrawList), (unsigned)sizeof(OLEDDisplay));
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_prepared_countdown_leaves_the_shown_screen);
+    RUN_TEST(test_prepared_countdown_skips_the_render_in_full_buffer_mode);
+    RUN_TEST(test_screen_shown_before_init_is_flushed_by_init);
+    RUN_TEST(test_other_countdown_values_are_drawn_fresh);
+    RUN_TEST(test_title_change_drops_the_prepared_frame);
+    RUN_TEST(test_unchanged_countdown_is_not_sent_again);
+    RUN_TEST(test_every_page_replays_the_whole_screen);
+    RUN_TEST(test_countdown_ticks_do_not_close_an_input);
+    RUN_TEST(test_render_and_flush_time_per_screen);
+    return UNITY_END();
+}
@@ -0,0 +1,133 @@
+#include <unity.h>
+#include <string.h>
+#include "core/draw_list.h"
+
+// Replays go into the U8g2 stand-in (test/oled_stubs): fixed-width fonts,
+// every draw call of the last pass recorded
+static U8G2_SSD1306_128X64_NONAME_F_HW_I2C panel(U8G2_R0);
+static DrawList list;
+
+static void replayFrame(U8G2& display) {
+    display.clearBuffer();
+    list.replay(display);
+    display.sendBuffer();
+}
+
+void setUp() {
+    list.clear();
+}
+
+void tearDown() {
+}
+
+void test_replay_draws_every_call_in_order() {
+    list.setFont(DisplayFont::SMALL);
+    list.drawStr(3, 10, "abc");
+    list.drawFrame(10, 45, 108, 8);
+    list.drawBox(11, 46, 20, 6);
+    replayFrame(panel);
+    
+    TEST_ASSERT_EQUAL(3, panel.callCount);
+    TEST_ASSERT_EQUAL('T', panel.calls[0].op);
+    TEST_ASSERT_EQUAL(3, panel.calls[0].x);
+    TEST_ASSERT_EQUAL(10, panel.calls[0].y);
+    TEST_ASSERT_EQUAL_STRING("abc", panel.calls[0].text);
+    TEST_ASSERT_EQUAL('F', panel.calls[1].op);
+    TEST_ASSERT_EQUAL(108, panel.calls[1].width);
+    TEST_ASSERT_EQUAL('B', panel.calls[2].op);
+    TEST_ASSERT_EQUAL(6, panel.calls[2].height);
+}
+
+void test_centered_text_uses_the_font_at_replay() {
+    list.setFont(DisplayFont::LARGE);
+    list.drawCenteredStr("25m 0s", 40);
+    list.setFont(DisplayFont::SMALL);
+    list.drawCenteredStr("Press to start", 64);
+    replayFrame(panel);
+    
+    // 6 glyphs of 15 px, then 14 glyphs of 6 px
+    TEST_ASSERT_EQUAL((OLED_WIDTH - 6 * 15) / 2, panel.findText("25m 0s")->x);
+    TEST_ASSERT_EQUAL((OLED_WIDTH - 14 * 6) / 2, panel.findText("Press to start")->x);
+    TEST_ASSERT_EQUAL(64, panel.findText("Press to start")->y);
+}
+
+void test_coordinates_are_clamped_to_a_byte() {
+    list.drawBox(-5, 300, 1000, -1);
+    replayFrame(panel);
+    
+    TEST_ASSERT_EQUAL(0, panel.calls[0].x);
+    TEST_ASSERT_EQUAL(255, panel.calls[0].y);
+    TEST_ASSERT_EQUAL(255, panel.calls[0].width);
+    TEST_ASSERT_EQUAL(0, panel.calls[0].height);
+}
+
+void test_text_past_the_buffer_is_cut_short() {
+    // Fill all but 5 bytes, then ask for 9 more characters
+    char filler[DRAW_LIST_TEXT - 5];
+    memset(filler, 'a', sizeof(filler) - 1);
+    filler[sizeof(filler) - 1] = '\0';
+    list.drawStr(0, 10, filler);
+    list.drawStr(0, 20, "123456789");
+    list.drawStr(0, 30, "dropped");
+    replayFrame(panel);
+    
+    // Four characters and the NUL fit; nothing is left for the third string
+    TEST_ASSERT_EQUAL(2, panel.callCount);
+    TEST_ASSERT_EQUAL_STRING("1234", panel.calls[1].text);
+    TEST_ASSERT_NULL(panel.findText("dropped"));
+    
+    // Clearing the list frees the text
+    list.clear();
+    list.drawStr(0, 30, "fits again");
+    replayFrame(panel);
+    TEST_ASSERT_EQUAL_STRING("fits again", panel.calls[0].text);
+}
+
+void test_calls_past_the_op_limit_are_dropped() {
+    for (int i = 0; i < DRAW_LIST_OPS + 3; i++) {
+        list.drawBox(i, 0, 1, 1);
+    }
+    replayFrame(panel);
+    
+    TEST_ASSERT_EQUAL(DRAW_LIST_OPS, panel.callCount);
+    TEST_ASSERT_EQUAL(DRAW_LIST_OPS - 1, panel.calls[DRAW_LIST_OPS - 1].x);
+}
+
+void test_replay_per_page_draws_the_same_screen_each_time() {
+    U8G2_SSD1306_128X64_NONAME_1_HW_I2C pages(U8G2_R0);
+    list.setFont(DisplayFont::BODY);
+    list.drawCenteredStr("PAUSED", 15);
+    list.drawFrame(10, 45, 108, 8);
+    list.drawBox(40, 43, 2, 12);
+    
+    pages.firstPage();
+    do {
+        list.replay(pages);
+    } while (pages.nextPage());
+    
+    // One pass per page, each with the whole list
+    TEST_ASSERT_EQUAL(8, pages.passes);
+    TEST_ASSERT_EQUAL(1, pages.frames);
+    TEST_ASSERT_EQUAL(8 * 3, pages.totalCalls);
+    TEST_ASSERT_EQUAL((OLED_WIDTH - 6 * 8) / 2, pages.findText("PAUSED")->x);
+}
+
+void test_empty_list() {
+    TEST_ASSERT_TRUE(list.isEmpty());
+    list.setFont(DisplayFont::SMALL);
+    TEST_ASSERT_FALSE(list.isEmpty());
+    list.clear();
+    TEST_ASSERT_TRUE(list.isEmpty());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_replay_draws_every_call_in_order);
+    RUN_TEST(test_centered_text_uses_the_font_at_replay);
+    RUN_TEST(test_coordinates_are_clamped_to_a_byte);
+    RUN_TEST(test_text_past_the_buffer_is_cut_short);
+    RUN_TEST(test_calls_past_the_op_limit_are_dropped);
+    RUN_TEST(test_replay_per_page_draws_the_same_screen_each_time);
+    RUN_TEST(test_empty_list);
+    return UNITY_END();
+}
@@ -0,0 +1,115 @@
+#include <unity.h>
+#include <stdio.h>
+#include "core/clock.h"
+#include "core/config.h"
+#include "core/pomodoro.h"
+#include "core/timer.h"
+
+// Virtual clock: an 8-hour day runs in milliseconds
+static uint64_t fakeNow = 0;
+static Timer timer;
+static PomodoroCycle cycle;
+static int completions = 0;
+static uint64_t lateness = 0;
+static uint64_t expectedDeadline = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+// Same chaining as onTimerComplete() in main.cpp
+static void onComplete() {
+    completions++;
+    lateness = fakeNow - expectedDeadline;
+    SessionType next = cycle.advance();
+    timer.chain(PomodoroCycle::getDurationMs(next));
+    expectedDeadline += MS_TO_US(PomodoroCycle::getDurationMs(next));
+}
+
+void setUp() {
+    fakeNow = 0;
+    completions = 0;
+    Clock::setSource(fakeClock);
+    timer = Timer();
+    timer.setOnCompleteCallback(onComplete);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_cycle_order() {
+    cycle.start();
+    const SessionType expected[] = {
+        SessionType::WORK, SessionType::SHORT_BREAK,
+        SessionType::WORK, SessionType::SHORT_BREAK,
+        SessionType::WORK, SessionType::SHORT_BREAK,
+        SessionType::WORK, SessionType::LONG_BREAK,
+        SessionType::WORK, SessionType::SHORT_BREAK
+    };
+    
+    for (unsigned i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        TEST_ASSERT_EQUAL(expected[i], cycle.getCurrentType());
+        cycle.advance();
+    }
+    TEST_ASSERT_EQUAL_UINT16(5, cycle.getCompletedWorkSessions());
+}
+
+void test_restore_continues_round() {
+    // Two work sessions done, second short break running
+    PomodoroCycle restored;
+    restored.restore(SessionType::SHORT_BREAK, 2);
+    TEST_ASSERT_TRUE(restored.isActive());
+    TEST_ASSERT_EQUAL(SessionType::WORK, restored.advance());
+    TEST_ASSERT_EQUAL(SessionType::SHORT_BREAK, restored.advance());
+    TEST_ASSERT_EQUAL(SessionType::WORK, restored.advance());
+    TEST_ASSERT_EQUAL(SessionType::LONG_BREAK, restored.advance());
+}
+
+void test_eight_hour_day_has_no_drift() {
+    cycle.start();
+    timer.start(PomodoroCycle::getDurationMs(SessionType::WORK));
+    expectedDeadline = MS_TO_US(POMODORO_WORK_DURATION);
+    
+    // Loop passes arrive every 1-7 ms, never on a deadline
+    const uint64_t day = 8ULL * 3600 * US_PER_SEC;
+    uint32_t seed = 1;
+    uint64_t worstLateness = 0;
+    while (fakeNow < day) {
+        seed = seed * 1103515245 + 12345;
+        fakeNow += 1000 + (seed >> 16) % 6000 + 13;
+        int before = completions;
+        timer.update();
+        if (completions != before && lateness > worstLateness) {
+            worstLateness = lateness;
+        }
+    }
+    
+    // One round is 4 x 25 + 3 x 5 + 15 = 130 min; the day holds 3 rounds
+    // and 90 min of the fourth (W S W S W S), ending on its last work session
+    const uint32_t round = 4 * POMODORO_WORK_DURATION + 3 * POMODORO_SHORT_BREAK +
+                           POMODORO_LONG_BREAK;
+    TEST_ASSERT_EQUAL_UINT32(130 * 60000UL, round);
+    TEST_ASSERT_EQUAL(3 * 8 + 6, completions);
+    TEST_ASSERT_EQUAL_UINT16(3 * 4 + 3, cycle.getCompletedWorkSessions());
+    TEST_ASSERT_EQUAL(SessionType::WORK, cycle.getCurrentType());
+    TEST_ASSERT_EQUAL(SessionType::LONG_BREAK, cycle.getNextType());
+    
+    // Each session starts at the previous deadline, however late the loop
+    // noticed it: the schedule after 30 sessions is exact to the microsecond
+    TEST_ASSERT_EQUAL_UINT64(expectedDeadline - fakeNow, timer.getRemainingMicros());
+    TEST_ASSERT_TRUE(worstLateness < 7100);
+    
+    char message[80];
+    snprintf(message, sizeof(message), "%d sessions in 8 h, worst completion %lu us late",
+             completions, (unsigned long)worstLateness);
+    TEST_MESSAGE(message);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_cycle_order);
+    RUN_TEST(test_restore_continues_round);
+    RUN_TEST(test_eight_hour_day_has_no_drift);
+    return UNITY_END();
+}
@@ -0,0 +1,271 @@
+#include <unity.h>
+#include "core/clock.h"
+#include "core/sequence.h"
+
+// Virtual clock: tests move time explicitly. Sequence bodies keep their
+// state in globals, since locals do not survive a suspension.
+#define EVENT_A 0x01
+#define EVENT_B 0x02
+
+static uint64_t fakeNow = 0;
+static Sequence seq;
+static int step = 0;
+static int frames = 0;
+static bool gotEvent = false;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static void advanceMs(uint32_t ms) {
+    fakeNow += MS_TO_US(ms);
+}
+
+void setUp() {
+    fakeNow = 1000;
+    step = 0;
+    frames = 0;
+    gotEvent = false;
+    Clock::setSource(fakeClock);
+    seq.stop();
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+static void yieldTwice(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 1;
+    SEQ_YIELD(s);
+    step = 2;
+    SEQ_YIELD(s);
+    step = 3;
+    SEQ_END(s);
+}
+
+void test_yield_resumes_on_the_next_update() {
+    seq.start(yieldTwice);
+    TEST_ASSERT_TRUE(seq.isRunning());
+    TEST_ASSERT_EQUAL(0, step);
+    
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, step);
+    seq.update();
+    TEST_ASSERT_EQUAL(3, step);
+    TEST_ASSERT_FALSE(seq.isRunning());
+    
+    // A finished sequence stays finished
+    seq.update();
+    TEST_ASSERT_EQUAL(3, step);
+}
+
+static void sleepThenDone(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 1;
+    SEQ_SLEEP_MS(s, 100);
+    step = 2;
+    SEQ_END(s);
+}
+
+void test_sleep_waits_on_the_clock() {
+    seq.start(sleepThenDone);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    advanceMs(99);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    // Events do not cut a sleep short
+    seq.post(EVENT_A);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    advanceMs(1);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, step);
+    TEST_ASSERT_FALSE(seq.isRunning());
+}
+
+static void awaitA(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 1;
+    SEQ_AWAIT_EVENT(s, EVENT_A);
+    step = 2;
+    gotEvent = s.consume(EVENT_A);
+    SEQ_YIELD(s);
+    SEQ_END(s);
+}
+
+void test_await_wakes_on_its_event_only() {
+    seq.start(awaitA);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    // Time and other events leave it waiting
+    advanceMs(60000);
+    seq.post(EVENT_B);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    seq.post(EVENT_A);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, step);
+    
+    // The awaited event was consumed on wake; the other is still pending
+    TEST_ASSERT_FALSE(gotEvent);
+    TEST_ASSERT_TRUE(seq.consume(EVENT_B));
+}
+
+void test_event_posted_before_the_await_does_not_suspend() {
+    seq.start(awaitA);
+    seq.post(EVENT_A);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, step);
+    TEST_ASSERT_FALSE(gotEvent);
+}
+
+static void awaitAWithTimeout(Sequence& s) {
+    SEQ_BEGIN(s);
+    while (true) {
+        frames++;
+        SEQ_AWAIT_EVENT_MS(s, EVENT_A, 16);
+        if (s.consume(EVENT_A)) {
+            break;
+        }
+    }
+    gotEvent = true;
+    SEQ_END(s);
+}
+
+void test_await_with_a_timeout_wakes_on_either() {
+    seq.start(awaitAWithTimeout);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, frames);
+    
+    // Not due yet
+    advanceMs(15);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, frames);
+    
+    // Timeout: the event is not there, the loop goes round
+    advanceMs(1);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, frames);
+    TEST_ASSERT_FALSE(gotEvent);
+    
+    // The event wakes it before the timeout and is left for consume()
+    advanceMs(3);
+    seq.post(EVENT_A);
+    seq.update();
+    TEST_ASSERT_EQUAL(2, frames);
+    TEST_ASSERT_TRUE(gotEvent);
+    TEST_ASSERT_FALSE(seq.isRunning());
+}
+
+static void sleepAfterTimedAwait(Sequence& s) {
+    SEQ_BEGIN(s);
+    SEQ_AWAIT_EVENT_MS(s, EVENT_A, 10);
+    step = 1;
+    SEQ_SLEEP_MS(s, 100);
+    step = 2;
+    SEQ_END(s);
+}
+
+void test_timed_out_await_does_not_leave_a_wake_event() {
+    seq.start(sleepAfterTimedAwait);
+    seq.update();
+    advanceMs(10);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    // The timed-out wait is over: EVENT_A must not end the sleep
+    seq.post(EVENT_A);
+    advanceMs(50);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+}
+
+void test_consume_clears_only_the_given_bits() {
+    seq.post(EVENT_A | EVENT_B);
+    TEST_ASSERT_TRUE(seq.consume(EVENT_A));
+    TEST_ASSERT_FALSE(seq.consume(EVENT_A));
+    TEST_ASSERT_TRUE(seq.consume(EVENT_A | EVENT_B));
+    TEST_ASSERT_FALSE(seq.consume(EVENT_B));
+}
+
+void test_start_clears_pending_events_and_the_mark() {
+    seq.post(EVENT_A);
+    advanceMs(500);
+    seq.start(awaitA);
+    TEST_ASSERT_EQUAL_UINT64(0, seq.elapsedMicros());
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    advanceMs(20);
+    TEST_ASSERT_EQUAL_UINT64(MS_TO_US(20), seq.elapsedMicros());
+    seq.mark();
+    TEST_ASSERT_EQUAL_UINT64(0, seq.elapsedMicros());
+}
+
+static void second(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 10;
+    SEQ_YIELD(s);
+    step = 11;
+    SEQ_END(s);
+}
+
+static void restartsItself(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 1;
+    // A state change hands the sequence over from inside the body
+    s.start(second);
+    SEQ_END(s);
+}
+
+void test_restart_from_inside_the_body_survives_seq_end() {
+    seq.start(restartsItself);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    
+    // The run guard kept SEQ_END from stopping the new sequence
+    TEST_ASSERT_TRUE(seq.isRunning());
+    seq.update();
+    TEST_ASSERT_EQUAL(10, step);
+    seq.update();
+    TEST_ASSERT_EQUAL(11, step);
+    TEST_ASSERT_FALSE(seq.isRunning());
+}
+
+static void stopsItself(Sequence& s) {
+    SEQ_BEGIN(s);
+    step = 1;
+    s.stop();
+    SEQ_END(s);
+}
+
+void test_stop_from_inside_the_body() {
+    seq.start(stopsItself);
+    seq.update();
+    TEST_ASSERT_EQUAL(1, step);
+    TEST_ASSERT_FALSE(seq.isRunning());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_yield_resumes_on_the_next_update);
+    RUN_TEST(test_sleep_waits_on_the_clock);
+    RUN_TEST(test_await_wakes_on_its_event_only);
+    RUN_TEST(test_event_posted_before_the_await_does_not_suspend);
+    RUN_TEST(test_await_with_a_timeout_wakes_on_either);
+    RUN_TEST(test_timed_out_await_does_not_leave_a_wake_event);
+    RUN_TEST(test_consume_clears_only_the_given_bits);
+    RUN_TEST(test_start_clears_pending_events_and_the_mark);
+    RUN_TEST(test_restart_from_inside_the_body_survives_seq_end);
+    RUN_TEST(test_stop_from_inside_the_body);
+    return UNITY_END();
+}
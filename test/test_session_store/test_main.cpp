@@ -0,0 +1,320 @@
+#include <unity.h>
+#include <stdio.h>
+#include <string.h>
+#include "core/clock.h"
+#include "core/config.h"
+#include "core/flash.h"
+#include "core/pomodoro.h"
+#include "core/session_store.h"
+#include "core/timer.h"
+
+// RAM-backed session partition (same size as in partitions.csv)
+#define SECTORS 4
+#define SLOTS_PER_SECTOR (FLASH_SECTOR_SIZE / 16)
+static uint8_t flash[SECTORS * FLASH_SECTOR_SIZE];
+static uint64_t fakeNow = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+    memset(flash, 0xFF, sizeof(flash));
+    HostFlash::attach(SESSION_PARTITION_LABEL, flash, sizeof(flash));
+}
+
+void tearDown() {
+    HostFlash::detachAll();
+    Clock::setSource(nullptr);
+}
+
+// Timer paused at a known point one save interval later, so each save is
+// a distinct record rather than a coalesced one
+static void pausedAt(Timer& timer, uint32_t durationMs, uint32_t elapsedMs) {
+    fakeNow += MS_TO_US(SESSION_MIN_SAVE_INTERVAL_MS);
+    timer.restore(durationMs, elapsedMs, TimerState::PAUSED);
+}
+
+static void advanceMs(SessionStore& store, Timer& timer, uint32_t ms) {
+    // Main loop passes every 100 ms
+    for (uint32_t t = 0; t < ms; t += 100) {
+        fakeNow += MS_TO_US(100);
+        timer.update();
+        store.update(timer);
+    }
+}
+
+static SessionSnapshot reboot() {
+    SessionStore rebooted;
+    rebooted.init();
+    SessionSnapshot snapshot;
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    return snapshot;
+}
+
+void test_recovers_latest_after_reboot() {
+    SessionStore store;
+    TEST_ASSERT_TRUE(store.init());
+    SessionSnapshot snapshot;
+    TEST_ASSERT_FALSE(store.loadLatest(snapshot));
+    
+    Timer timer;
+    for (uint32_t i = 1; i <= 10; i++) {
+        pausedAt(timer, 60000, i * 1000);
+        TEST_ASSERT_TRUE(store.save(timer));
+    }
+    
+    SessionStore rebooted;
+    TEST_ASSERT_TRUE(rebooted.init());
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    TEST_ASSERT_EQUAL(TimerState::PAUSED, snapshot.state);
+    TEST_ASSERT_EQUAL_UINT32(60000, snapshot.durationMs);
+    TEST_ASSERT_EQUAL_UINT32(10000, snapshot.elapsedMs);
+}
+
+void test_cycle_position_survives_reboot() {
+    PomodoroCycle cycle;
+    cycle.start();
+    for (int i = 0; i < 5; i++) {
+        cycle.advance();    // Third short break: the next work session earns the long break
+    }
+    
+    SessionStore store;
+    store.setCycle(&cycle);
+    store.init();
+    Timer timer;
+    pausedAt(timer, PomodoroCycle::getDurationMs(cycle.getCurrentType()), 42000);
+    TEST_ASSERT_TRUE(store.save(timer));
+    
+    SessionStore rebooted;
+    rebooted.init();
+    SessionSnapshot snapshot;
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    TEST_ASSERT_TRUE(snapshot.cycleActive);
+    TEST_ASSERT_EQUAL(cycle.getCurrentType(), snapshot.sessionType);
+    TEST_ASSERT_EQUAL_UINT8(cycle.getCompletedWorkSessions(), snapshot.cycleRound);
+    TEST_ASSERT_EQUAL_UINT32(42000, snapshot.elapsedMs);
+    
+    // The restored cycle continues in the same order
+    PomodoroCycle restored;
+    restored.restore(snapshot.sessionType, snapshot.cycleRound);
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL(cycle.advance(), restored.advance());
+    }
+}
+
+void test_plain_countdown_has_no_cycle() {
+    PomodoroCycle cycle;
+    SessionStore store;
+    store.setCycle(&cycle);
+    store.init();
+    Timer timer;
+    pausedAt(timer, 60000, 1000);
+    store.save(timer);
+    
+    SessionStore rebooted;
+    rebooted.init();
+    SessionSnapshot snapshot;
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    TEST_ASSERT_FALSE(snapshot.cycleActive);
+}
+
+void test_torn_write_keeps_previous_record() {
+    // Power lost after every possible number of bytes of one record
+    for (int32_t budget = 0; budget < 16; budget++) {
+        setUp();
+        Timer timer;
+        {
+            SessionStore store;
+            store.init();
+            pausedAt(timer, 60000, 1000);
+            TEST_ASSERT_TRUE(store.save(timer));
+            
+            HostFlash::setWriteBudget(budget);
+            pausedAt(timer, 60000, 2000);
+            TEST_ASSERT_FALSE(store.save(timer));
+            HostFlash::setWriteBudget(-1);
+        }
+        
+        SessionStore rebooted;
+        TEST_ASSERT_TRUE(rebooted.init());
+        SessionSnapshot snapshot;
+        TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+        TEST_ASSERT_EQUAL_UINT32(1000, snapshot.elapsedMs);
+        
+        // Appending resumes after the torn slot
+        pausedAt(timer, 60000, 3000);
+        TEST_ASSERT_TRUE(rebooted.save(timer));
+        
+        SessionStore again;
+        again.init();
+        TEST_ASSERT_TRUE(again.loadLatest(snapshot));
+        TEST_ASSERT_EQUAL_UINT32(3000, snapshot.elapsedMs);
+        tearDown();
+    }
+}
+
+void test_torn_write_without_reboot_is_skipped() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    
+    HostFlash::setWriteBudget(7);
+    pausedAt(timer, 60000, 1000);
+    TEST_ASSERT_FALSE(store.save(timer));
+    HostFlash::setWriteBudget(-1);
+    
+    // The next record goes to a fresh slot, not over the partial one
+    pausedAt(timer, 60000, 2000);
+    TEST_ASSERT_TRUE(store.save(timer));
+    
+    SessionStore rebooted;
+    rebooted.init();
+    SessionSnapshot snapshot;
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(2000, snapshot.elapsedMs);
+}
+
+void test_wraps_and_reclaims_oldest_sector() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    
+    // One and a half passes over the partition
+    uint32_t count = SECTORS * SLOTS_PER_SECTOR * 3 / 2;
+    for (uint32_t i = 1; i <= count; i++) {
+        pausedAt(timer, 3600000, i);
+        TEST_ASSERT_TRUE(store.save(timer));
+    }
+    TEST_ASSERT_EQUAL_UINT32(SECTORS + SECTORS / 2, store.getEraseCount());
+    
+    SessionStore rebooted;
+    rebooted.init();
+    SessionSnapshot snapshot;
+    TEST_ASSERT_TRUE(rebooted.loadLatest(snapshot));
+    TEST_ASSERT_EQUAL_UINT32(count, snapshot.elapsedMs);
+}
+
+void test_one_day_of_checkpoints_wear() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    
+    // A day of back-to-back 25 min sessions, checkpointed every 30 s
+    const uint64_t day = 24ULL * 3600 * US_PER_SEC;
+    const uint64_t step = MS_TO_US(100);
+    timer.start(25 * 60 * 1000UL);
+    store.save(timer);
+    
+    for (fakeNow = step; fakeNow <= day; fakeNow += step) {
+        timer.update();
+        if (timer.isCompleted()) {
+            timer.chain(25 * 60 * 1000UL);
+        }
+        store.update(timer);
+    }
+    
+    uint32_t erases = store.getEraseCount();
+    char message[64];
+    snprintf(message, sizeof(message), "%lu erases/day, %.2f per sector",
+             (unsigned long)erases, erases / (float)SECTORS);
+    TEST_MESSAGE(message);
+    
+    // 2880 records = 11.25 sectors, plus the first sector of a blank partition
+    TEST_ASSERT_EQUAL_UINT32(12, erases);
+    TEST_ASSERT_TRUE(erases <= 3 * SECTORS);
+}
+
+void test_rapid_pause_cycles_wear() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    timer.start(3600000UL);
+    store.save(timer);
+    
+    // An hour of pause/resume every 300 ms, ending paused: each save distinct
+    for (int toggle = 0; toggle < 12001; toggle++) {
+        advanceMs(store, timer, 300);
+        if (timer.isRunning()) {
+            timer.pause();
+        } else {
+            timer.resume();
+        }
+        store.save(timer);
+    }
+    
+    uint32_t erases = store.getEraseCount();
+    char message[80];
+    snprintf(message, sizeof(message), "%lu erases for 12001 pause toggles in an hour",
+             (unsigned long)erases);
+    TEST_MESSAGE(message);
+    
+    // At most one record per interval: 720 records, under 3 sectors (47 uncoalesced)
+    TEST_ASSERT_TRUE(erases <= 3600000UL / SESSION_MIN_SAVE_INTERVAL_MS / SLOTS_PER_SECTOR + 1);
+    
+    // The state the toggling ends in is written once the interval is over
+    TEST_ASSERT_TRUE(timer.isPaused());
+    TEST_ASSERT_TRUE(store.isSavePending());
+    advanceMs(store, timer, SESSION_MIN_SAVE_INTERVAL_MS);
+    TEST_ASSERT_FALSE(store.isSavePending());
+    SessionSnapshot snapshot = reboot();
+    TEST_ASSERT_EQUAL(TimerState::PAUSED, snapshot.state);
+    TEST_ASSERT_EQUAL_UINT32(timer.getElapsed(), snapshot.elapsedMs);
+}
+
+void test_leaving_the_session_is_never_deferred() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    timer.start(60000UL);
+    store.save(timer);
+    
+    // A resume right after a pause is held back...
+    advanceMs(store, timer, 1000);
+    timer.pause();
+    store.save(timer);
+    timer.resume();
+    store.save(timer);
+    TEST_ASSERT_TRUE(store.isSavePending());
+    
+    // ...but a cancel inside the interval goes straight to flash
+    timer.stop();
+    store.save(timer);
+    TEST_ASSERT_FALSE(store.isSavePending());
+    TEST_ASSERT_EQUAL(TimerState::STOPPED, reboot().state);
+}
+
+void test_identical_record_is_not_rewritten() {
+    SessionStore store;
+    store.init();
+    Timer timer;
+    pausedAt(timer, 60000, 1000);
+    store.save(timer);
+    
+    // Saved again long after with nothing changed: no record, nothing pending
+    fakeNow += MS_TO_US(SESSION_PERSIST_INTERVAL_MS);
+    store.save(timer);
+    TEST_ASSERT_FALSE(store.isSavePending());
+    
+    // Every slot but the first is still blank
+    for (uint32_t i = 16; i < FLASH_SECTOR_SIZE; i++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, flash[i]);
+    }
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_recovers_latest_after_reboot);
+    RUN_TEST(test_cycle_position_survives_reboot);
+    RUN_TEST(test_plain_countdown_has_no_cycle);
+    RUN_TEST(test_torn_write_keeps_previous_record);
+    RUN_TEST(test_torn_write_without_reboot_is_skipped);
+    RUN_TEST(test_wraps_and_reclaims_oldest_sector);
+    RUN_TEST(test_one_day_of_checkpoints_wear);
+    RUN_TEST(test_rapid_pause_cycles_wear);
+    RUN_TEST(test_leaving_the_session_is_never_deferred);
+    RUN_TEST(test_identical_record_is_not_rewritten);
+    return UNITY_END();
+}
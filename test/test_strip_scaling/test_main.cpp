@@ -0,0 +1,117 @@
+#include <unity.h>
+#include <stdio.h>
+#include <time.h>
+#include "core/animations.h"
+#include "core/clock.h"
+
+// Built with NUM_LEDS 4096 (env:native_strip); every strip length below
+// runs in the same binary through the clamped numLeds
+
+static uint64_t fakeNow = 0;
+static CRGB leds[NUM_LEDS];
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static double steadySeconds() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec + now.tv_nsec * 1e-9;
+}
+
+static AnimationParams paramsAt(uint64_t timestamp, float progress) {
+    AnimationParams params;
+    params.progress = progress;
+    params.primaryColor = CRGB::Red;
+    params.secondaryColor = CRGB::Black;
+    params.brightness = 255;
+    params.timestamp = timestamp;
+    return params;
+}
+
+// Whole strip animated, or a 12-pixel ring animated with the rest of the
+// strip in one static segment
+static AnimationManager* makeStrip(int length, bool ringOnly) {
+    AnimationManager* manager = new AnimationManager(leds, length);
+    manager->setAnimation(AnimationType::COUNTDOWN);
+    if (ringOnly && length > 12) {
+        manager->setMainSegment(0, 12);
+        int rest = manager->addSegment("rest", 12, (uint16_t)(length - 12), AnimationType::SOLID_COLOR);
+        AnimationParams params = paramsAt(0, 0.0f);
+        params.primaryColor = CRGB::Blue;
+        manager->setSegmentParams(rest, params);
+    }
+    return manager;
+}
+
+static double nanosPerFrame(int length, bool ringOnly) {
+    AnimationManager* manager = makeStrip(length, ringOnly);
+    int frames = ringOnly ? 200000 : 2000 + 4000000 / length;
+    
+    double start = steadySeconds();
+    for (int f = 0; f < frames; f++) {
+        fakeNow += 16000;
+        manager->update(paramsAt(fakeNow, (f & 1023) / 1024.0f));
+        manager->show();
+    }
+    double elapsed = steadySeconds() - start;
+    
+    delete manager;
+    return elapsed / frames * 1e9;
+}
+
+void setUp() {
+    fakeNow = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_static_segment_survives_buffer_swaps_on_a_long_strip() {
+    AnimationManager* manager = makeStrip(NUM_LEDS, true);
+    for (int f = 0; f < 10; f++) {
+        fakeNow += 16000;
+        manager->update(paramsAt(fakeNow, 0.5f));
+        manager->show();
+        
+        // Both frame buffers must hold the static segment once swapped in
+        const CRGB* frame = manager->getFrame();
+        TEST_ASSERT_TRUE(frame[12] == CRGB(CRGB::Blue));
+        TEST_ASSERT_TRUE(frame[NUM_LEDS - 1] == CRGB(CRGB::Blue));
+    }
+    delete manager;
+}
+
+void test_benchmark_strip_length() {
+    const int lengths[] = { 12, 144, 1024, 4096 };
+    double ringOnly4096 = 0;
+    double full4096 = 0;
+    
+    for (int i = 0; i < 4; i++) {
+        double full = nanosPerFrame(lengths[i], false);
+        double ring = nanosPerFrame(lengths[i], true);
+        
+        char message[128];
+        snprintf(message, sizeof(message), "%4d px: whole strip animated %8.0f ns/frame, 12 px ring + static rest %5.0f ns/frame",
+                 lengths[i], full, ring);
+        TEST_MESSAGE(message);
+        
+        if (lengths[i] == 4096) {
+            full4096 = full;
+            ringOnly4096 = ring;
+        }
+    }
+    
+    // Static pixels cost nothing per frame once both buffers hold them
+    TEST_ASSERT_TRUE(ringOnly4096 * 5 < full4096);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_static_segment_survives_buffer_swaps_on_a_long_strip);
+    RUN_TEST(test_benchmark_strip_length);
+    return UNITY_END();
+}
@@ -0,0 +1,189 @@
+#include <unity.h>
+#include "core/clock.h"
+#include "core/timer.h"
+
+// Virtual clock: tests move time explicitly
+static uint64_t fakeNow = 0;
+static int completions = 0;
+
+static uint64_t fakeClock() {
+    return fakeNow;
+}
+
+static void onComplete() {
+    completions++;
+}
+
+// 10 ms before the 64-bit microsecond counter wraps
+static const uint64_t NEAR_WRAP = UINT64_MAX - MS_TO_US(10) + 1;
+
+void setUp() {
+    fakeNow = 0;
+    completions = 0;
+    Clock::setSource(fakeClock);
+}
+
+void tearDown() {
+    Clock::setSource(nullptr);
+}
+
+void test_clock_uses_injected_source() {
+    fakeNow = 123456789;
+    TEST_ASSERT_EQUAL_UINT64(123456789, Clock::nowMicros());
+    TEST_ASSERT_EQUAL_UINT32(123456, Clock::nowMillis());
+    
+    // nullptr restores the steady clock
+    Clock::setSource(nullptr);
+    uint64_t first = Clock::nowMicros();
+    TEST_ASSERT_TRUE(Clock::nowMicros() >= first);
+}
+
+void test_elapsed_is_exact_across_wrap() {
+    fakeNow = NEAR_WRAP;
+    uint64_t start = Clock::nowMicros();
+    
+    fakeNow += MS_TO_US(25);   // 15 ms past the wrap
+    TEST_ASSERT_EQUAL_UINT64(MS_TO_US(25), Clock::elapsedSince(start));
+}
+
+void test_timer_completes_on_the_microsecond_across_wrap() {
+    Timer timer;
+    timer.setOnCompleteCallback(onComplete);
+    fakeNow = NEAR_WRAP;
+    TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.start(1000));
+    
+    fakeNow += MS_TO_US(1000) - 1;
+    timer.update();
+    TEST_ASSERT_TRUE(timer.isRunning());
+    TEST_ASSERT_EQUAL_UINT64(1, timer.getRemainingMicros());
+    
+    fakeNow += 1;
+    timer.update();
+    TEST_ASSERT_TRUE(timer.isCompleted());
+    TEST_ASSERT_EQUAL(1, completions);
+    TEST_ASSERT_EQUAL_UINT64(0, timer.getRemainingMicros());
+}
+
+void test_pause_resume_across_wrap() {
+    Timer timer;
+    timer.setOnCompleteCallback(onComplete);
+    fakeNow = NEAR_WRAP - MS_TO_US(5);
+    timer.start(100);
+    
+    fakeNow += MS_TO_US(30);
+    timer.pause();
+    uint64_t remaining = timer.getRemainingMicros();
+    TEST_ASSERT_EQUAL_UINT64(MS_TO_US(70), remaining);
+    
+    // The pause spans the wrap point; nothing elapses while paused
+    fakeNow += US_PER_SEC;
+    TEST_ASSERT_EQUAL_UINT64(remaining, timer.getRemainingMicros());
+    
+    timer.resume();
+    fakeNow += MS_TO_US(70) - 3;
+    timer.update();
+    TEST_ASSERT_EQUAL_UINT64(3, timer.getRemainingMicros());
+    TEST_ASSERT_EQUAL(0, completions);
+    
+    fakeNow += 3;
+    timer.update();
+    TEST_ASSERT_EQUAL(1, completions);
+}
+
+void test_fractional_remaining_has_sub_millisecond_resolution() {
+    Timer timer;
+    timer.start(1000);
+    
+    // Half a millisecond: a millisecond-based timer would still report 1.0
+    fakeNow += 500;
+    float fraction = timer.getFractionalRemaining();
+    TEST_ASSERT_TRUE(fraction < 1.0f);
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.9995f, fraction);
+}
+
+void test_restore_backdates_the_start_across_wrap() {
+    Timer timer;
+    fakeNow = 1000;     // Uptime shorter than the elapsed time restored
+    TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.restore(60000, 15000));
+    TEST_ASSERT_EQUAL_UINT32(15000, timer.getElapsed());
+    
+    fakeNow += MS_TO_US(45000);
+    timer.update();
+    TEST_ASSERT_TRUE(timer.isCompleted());
+}
+
+void test_chain_starts_at_the_previous_deadline() {
+    Timer timer;
+    timer.start(1000);
+    
+    // The loop notices completion 500 us late
+    fakeNow += MS_TO_US(1000) + 500;
+    timer.update();
+    TEST_ASSERT_TRUE(timer.isCompleted());
+    
+    TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.chain(2000));
+    TEST_ASSERT_EQUAL_UINT64(MS_TO_US(2000) - 500, timer.getRemainingMicros());
+}
+
+void test_repeated_pause_cycles_have_zero_drift() {
+    Timer timer;
+    timer.setOnCompleteCallback(onComplete);
+    TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.start(25 * 60 * 1000UL));
+    
+    // 10000 pause cycles with odd run and pause lengths (not ms multiples)
+    uint64_t running = 0;
+    uint32_t seed = 7;
+    for (int i = 0; i < 10000; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint64_t run = 1 + (seed >> 8) % 97;
+        fakeNow += run;
+        running += run;
+        TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.pause());
+        
+        uint64_t remaining = timer.getRemainingMicros();
+        fakeNow += 1 + (seed >> 4) % 1000003;
+        TEST_ASSERT_EQUAL_UINT64(remaining, timer.getRemainingMicros());
+        TEST_ASSERT_EQUAL(ErrorCode::SUCCESS, timer.resume());
+    }
+    
+    // Only running time counts, to the microsecond
+    TEST_ASSERT_EQUAL_UINT64(MS_TO_US(25 * 60 * 1000UL) - running, timer.getRemainingMicros());
+    
+    fakeNow += timer.getRemainingMicros() - 1;
+    timer.update();
+    TEST_ASSERT_EQUAL(0, completions);
+    fakeNow += 1;
+    timer.update();
+    TEST_ASSERT_EQUAL(1, completions);
+}
+
+void test_paused_timer_reports_remaining_not_duration() {
+    Timer timer;
+    timer.start(1000);
+    fakeNow += MS_TO_US(400);
+    timer.pause();
+    
+    TEST_ASSERT_TRUE(timer.isPaused());
+    TEST_ASSERT_EQUAL_UINT32(600, timer.getRemaining());
+    TEST_ASSERT_FLOAT_WITHIN(1e-6f, 0.6f, timer.getFractionalRemaining());
+    
+    // Pausing twice or resuming a running timer changes nothing
+    TEST_ASSERT_TRUE(timer.pause() != ErrorCode::SUCCESS);
+    timer.resume();
+    TEST_ASSERT_TRUE(timer.resume() != ErrorCode::SUCCESS);
+    TEST_ASSERT_EQUAL_UINT32(600, timer.getRemaining());
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_clock_uses_injected_source);
+    RUN_TEST(test_elapsed_is_exact_across_wrap);
+    RUN_TEST(test_timer_completes_on_the_microsecond_across_wrap);
+    RUN_TEST(test_pause_resume_across_wrap);
+    RUN_TEST(test_fractional_remaining_has_sub_millisecond_resolution);
+    RUN_TEST(test_restore_backdates_the_start_across_wrap);
+    RUN_TEST(test_chain_starts_at_the_previous_deadline);
+    RUN_TEST(test_repeated_pause_cycles_have_zero_drift);
+    RUN_TEST(test_paused_timer_reports_remaining_not_duration);
+    return UNITY_END();
+}
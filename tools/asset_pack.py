@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+"""Build the asset pack flashed to the "assets" partition.
+
+Reads assets/manifest.txt, lays the assets out in AssetId order (parsed
+from src/core/asset_pack.h) and writes the pack described there: header,
+dense index, data. The same file is mapped directly by host builds.
+
+    asset_pack.py                               # assets/manifest.txt -> assets.bin
+    asset_pack.py --revision 7 -o build/assets.bin
+    asset_pack.py --fonts path/to/u8g2_fonts.c
+
+Manifest lines are "<AssetId> <kind> <value>":
+    font  U8g2 font name, copied from the U8g2 sources
+    text  rest of the line, stored NUL-terminated (ASSET_TEXT_MAX bytes at most)
+    file  raw bytes (e.g. animation bytecode), relative to the manifest
+"""
+
+import argparse
+import glob
+import os
+import re
+import struct
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+HEADER = struct.Struct("<IHHIIHH")
+ENTRY = struct.Struct("<II")
+ALIGN = 4
+
+
+def crc16(data):
+    # CRC-16/CCITT-FALSE (matches crc16() in src/core/crc.cpp)
+    crc = 0xFFFF
+    for byte in data:
+        crc ^= byte << 8
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x1021) & 0xFFFF if crc & 0x8000 else (crc << 1) & 0xFFFF
+    return crc
+
+
+def read_header(path):
+    source = open(path).read()
+    source = re.sub(r"//[^\n]*", "", source)
+    magic = int(re.search(r"#define ASSET_PACK_MAGIC (0x[0-9A-Fa-f]+)", source).group(1), 16)
+    version = int(re.search(r"#define ASSET_PACK_VERSION (\d+)", source).group(1))
+    body = re.search(r"enum class AssetId[^{]*\{([^}]*)\}", source).group(1)
+    names = [name.strip() for name in body.split(",") if name.strip()]
+    return magic, version, names[:names.index("COUNT")]
+
+
+def read_text_max(path):
+    # Longest text asset (NUL included) the screens are sized for, from config.h
+    source = re.sub(r"//[^\n]*", "", open(path).read())
+    return int(re.search(r"#define ASSET_TEXT_MAX (\d+)", source).group(1))
+
+
+def read_opcodes(path):
+    # AnimOp values and the length limit from anim_program.h
+    source = re.sub(r"//[^\n]*", "", open(path).read())
+    body = re.search(r"enum AnimOp[^{]*\{([^}]*)\}", source).group(1)
+    names = [name.strip() for name in body.split(",") if name.strip()]
+    max_length = int(re.search(r"#define ANIM_PROGRAM_MAX_LENGTH (\d+)", source).group(1))
+    return dict((name, value) for value, name in enumerate(names)), max_length
+
+
+def check_program(blob, ops, max_length):
+    # Same rules as validateAnimationProgram(); returns an error or None
+    count = len(blob) // 4
+    if not blob or len(blob) % 4 or count > max_length:
+        return "%d bytes is not 1..%d whole instructions" % (len(blob), max_length)
+    if blob[-4] != ops["OP_END"]:
+        return "last instruction is not OP_END"
+    for i in range(count):
+        op = blob[i * 4]
+        if op >= ops["OP_COUNT"]:
+            return "instruction %d: unknown opcode %d" % (i, op)
+        if op in (ops["OP_JLT"], ops["OP_JMP"]):
+            target = i + 1 + struct.unpack("b", blob[i * 4 + 3:i * 4 + 4])[0]
+            if not 0 <= target < count:
+                return "instruction %d: jump to %d, outside the program" % (i, target)
+    return None
+
+
+def partition(label):
+    # Offset and size of a partition in partitions.csv
+    for line in open(os.path.join(ROOT, "partitions.csv")):
+        fields = [field.strip() for field in line.split(",")]
+        if fields and fields[0] == label:
+            return int(fields[3], 0), int(fields[4], 0)
+    sys.exit("partition '%s' not in partitions.csv" % label)
+
+
+def c_string(literals):
+    # Concatenated C string literals -> bytes (octal, hex and simple escapes)
+    out = bytearray()
+    simple = {"n": 10, "t": 9, "r": 13, "a": 7, "b": 8, "f": 12, "v": 11,
+              "\\": 92, '"': 34, "'": 39, "?": 63}
+    for text in literals:
+        i = 0
+        while i < len(text):
+            char = text[i]
+            i += 1
+            if char != "\\":
+                out.append(ord(char))
+                continue
+            char = text[i]
+            if char in "01234567":
+                digits = re.match(r"[0-7]{1,3}", text[i:]).group(0)
+                out.append(int(digits, 8) & 0xFF)
+                i += len(digits)
+            elif char == "x":
+                digits = re.match(r"[0-9A-Fa-f]+", text[i + 1:]).group(0)
+                out.append(int(digits, 16) & 0xFF)
+                i += 1 + len(digits)
+            else:
+                out.append(simple[char])
+                i += 1
+    return bytes(out)
+
+
+def load_font(source, name):
+    literal = r'"(?:[^"\\]|\\.)*"'
+    match = re.search(r"\b%s\s*\[\d*\][^=]*=((?:\s*%s)+)\s*;" % (re.escape(name), literal), source)
+    if match is None:
+        sys.exit("font %s not found in the U8g2 sources" % name)
+    # The font is the string contents; the implicit NUL is not part of it
+    literals = re.findall(r'"((?:[^"\\]|\\.)*)"', match.group(1))
+    return c_string(literals)
+
+
+def find_fonts():
+    pattern = os.path.join(ROOT, ".pio", "libdeps", "*", "U8g2", "src", "clib", "u8g2_fonts.c")
+    matches = glob.glob(pattern)
+    if not matches:
+        sys.exit("u8g2_fonts.c not found (build once with pio run, or pass --fonts)")
+    return matches[0]
+
+
+def read_manifest(path):
+    assets = []
+    for number, line in enumerate(open(path), 1):
+        line = line.rstrip("\n")
+        if not line.strip() or line.lstrip().startswith("#"):
+            continue
+        parts = line.split(None, 2)
+        if len(parts) < 3:
+            sys.exit("%s:%d: expected '<AssetId> <kind> <value>'" % (path, number))
+        assets.append((number, parts[0], parts[1], parts[2].strip()))
+    return assets
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("manifest", nargs="?", default=os.path.join(ROOT, "assets", "manifest.txt"))
+    parser.add_argument("-o", "--output", default="assets.bin")
+    parser.add_argument("--revision", type=int, default=1, help="content revision logged at boot")
+    parser.add_argument("--fonts", help="u8g2_fonts.c (default: the PlatformIO libdeps copy)")
+    parser.add_argument("--label", default="assets", help="partition the pack is flashed to")
+    args = parser.parse_args()
+
+    magic, version, ids = read_header(os.path.join(ROOT, "src", "core", "asset_pack.h"))
+    ops, max_length = read_opcodes(os.path.join(ROOT, "src", "core", "anim_program.h"))
+    text_max = read_text_max(os.path.join(ROOT, "src", "core", "config.h"))
+    base = os.path.dirname(os.path.abspath(args.manifest))
+    fonts = None
+
+    blobs = {}
+    for number, name, kind, value in read_manifest(args.manifest):
+        if name not in ids:
+            sys.exit("%s:%d: unknown AssetId %s" % (args.manifest, number, name))
+        if kind == "font":
+            if fonts is None:
+                fonts = open(args.fonts or find_fonts()).read()
+            blobs[name] = load_font(fonts, value)
+        elif kind == "text":
+            blobs[name] = value.encode("ascii") + b"\0"
+            # The firmware would ignore it and draw the built-in text
+            if len(blobs[name]) > text_max:
+                sys.exit("%s:%d: '%s' is %d characters, screens fit %d (ASSET_TEXT_MAX)"
+                         % (args.manifest, number, value, len(value), text_max - 1))
+        elif kind == "file":
+            blobs[name] = open(os.path.join(base, value), "rb").read()
+            # The firmware drops a bad program at mount; catch it here instead
+            error = check_program(blobs[name], ops, max_length) if name.startswith("PROGRAM_") else None
+            if error:
+                sys.exit("%s:%d: %s: %s" % (args.manifest, number, value, error))
+        else:
+            sys.exit("%s:%d: unknown kind %s" % (args.manifest, number, kind))
+
+    # Dense index over every AssetId; missing assets have length 0
+    data_start = HEADER.size + ENTRY.size * len(ids)
+    index = bytearray()
+    data = bytearray()
+    for name in ids:
+        blob = blobs.get(name, b"")
+        offset = data_start + len(data) if blob else 0
+        index += ENTRY.pack(offset, len(blob))
+        data += blob
+        data += b"\0" * (-len(data) % ALIGN)
+
+    size = data_start + len(data)
+    offset, capacity = partition(args.label)
+    if size > capacity:
+        sys.exit("pack is %d bytes, partition '%s' holds %d" % (size, args.label, capacity))
+
+    header = HEADER.pack(magic, version, len(ids), size, args.revision, crc16(index), crc16(data))
+    with open(args.output, "wb") as out:
+        out.write(header + index + data)
+
+    for name in ids:
+        if name in blobs:
+            print("  %-24s %6d bytes" % (name, len(blobs[name])))
+    print("%s: %d assets, %d of %d bytes, revision %d" % (args.output, len(blobs), size, capacity,
+                                                        args.revision))
+    print("flash with: esptool.py --chip esp32c3 write_flash 0x%X %s" % (offset, args.output))
+
+
+if __name__ == "__main__":
+    main()
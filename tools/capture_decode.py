@@ -0,0 +1,184 @@
+#!/usr/bin/env python3
+"""Decode the LED frame capture stream (FRAME_CAPTURE_ENABLED).
+
+Reads a raw serial capture (file or port), prints the log lines as they
+appear and reconstructs every frame from the keyframe/delta packets
+described in src/core/frame_capture.h.
+
+    capture_decode.py capture.bin                  # log + per-frame summary
+    capture_decode.py capture.bin --ppm frames.ppm # one PPM row per frame
+    capture_decode.py /dev/ttyACM0 --replay        # live ANSI colour strip
+"""
+
+import argparse
+import sys
+import time
+
+SYNC = 0x00
+KEYFRAME = 0x01
+DELTA = 0x02
+KEYFRAME_STAMP = 8  # u64 microseconds
+
+
+def crc8(data):
+    # Polynomial 0x07, init 0 (matches crc8() in src/core/crc.cpp)
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def apply_delta(previous, tokens):
+    frame = bytearray(previous)
+    pos = 0
+    i = 0
+    while i < len(tokens):
+        token = tokens[i]
+        i += 1
+        count = (token & 0x7F) + 1
+        if token & 0x80:
+            pos += count
+            continue
+        for k in range(count):
+            frame[pos + k] ^= tokens[i + k]
+        i += count
+        pos += count
+    if pos != len(frame):
+        raise ValueError("delta does not cover the frame")
+    return bytes(frame)
+
+
+class Decoder:
+    """Splits a byte stream into log lines and frames (timestamp_us, rgb bytes).
+
+    Packets of other kinds (e.g. control replies) go to on_packet(kind, body).
+    """
+
+    def __init__(self, on_line, on_frame, on_packet=None):
+        self.on_line = on_line
+        self.on_frame = on_frame
+        self.on_packet = on_packet
+        self.buffer = bytearray()
+        self.line = bytearray()
+        self.frame = None
+        self.timestamp = 0
+        self.errors = 0
+
+    def feed(self, data):
+        self.buffer += data
+        buffer = self.buffer
+        pos = 0
+        while pos < len(buffer):
+            if buffer[pos] != SYNC:
+                end = buffer.find(b"\x00", pos)
+                end = len(buffer) if end < 0 else end
+                for byte in buffer[pos:end]:
+                    if byte == 0x0A:
+                        self.on_line(self.line.decode("utf-8", "replace").rstrip("\r"))
+                        self.line.clear()
+                    else:
+                        self.line.append(byte)
+                pos = end
+                continue
+
+            if len(buffer) - pos < 4:
+                break
+            length = buffer[pos + 2] | (buffer[pos + 3] << 8)
+            if len(buffer) - pos < 4 + length + 1:
+                break
+            packet = bytes(buffer[pos:pos + 4 + length + 1])
+            if crc8(packet[1:4 + length]) != packet[-1] or not self._packet(packet[1], packet[4:4 + length]):
+                # Not a packet (or corrupted): skip the sync byte and resync
+                self.errors += 1
+                pos += 1
+                continue
+            pos += 4 + length + 1
+        del buffer[:pos]
+
+    def _packet(self, kind, body):
+        if kind not in (KEYFRAME, DELTA):
+            if self.on_packet is None:
+                return False
+            self.on_packet(kind, body)
+            return True
+        if kind == KEYFRAME and len(body) >= KEYFRAME_STAMP:
+            self.timestamp = int.from_bytes(body[:KEYFRAME_STAMP], "little")
+            self.frame = bytes(body[KEYFRAME_STAMP:])
+        elif kind == DELTA and len(body) >= 2 and self.frame is not None:
+            self.timestamp += int.from_bytes(body[:2], "little")
+            try:
+                self.frame = apply_delta(self.frame, body[2:])
+            except (IndexError, ValueError):
+                self.frame = None
+                return False
+        else:
+            return kind == DELTA  # Delta before the first keyframe: wait for one
+        self.on_frame(self.timestamp, self.frame)
+        return True
+
+
+def ansi_strip(frame):
+    cells = []
+    for i in range(0, len(frame), 3):
+        r, g, b = frame[i], frame[i + 1], frame[i + 2]
+        cells.append("\x1b[48;2;%d;%d;%dm  " % (r, g, b))
+    return "".join(cells) + "\x1b[0m"
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("source", help="capture file or serial port")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--ppm", help="write all frames as a PPM strip")
+    parser.add_argument("--replay", action="store_true", help="draw frames in real time")
+    parser.add_argument("--quiet", action="store_true", help="hide log lines")
+    args = parser.parse_args()
+
+    frames = []
+    last = [None]
+
+    def on_line(text):
+        if not args.quiet:
+            print(text)
+
+    def on_frame(timestamp, frame):
+        if args.ppm:
+            frames.append(frame)
+        if args.replay:
+            if last[0] is not None:
+                time.sleep(max(0, timestamp - last[0]) / 1e6)
+            last[0] = timestamp
+            sys.stdout.write("\r" + ansi_strip(frame))
+            sys.stdout.flush()
+        elif not args.ppm:
+            print("%12d us  %s" % (timestamp, frame.hex()))
+
+    decoder = Decoder(on_line, on_frame, lambda kind, body: None)
+
+    if args.source.startswith("/dev/") or args.source.upper().startswith("COM"):
+        import serial  # pyserial, only needed for live capture
+        port = serial.Serial(args.source, args.baud, timeout=0.1)
+        try:
+            while True:
+                decoder.feed(port.read(4096))
+        except KeyboardInterrupt:
+            pass
+    else:
+        with open(args.source, "rb") as stream:
+            decoder.feed(stream.read())
+
+    if args.ppm and frames:
+        width = len(frames[0]) // 3
+        frames = [f for f in frames if len(f) == width * 3]
+        with open(args.ppm, "wb") as out:
+            out.write(b"P6\n%d %d\n255\n" % (width, len(frames)))
+            out.writelines(frames)
+
+    if decoder.errors:
+        sys.stderr.write("%d corrupt or unsynced packets skipped\n" % decoder.errors)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,140 @@
+#!/usr/bin/env python3
+"""Remote control for the Pomodoro timer over its serial port (CONTROL_ENABLED).
+
+Sends the request packets described in src/core/control_link.h and waits
+for the matching reply; log lines received meanwhile are printed as usual.
+
+    control_client.py /dev/ttyACM0 status
+    control_client.py /dev/ttyACM0 start 25
+    control_client.py /dev/ttyACM0 pause | resume | stop | cycle | ping
+    control_client.py /dev/ttyACM0 settime            # host clock -> history days
+    control_client.py /dev/ttyACM0 bench --count 200   # round-trip latency
+"""
+
+import argparse
+import os
+import struct
+import sys
+import time
+
+from capture_decode import Decoder, crc8
+
+REQUEST = 0x10
+REPLY = 0x11
+
+COMMANDS = {"ping": 0, "status": 1, "start": 2, "cycle": 3, "pause": 4, "resume": 5, "stop": 6, "settime": 7}
+STATUS = ["OK", "REJECTED", "BAD_REQUEST", "UNKNOWN_COMMAND", "FAILED"]
+APP_STATES = ["TIME_SELECTION", "GAUGE_SWEEP", "COUNTDOWN_RUNNING", "PAUSED", "TIMER_COMPLETE", "TIMER_CANCELLED"]
+TIMER_STATES = ["STOPPED", "RUNNING", "PAUSED", "COMPLETED"]
+SESSIONS = ["WORK", "SHORT_BREAK", "LONG_BREAK"]
+
+
+def encode_request(sequence, command, args=b""):
+    body = bytes([sequence & 0xFF, command]) + args
+    header = bytes([REQUEST, len(body) & 0xFF, len(body) >> 8])
+    return b"\x00" + header + body + bytes([crc8(header + body)])
+
+
+def describe_status(payload):
+    if len(payload) < 12:
+        return "(no status)"
+    app, timer, session, cycle, duration, remaining = struct.unpack("<BBBBII", payload[:12])
+    text = "%s, timer %s, %s%s, %d/%d s left" % (
+        APP_STATES[app] if app < len(APP_STATES) else app,
+        TIMER_STATES[timer] if timer < len(TIMER_STATES) else timer,
+        SESSIONS[session] if session < len(SESSIONS) else session,
+        " (cycle)" if cycle else "",
+        remaining // 1000, duration // 1000)
+    return text
+
+
+class ControlClient:
+    """Request/reply over a file descriptor shared with the log stream."""
+
+    def __init__(self, fd, on_line=None):
+        self.fd = fd
+        self.sequence = 0
+        self.replies = []
+        self.decoder = Decoder(on_line or (lambda text: None), lambda timestamp, frame: None, self._on_packet)
+
+    def _on_packet(self, kind, body):
+        if kind == REPLY and len(body) >= 3:
+            self.replies.append(body)
+
+    def request(self, command, args=b"", timeout=0.5):
+        """Returns (status, payload) or None on timeout."""
+        self.sequence = (self.sequence + 1) & 0xFF
+        os.write(self.fd, encode_request(self.sequence, command, args))
+        deadline = time.monotonic() + timeout
+        while time.monotonic() < deadline:
+            for body in self.replies:
+                if body[0] == self.sequence and body[1] == command:
+                    self.replies = []
+                    return body[2], bytes(body[3:])
+            try:
+                data = os.read(self.fd, 4096)
+            except BlockingIOError:
+                data = b""
+            if data:
+                self.decoder.feed(data)
+            else:
+                time.sleep(0.0005)
+        return None
+
+
+def open_port(path, baud, raw):
+    if raw:
+        import tty
+        fd = os.open(path, os.O_RDWR | os.O_NOCTTY | os.O_NONBLOCK)
+        tty.setraw(fd)
+        return fd
+    import serial  # pyserial, only needed for a real port
+    port = serial.Serial(path, baud, timeout=0)
+    return port.fileno()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("port", help="serial port (or pty)")
+    parser.add_argument("command", choices=sorted(list(COMMANDS) + ["bench"]))
+    parser.add_argument("minutes", nargs="?", type=int, help="for start")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("--count", type=int, default=100, help="requests for bench")
+    parser.add_argument("--raw", action="store_true", help="open as a plain tty without pyserial (e.g. a pty)")
+    parser.add_argument("--quiet", action="store_true", help="hide log lines")
+    args = parser.parse_args()
+
+    client = ControlClient(open_port(args.port, args.baud, args.raw), None if args.quiet else print)
+
+    if args.command == "bench":
+        times = []
+        for _ in range(args.count):
+            start = time.perf_counter()
+            if client.request(COMMANDS["ping"]) is not None:
+                times.append((time.perf_counter() - start) * 1000.0)
+        if not times:
+            sys.exit("no replies")
+        times.sort()
+        print("%d/%d replies, round trip p50 %.2f ms, p99 %.2f ms, max %.2f ms" % (
+            len(times), args.count, times[len(times) // 2],
+            times[min(len(times) - 1, len(times) * 99 // 100)], times[-1]))
+        return
+
+    request_args = b""
+    if args.command == "start":
+        if args.minutes is None:
+            sys.exit("start needs a duration in minutes")
+        request_args = struct.pack("<H", args.minutes)
+    elif args.command == "settime":
+        request_args = struct.pack("<I", int(time.time()))
+
+    reply = client.request(COMMANDS[args.command], request_args)
+    if reply is None:
+        sys.exit("no reply")
+    status, payload = reply
+    print("%s: %s" % (STATUS[status] if status < len(STATUS) else status, describe_status(payload)))
+    sys.exit(0 if status == 0 else 1)
+
+
+if __name__ == "__main__":
+    main()
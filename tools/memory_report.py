@@ -0,0 +1,501 @@
+#!/usr/bin/env python3
+"""Static RAM/flash budget report (pio run -t memreport).
+
+Breaks the firmware down per output section, per module (object file or
+library archive) and per symbol from the GNU ld map file, lists the
+largest stack frames from -fstack-usage (*.su) and walks the call graph
+disassembled from the ELF for the worst-case stack depth of each task.
+Exits with status 1 when a budget is exceeded.
+
+    memory_report.py firmware.map
+    memory_report.py firmware.map --elf firmware.elf --objdump riscv32-esp-elf-objdump \\
+        --su-dir .pio/build/env --task "loopTask=setup,loop:6144" --ram 32768
+
+Stack depths are lower bounds where the call graph is incomplete: calls
+through a pointer are followed only where --indirect names the targets
+(caller=target target ...), and code without a recognisable prologue
+counts as a zero-size frame. Both are listed under the task.
+
+Callers and targets may be glob patterns, matched against the function
+name without its arguments and with spaces removed. A delegate call
+reaches the thunks instantiated for its signature, so
+
+    --indirect "Timer::update=Delegate<void(),*>::call*"
+
+follows every TimerCallback bound anywhere in the firmware. An
+out-of-line Delegate<...>::operator() gets these edges without a rule.
+"""
+
+import argparse
+import fnmatch
+import os
+import re
+import subprocess
+import sys
+
+# Output sections: RAM only (zero-initialised), loaded into RAM from the
+# image, or executed/read in place from flash
+RAM_ONLY = re.compile(r"^\.(dram0\.bss|dram0\.noinit|noinit|bss|sbss|tbss|rtc\.bss|rtc_noinit|iram0\.bss)\b")
+RAM_LOADED = re.compile(r"^\.(dram0\.data|data|sdata|tdata|rtc\.data|rtc\.text|rtc\.force_\w+|iram0\.\w+)\b")
+FLASH = re.compile(r"^\.(flash\.\w+|text|rodata|init|fini|eh_frame|eh_frame_hdr|gcc_except_table|"
+                   r"init_array|fini_array|preinit_array|ctors|dtors|got|plt)\b")
+NOT_IMAGE = re.compile(r"_noload$|^\.(dram0\.heap_start|iram0\.text_end)$")
+
+# Input section prefixes that -ffunction-sections/-fdata-sections put in front of the symbol
+SYMBOL_SECTION = re.compile(r"^\.(?:text|literal|rodata|srodata|data|sdata|bss|sbss|tbss|tdata|"
+                            r"iram1|dram1|rtc\.text|rtc\.data|rtc\.bss)\.(.+)$")
+
+OUTPUT_SECTION = re.compile(r"^(\.\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+))?")
+INPUT_SECTION = re.compile(r"^ (\S+)(?:\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)(?:\s+(\S.*))?)?$")
+CONTINUATION = re.compile(r"^\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S.*)$")
+
+
+def region(section):
+    """(counts in RAM, counts in flash) for an output section."""
+    if NOT_IMAGE.search(section):
+        return False, False
+    if RAM_ONLY.match(section):
+        return True, False
+    if RAM_LOADED.match(section):
+        return True, True
+    if FLASH.match(section):
+        return False, True
+    return False, False
+
+
+def module_name(path):
+    """Library archive, or the object path from the project's src/ on."""
+    archive = re.match(r"^(.*\.a)\((.*)\)$", path)
+    if archive:
+        return os.path.basename(archive.group(1))
+    path = path.replace("\\", "/")
+    index = path.rfind("/src/")
+    name = path[index + 1:] if index >= 0 else os.path.basename(path)
+    return name[:-2] if name.endswith(".o") else name
+
+
+class Allocation:
+    def __init__(self, section, name, size, module):
+        self.section = section
+        self.name = name
+        self.size = size
+        self.module = module
+
+
+def parse_map(path):
+    """Input sections of every allocated output section in the map."""
+    allocations = []
+    output = None
+    pending = None
+    in_map = False
+
+    with open(path, errors="replace") as stream:
+        for line in stream:
+            line = line.rstrip("\n")
+            if not in_map:
+                in_map = line.startswith("Linker script and memory map")
+                continue
+            if line.startswith("OUTPUT("):
+                break
+
+            if pending is not None:
+                match = CONTINUATION.match(line)
+                pending_name, pending = pending, None
+                if match:
+                    allocations.append(Allocation(output, pending_name, int(match.group(2), 16), match.group(3)))
+                    continue
+
+            match = OUTPUT_SECTION.match(line)
+            if match:
+                output = match.group(1)
+                continue
+            if output is None or not any(region(output)):
+                continue
+
+            match = INPUT_SECTION.match(line)
+            if not match or match.group(1).startswith("*(") or match.group(1) in ("*", "LOAD"):
+                continue
+            name = match.group(1)
+            if match.group(2) is None:
+                pending = name  # Long section name: address, size and file follow
+            elif name == "*fill*":
+                allocations.append(Allocation(output, "*fill*", int(match.group(3), 16), "(padding)"))
+            elif match.group(4):
+                allocations.append(Allocation(output, name, int(match.group(3), 16), match.group(4)))
+
+    for allocation in allocations:
+        allocation.module = module_name(allocation.module)
+    return [a for a in allocations if a.size > 0]
+
+
+def demangler(tool):
+    """Batch demangling through c++filt; names pass through if it is missing."""
+    def demangle(names):
+        if not tool or not names:
+            return list(names)
+        try:
+            result = subprocess.run([tool], input="\n".join(names), capture_output=True, text=True, check=True)
+        except (OSError, subprocess.CalledProcessError):
+            return list(names)
+        lines = result.stdout.split("\n")
+        return lines[:len(names)] if len(lines) >= len(names) else list(names)
+    return demangle
+
+
+def symbol_name(allocation):
+    match = SYMBOL_SECTION.match(allocation.name)
+    if match and not re.match(r"^[\d.]+$", match.group(1)) and not match.group(1).startswith("str1"):
+        return match.group(1)
+    return "(%s %s)" % (allocation.name, allocation.module)
+
+
+def totals(rows, key):
+    result = {}
+    for row in rows:
+        result[key(row)] = result.get(key(row), 0) + row.size
+    return sorted(result.items(), key=lambda item: -item[1])
+
+
+def print_table(title, items, limit):
+    print("\n%s" % title)
+    for name, size in items[:limit]:
+        print("  %8d  %s" % (size, name))
+    if len(items) > limit:
+        print("  %8d  (%d more)" % (sum(size for _, size in items[limit:]), len(items) - limit))
+
+
+# ---- Stack ----
+
+FUNCTION = re.compile(r"^([0-9a-f]+) <(.+)>:$")
+INSTRUCTION = re.compile(r"^\s*([0-9a-f]+):\s+(\S+)\s*(.*)$")
+TARGET = re.compile(r"<(.+)>\s*$")
+FRAME_PATTERNS = [
+    re.compile(r"^(?:c\.)?addi(?:16sp)?\s+sp,\s*(?:sp,\s*)?-(\d+)$"),   # RISC-V
+    re.compile(r"^entry\s+a1,\s*(\d+)$"),                               # Xtensa windowed ABI
+    re.compile(r"^sub\s+\$0x([0-9a-f]+),%rsp$"),                        # x86-64 (host builds)
+]
+DYNAMIC_FRAME = re.compile(r"^(?:sub\s+sp,\s*sp,\s*[a-z]\w*|movsp\b|sub\s+%\w+,%rsp)")
+DIRECT_CALLS = {"jal", "c.jal", "jalr", "c.jalr", "call", "callq", "call0", "call4", "call8", "call12"}
+INDIRECT_CALLS = {"jalr", "c.jalr", "callx0", "callx4", "callx8", "callx12", "call", "callq"}
+TAIL_CALLS = {"j", "c.j", "jmp", "jmpq", "tail"}
+INDIRECT_JUMPS = {"jr", "c.jr", "jx", "jmp", "jmpq"}
+
+
+def base_name(function):
+    """'Foo::bar(int) const' -> 'Foo::bar', 'void Foo::run<&f>()' -> 'Foo::run<&f>'."""
+    depth = 0
+    start = 0
+    for i, char in enumerate(function):
+        if char in "<(" and (char == "<" or i == start or depth > 0):
+            depth += 1
+        elif char in ">)" and depth > 0:
+            depth -= 1
+        elif char == " " and depth == 0 and not function[start:i].endswith("operator"):
+            # Template instances are demangled with their return type first
+            start = i + 1
+        elif char == "(" and depth == 0:
+            if function[start:i].endswith("operator") and function.startswith("()", i):
+                return function[start:i + 2]
+            return function[start:i]
+    return function[start:]
+
+
+def squeeze(name):
+    return "".join(name.split())
+
+
+DELEGATE_CALL = re.compile(r"^(Delegate<.*>)::operator\(\)$")
+
+
+class Function:
+    def __init__(self, name):
+        self.name = name
+        self.frame = 0
+        self.framed = False
+        self.dynamic = False
+        self.calls = set()
+        self.indirect = 0
+        self.indirect_jumps = 0
+
+
+def parse_disassembly(text):
+    """Frame size and callees of every function in 'objdump -d -C' output."""
+    functions = {}
+    current = None
+    prologue = 0
+
+    for line in text.splitlines():
+        match = FUNCTION.match(line)
+        if match:
+            current = functions.setdefault(match.group(2), Function(match.group(2)))
+            prologue = 0
+            continue
+        match = INSTRUCTION.match(line)
+        if current is None or not match:
+            continue
+
+        mnemonic = match.group(2)
+        operands = match.group(3).split("#")[0].strip()
+        instruction = ("%s %s" % (mnemonic, operands)).strip()
+        prologue += 1
+
+        if prologue <= 8:
+            if mnemonic == "push":  # x86-64
+                current.frame += 8
+                current.framed = True
+                continue
+            for pattern in FRAME_PATTERNS:
+                frame = pattern.match(instruction)
+                if frame:
+                    current.frame += int(frame.group(1), 16 if "%rsp" in instruction else 10)
+                    current.framed = True
+                    break
+        elif DYNAMIC_FRAME.match(instruction):
+            current.dynamic = True
+
+        target = TARGET.search(match.group(3))
+        if target:
+            callee = target.group(1)
+            if mnemonic in DIRECT_CALLS or (mnemonic in TAIL_CALLS and callee != current.name):
+                if "+0x" not in callee:
+                    current.calls.add(callee)
+        elif mnemonic in INDIRECT_CALLS and (mnemonic not in ("call", "callq") or "*" in operands):
+            current.indirect += 1
+        elif mnemonic in INDIRECT_JUMPS and operands not in ("ra", "") and "(" not in operands:
+            # Tail call through a pointer, or a switch table: only
+            # followed where --indirect names the caller
+            current.indirect_jumps += 1
+
+    return functions
+
+
+class StackWalk:
+    def __init__(self, functions, indirect):
+        self.functions = functions
+        self.by_base = {}
+        for name in functions:
+            self.by_base.setdefault(base_name(name), []).append(name)
+        self.indirect = {}
+        self.missing = set()
+        for caller, targets in indirect:
+            names = self.resolve(caller)
+            if not names and not self.pattern(caller):
+                self.missing.add(caller)
+            for name in names:
+                self.indirect.setdefault(name, []).extend(n for t in targets for n in self.resolve(t))
+        # A delegate that was not inlined calls the thunks of its own type
+        for base, names in self.by_base.items():
+            match = DELEGATE_CALL.match(base)
+            if match:
+                thunks = self.resolve(match.group(1) + "::call*")
+                for name in names:
+                    self.indirect.setdefault(name, []).extend(thunks)
+        self.memo = {}
+        self.recursive = set()
+        self.unframed = set()
+        self.unknown = set()
+        self.unresolved = set()
+        self.dynamic = set()
+
+    @staticmethod
+    def pattern(root):
+        return "*" in root or "?" in root
+
+    def resolve(self, root):
+        if self.pattern(root):
+            wanted = squeeze(root).replace("[", "[[]")
+            return [n for b, ns in self.by_base.items() if fnmatch.fnmatchcase(squeeze(b), wanted) for n in ns]
+        names = self.by_base.get(root, [])
+        if not names:
+            names = [n for b, ns in self.by_base.items() if b.endswith("::" + root) for n in ns]
+        return names
+
+    def depth(self, name, path):
+        """(bytes, call chain) of the deepest path from name."""
+        if name in self.memo:
+            return self.memo[name]
+        function = self.functions.get(name)
+        if function is None:
+            self.unknown.add(name)
+            return 0, [name]
+        if not function.framed:
+            self.unframed.add(name)
+        if function.dynamic:
+            self.dynamic.add(name)
+
+        path = path | {name}
+        best, chain = 0, []
+        callees = list(function.calls)
+        if name in self.indirect and (function.indirect or function.indirect_jumps):
+            callees += self.indirect[name]
+        elif function.indirect:
+            self.unresolved.add(name)
+        for callee in callees:
+            if callee in path:
+                self.recursive.add(callee)
+                continue
+            size, sub = self.depth(callee, path)
+            if size > best or not chain:
+                best, chain = size, sub
+        result = (function.frame + best, [name] + chain)
+        self.memo[name] = result
+        return result
+
+
+def parse_su(directory):
+    """(frame bytes, qualifier, location, function) from every *.su file."""
+    frames = []
+    for root, _, files in os.walk(directory):
+        for file in files:
+            if not file.endswith(".su"):
+                continue
+            with open(os.path.join(root, file), errors="replace") as stream:
+                for line in stream:
+                    parts = line.rstrip("\n").split("\t")
+                    if len(parts) != 3 or not parts[1].isdigit():
+                        continue
+                    match = re.match(r"^(.*?):(\d+):\d+:(.*)$", parts[0])
+                    if not match:
+                        continue
+                    # GCC prints variadic functions as just ")"
+                    function = match.group(3) if match.group(3) != ")" else "(variadic)"
+                    location = "%s:%s" % (module_name(match.group(1)), match.group(2))
+                    frames.append((int(parts[1]), parts[2], location, function))
+    return sorted(frames, key=lambda frame: -frame[0])
+
+
+def parse_indirect(text):
+    """'caller=target target' -> (caller, [targets])."""
+    caller, _, targets = text.partition("=")
+    if not caller.strip() or not targets.split():
+        raise argparse.ArgumentTypeError("expected caller=target[ target...], got %r" % text)
+    # Targets are separated by spaces only: a pattern may hold commas
+    return squeeze(caller), targets.split()
+
+
+def parse_task(text):
+    """'name=root,root:bytes' -> (name, [roots], budget)."""
+    match = re.match(r"^\s*([\w.-]+)\s*=\s*([\w:,\s]+?)\s*:\s*(\d+)\s*$", text)
+    if not match:
+        raise argparse.ArgumentTypeError("expected name=root[,root...]:bytes, got %r" % text)
+    roots = [r for r in re.split(r"[,\s]+", match.group(2)) if r]
+    return match.group(1), roots, int(match.group(3))
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("map", help="GNU ld map file (-Wl,-Map)")
+    parser.add_argument("--elf", help="firmware ELF, disassembled for the call graph")
+    parser.add_argument("--objdump", default="objdump", help="objdump for the target")
+    parser.add_argument("--cxxfilt", default="c++filt", help="c++filt for symbol names in the map")
+    parser.add_argument("--su-dir", help="build directory with -fstack-usage output")
+    parser.add_argument("--top", type=int, default=15, help="rows per table")
+    parser.add_argument("--ram", type=int, help="static RAM budget (bytes)")
+    parser.add_argument("--flash", type=int, help="image size budget (bytes)")
+    parser.add_argument("--app-ram", type=int, help="static RAM budget of the project's own src/ modules")
+    parser.add_argument("--task", type=parse_task, action="append", default=[],
+                        help="name=root[,root...]:bytes, worst-case stack budget of a task")
+    parser.add_argument("--indirect", type=parse_indirect, action="append", default=[],
+                        help="caller=target[ target...], functions a caller's calls through pointers reach")
+    args = parser.parse_args()
+
+    allocations = parse_map(args.map)
+    if not allocations:
+        sys.stderr.write("%s: no allocated sections found (not a GNU ld map?)\n" % args.map)
+        return 2
+
+    ram = [a for a in allocations if region(a.section)[0]]
+    flash = [a for a in allocations if region(a.section)[1]]
+    names = demangler(args.cxxfilt)([symbol_name(a) for a in allocations])
+    symbols = dict(zip(map(id, allocations), names))
+
+    print("Memory report for %s" % args.map)
+    print("\n%-24s %8s %8s" % ("Section", "RAM", "Flash"))
+    for section in sorted(set(a.section for a in allocations)):
+        in_ram, in_flash = region(section)
+        size = sum(a.size for a in allocations if a.section == section)
+        print("  %-22s %8s %8s" % (section, size if in_ram else "", size if in_flash else ""))
+    ram_total = sum(a.size for a in ram)
+    flash_total = sum(a.size for a in flash)
+    app_ram = sum(a.size for a in ram if a.module.startswith("src/"))
+    print("  %-22s %8d %8d" % ("total", ram_total, flash_total))
+
+    print_table("RAM by module", totals(ram, lambda a: a.module), args.top)
+    print_table("RAM by symbol", totals(ram, lambda a: "%s  [%s]" % (symbols[id(a)], a.module)), args.top)
+    print_table("Flash by module", totals(flash, lambda a: a.module), args.top)
+    print_table("Flash by symbol", totals(flash, lambda a: "%s  [%s]" % (symbols[id(a)], a.module)), args.top)
+
+    if args.su_dir:
+        frames = parse_su(args.su_dir)
+        print("\nLargest stack frames (-fstack-usage)")
+        for size, qualifier, location, function in frames[:args.top]:
+            print("  %8d  %-16s %s  [%s]" % (size, qualifier, function, location))
+        dynamic = [f for f in frames if f[1].startswith("dynamic") and "bounded" not in f[1]]
+        for size, qualifier, location, function in dynamic:
+            print("  warning: unbounded dynamic frame in %s [%s]" % (function, location))
+
+    failures = []
+    if args.task:
+        if not args.elf:
+            sys.stderr.write("--task needs --elf\n")
+            return 2
+        try:
+            text = subprocess.run([args.objdump, "-d", "-C", "--no-show-raw-insn", args.elf],
+                                  capture_output=True, text=True, check=True).stdout
+        except (OSError, subprocess.CalledProcessError) as error:
+            sys.stderr.write("%s: %s\n" % (args.objdump, error))
+            return 2
+        functions = parse_disassembly(text)
+        x86 = "%rsp" in text
+
+        print("\nStack depth per task (worst case)")
+        for name, roots, budget in args.task:
+            walk = StackWalk(functions, args.indirect)
+            best, chain = 0, []
+            for root in roots:
+                resolved = walk.resolve(root)
+                if not resolved:
+                    print("  warning: %s: no function %r in the ELF" % (name, root))
+                for function in resolved:
+                    size, sub = walk.depth(function, set())
+                    if x86:
+                        size += 8 * len(sub)  # Return addresses
+                    if size > best or not chain:
+                        best, chain = size, sub
+            print("  %s (%s): %d bytes" % (name, ", ".join(roots), best))
+            print("    " + " -> ".join("%s %d" % (base_name(f), functions[f].frame if f in functions else 0)
+                                       for f in chain))
+            if walk.missing:
+                print("    --indirect callers not in the ELF (inlined?): %s" % ", ".join(sorted(walk.missing)))
+            if walk.unresolved:
+                print("    unresolved calls through pointers in: %s"
+                      % ", ".join(sorted(base_name(f) for f in walk.unresolved)))
+            if walk.recursive:
+                print("    recursion (counted once): %s" % ", ".join(sorted(base_name(f) for f in walk.recursive)[:8]))
+            if walk.dynamic:
+                print("    dynamic frames (not counted): %s" % ", ".join(sorted(base_name(f) for f in walk.dynamic)[:8]))
+            if walk.unknown or walk.unframed:
+                print("    %d callees without code, %d without a frame prologue" % (len(walk.unknown), len(walk.unframed)))
+            failures += check("stack %s" % name, best, budget)
+
+    print("\nBudgets")
+    if args.ram is not None:
+        failures += check("ram", ram_total, args.ram)
+    if args.app_ram is not None:
+        failures += check("app ram (src/)", app_ram, args.app_ram)
+    if args.flash is not None:
+        failures += check("flash", flash_total, args.flash)
+
+    if failures:
+        sys.stderr.write("Over budget: %s\n" % ", ".join(failures))
+        return 1
+    return 0
+
+
+def check(name, used, budget):
+    print("  %-20s %8d / %-8d %s" % (name, used, budget, "OVER" if used > budget else "ok"))
+    return [name] if used > budget else []
+
+
+if __name__ == "__main__":
+    sys.exit(main())
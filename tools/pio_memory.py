@@ -0,0 +1,56 @@
+"""PlatformIO extra script: memory budget report and check.
+
+    pio run -t memreport
+
+Builds with -fstack-usage and a linker map, then runs memory_report.py
+on the firmware with the custom_budget_* options of platformio.ini. The
+target fails when a budget is exceeded. Other builds are left as they are.
+"""
+
+import os
+import subprocess
+
+Import("env")  # noqa: F821 (provided by PlatformIO)
+
+if "memreport" in COMMAND_LINE_TARGETS:  # noqa: F821
+    env.Append(  # noqa: F821
+        CCFLAGS=["-fstack-usage"],
+        LINKFLAGS=["-Wl,-Map=${BUILD_DIR}/${PROGNAME}.map"],
+    )
+
+
+def option(name):
+    return env.GetProjectOption(name, "").strip()  # noqa: F821
+
+
+def memory_report(target, source, env):
+    # Toolchain paths are only known once the platform has set up the build
+    objcopy = env.subst("$OBJCOPY")
+    args = [
+        env.subst("$PYTHONEXE"),
+        os.path.join(env.subst("$PROJECT_DIR"), "tools", "memory_report.py"),
+        env.subst("${BUILD_DIR}/${PROGNAME}.map"),
+        "--elf", env.subst("${BUILD_DIR}/${PROGNAME}.elf"),
+        "--objdump", objcopy.replace("objcopy", "objdump"),
+        "--cxxfilt", objcopy.replace("objcopy", "c++filt"),
+        "--su-dir", env.subst("$BUILD_DIR"),
+    ]
+    for name in ("ram", "app_ram", "flash"):
+        if option("custom_budget_" + name):
+            args += ["--" + name.replace("_", "-"), option("custom_budget_" + name)]
+    for task in option("custom_budget_stack").splitlines():
+        if task.strip():
+            args += ["--task", task.strip()]
+    for calls in option("custom_stack_indirect").splitlines():
+        if calls.strip():
+            args += ["--indirect", calls.strip()]
+    return subprocess.call(args)
+
+
+env.AddCustomTarget(  # noqa: F821
+    name="memreport",
+    dependencies="${BUILD_DIR}/${PROGNAME}.elf",
+    actions=[memory_report],
+    title="Memory report",
+    description="RAM/flash per module and symbol, stack depth per task; fails over budget",
+)